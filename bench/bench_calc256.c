@@ -0,0 +1,396 @@
+// Microbenchmarks for every Int256 operation over several operand
+// distributions. Reports ns/op and cycles/op (TSC reference cycles on x86).
+//
+//   make bench
+//   build/bench_calc256 [--csv | --json] [--min-ms N] [filter]
+//
+// filter keeps only benchmarks whose "op/distribution" name contains it,
+// e.g. "div" or "/full". CSV and JSON output are meant for tracking numbers
+// across versions.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "calc256.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#define VALUES 1024            // operands per distribution (fits in L1/L2)
+#define TRIALS 3               // best of
+
+typedef enum { DIST_SMALL, DIST_FULL, DIST_MIXED, DIST_NEAR_OVERFLOW, DIST_COUNT } Dist;
+
+static const char* dist_names[DIST_COUNT] = {"small", "full", "mixed", "near_overflow"};
+
+typedef struct {
+    Int256 a[VALUES];
+    Int256 b[VALUES];          // non-zero (divisors)
+    unsigned int shift[VALUES];
+    unsigned int exp[VALUES];  // pow exponent for a[i]
+    unsigned int fact[VALUES]; // factorial argument
+    char dec[VALUES][82];
+    char hex[VALUES][70];
+    size_t dec_len[VALUES];
+    size_t hex_len[VALUES];
+} Operands;
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t now_cycles(void) {
+#ifdef HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Random magnitude of exactly `bits` significant bits (0 gives zero)
+static Int256 random_bits(int bits, int sign) {
+    Int256 r = {{0, 0, 0, 0}, 0};
+    for (int i = 0; i < 4; i++) {
+        int lo = 64 * (3 - i);
+        if (bits <= lo) continue;
+        uint64_t w = next_random();
+        if (bits - lo < 64) {
+            w &= (1ULL << (bits - lo)) - 1;
+            w |= 1ULL << (bits - lo - 1);
+        } else if (bits - lo == 64) {
+            w |= 1ULL << 63;
+        }
+        r.part[i] = w;
+    }
+    r.sign = is_zero_int256(r) ? 0 : sign;
+    return r;
+}
+
+static int bit_length(Int256 a) {
+    for (int i = 0; i < 4; i++) {
+        if (a.part[i]) return 64 * (4 - i) - __builtin_clzll(a.part[i]);
+    }
+    return 0;
+}
+
+static void fill(Operands* ops, Dist dist) {
+    for (int i = 0; i < VALUES; i++) {
+        int bits_a, bits_b, sign_a = 0, sign_b = 0;
+        switch (dist) {
+            case DIST_SMALL:
+                bits_a = 1 + (int)(next_random() % 32);
+                bits_b = 1 + (int)(next_random() % 16);
+                break;
+            case DIST_FULL:
+                bits_a = 256;
+                bits_b = 256;
+                break;
+            case DIST_MIXED:
+                bits_a = 1 + (int)(next_random() % 256);
+                bits_b = 1 + (int)(next_random() % 256);
+                sign_a = (int)(next_random() & 1);
+                sign_b = (int)(next_random() & 1);
+                break;
+            default:
+                // Sums and products that land just under (or just over) 2^256
+                bits_a = 255 + (int)(next_random() & 1);
+                bits_b = 127 + (int)(next_random() % 3);
+                break;
+        }
+        ops->a[i] = random_bits(bits_a, sign_a);
+        ops->b[i] = random_bits(bits_b, sign_b);
+        ops->shift[i] = (unsigned int)(next_random() % 256);
+
+        // Largest exponent whose result still fits in 256 bits
+        int len = bit_length(ops->a[i]);
+        ops->exp[i] = len <= 1 ? 256 : (unsigned int)(256 / len);
+
+        switch (dist) {
+            case DIST_SMALL: ops->fact[i] = (unsigned int)(next_random() % 21); break;
+            case DIST_FULL: ops->fact[i] = 40 + (unsigned int)(next_random() % 18); break;
+            case DIST_MIXED: ops->fact[i] = (unsigned int)(next_random() % 58); break;
+            default: ops->fact[i] = 55 + (unsigned int)(next_random() % 3); break;
+        }
+
+        ops->dec_len[i] = int256_to_decimal(ops->a[i], ops->dec[i], sizeof(ops->dec[i]));
+        int256_to_hex(ops->a[i], ops->hex[i], sizeof(ops->hex[i]));
+        ops->hex_len[i] = strlen(ops->hex[i]);
+    }
+}
+
+// ==================== BENCHMARKS ====================
+//
+// Each runs one pass over the operands and returns a value derived from
+// every result so the compiler cannot drop the work.
+
+typedef uint64_t (*BenchFn)(const Operands* ops);
+
+static uint64_t fold(Int256 r) {
+    return r.part[0] ^ r.part[1] ^ r.part[2] ^ r.part[3] ^ (uint64_t)r.sign;
+}
+
+static uint64_t bench_parse_dec(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        parse_int256(ops->dec[i], ops->dec_len[i], &r, NULL);
+        acc += fold(r);
+    }
+    return acc;
+}
+
+static uint64_t bench_parse_hex(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        parse_int256(ops->hex[i], ops->hex_len[i], &r, NULL);
+        acc += fold(r);
+    }
+    return acc;
+}
+
+static uint64_t bench_format_dec(const Operands* ops) {
+    uint64_t acc = 0;
+    char buffer[82];
+    for (int i = 0; i < VALUES; i++) {
+        acc += int256_to_decimal(ops->a[i], buffer, sizeof(buffer)) + (uint64_t)buffer[1];
+    }
+    return acc;
+}
+
+static uint64_t bench_format_hex(const Operands* ops) {
+    uint64_t acc = 0;
+    char buffer[70];
+    for (int i = 0; i < VALUES; i++) {
+        int256_to_hex(ops->a[i], buffer, sizeof(buffer));
+        acc += (uint64_t)buffer[3];
+    }
+    return acc;
+}
+
+// Writes the operand block as records and reads it back, one call each
+static uint64_t bench_records(const Operands* ops) {
+    static unsigned char block[VALUES * INT256_RECORD_SIZE];
+    static Int256 values[VALUES];
+    int256_to_records(ops->a, VALUES, INT256_RECORD_BE, block);
+    records_to_int256(block, VALUES, INT256_RECORD_BE, values);
+    return fold(values[VALUES - 1]);
+}
+
+// expr is evaluated once per operand index i
+#define LOOP_BENCH(name, expr)                                \
+    static uint64_t bench_##name(const Operands* ops) {       \
+        uint64_t acc = 0;                                     \
+        for (int i = 0; i < VALUES; i++) {                    \
+            acc += fold(expr);                                \
+        }                                                     \
+        return acc;                                           \
+    }
+
+LOOP_BENCH(add, add_int256(ops->a[i], ops->b[i]))
+LOOP_BENCH(sub, sub_int256(ops->a[i], ops->b[i]))
+LOOP_BENCH(mul, mul_int256(ops->a[i], ops->b[i]))
+LOOP_BENCH(div, div_int256(ops->a[i], ops->b[i]))
+LOOP_BENCH(mod, mod_int256(ops->a[i], ops->b[i]))
+LOOP_BENCH(shl, shift_left_int256(ops->a[i], (int)ops->shift[i]))
+LOOP_BENCH(shr, shift_right_int256(ops->a[i], (int)ops->shift[i]))
+LOOP_BENCH(pow, pow_int256(ops->a[i], ops->exp[i]))
+LOOP_BENCH(factorial, factorial_int256(ops->fact[i]))
+LOOP_BENCH(cbrt, icbrt_int256(ops->a[i]))
+LOOP_BENCH(gcd, gcd_int256(ops->a[i], ops->b[i]))
+
+static uint64_t bench_isprime(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) acc += (uint64_t)isprime_int256(abs_int256(ops->a[i]));
+    return acc;
+}
+
+static uint64_t bench_sqrt(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        isqrt_int256(abs_int256(ops->a[i]), &r);
+        acc += fold(r);
+    }
+    return acc;
+}
+
+static uint64_t bench_ilog10(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) acc += (uint64_t)ilog10_int256(ops->a[i]);
+    return acc;
+}
+
+// Inverse of a modulo b, or the status when there is none
+static uint64_t bench_modinv(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        acc += (uint64_t)modinv_int256(ops->a[i], ops->b[i], &r) + fold(r);
+    }
+    return acc;
+}
+
+// C(n, n/2) for n up to 57, and C(n + 100, k) with k up to 28
+static uint64_t bench_binomial(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        unsigned int n = ops->fact[i], k = n / 2;
+        acc += (uint64_t)binomial_int256(n + (i & 1) * 100, k, &r) + fold(r);
+    }
+    return acc;
+}
+
+// a * b / c with a different c each time, so the divisor is prepared per call
+static uint64_t bench_muldiv(const Operands* ops) {
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        acc += (uint64_t)muldiv_int256(ops->a[i], ops->b[i], ops->b[(i + 1) % VALUES],
+                                       INT256_ROUND_HALF_EVEN, &r) + fold(r);
+    }
+    return acc;
+}
+
+// 18-place fixed-point products: one muldiv by the prepared 10^18
+static uint64_t bench_mul_fixed(const Operands* ops) {
+    static Int256Fixed fx;
+    if (fx.one.part[3] == 0) fixed_init_int256(&fx, 18, INT256_ROUND_HALF_EVEN);
+    uint64_t acc = 0;
+    for (int i = 0; i < VALUES; i++) {
+        Int256 r;
+        acc += (uint64_t)mul_fixed_int256(&fx, ops->a[i], ops->b[i], &r) + fold(r);
+    }
+    return acc;
+}
+
+static const struct {
+    const char* name;
+    BenchFn fn;
+} benches[] = {
+    {"parse_dec", bench_parse_dec}, {"parse_hex", bench_parse_hex},
+    {"format_dec", bench_format_dec}, {"format_hex", bench_format_hex},
+    {"records", bench_records},
+    {"add", bench_add}, {"sub", bench_sub}, {"mul", bench_mul},
+    {"div", bench_div}, {"mod", bench_mod}, {"shl", bench_shl},
+    {"shr", bench_shr}, {"pow", bench_pow}, {"factorial", bench_factorial},
+    {"binomial", bench_binomial}, {"sqrt", bench_sqrt}, {"cbrt", bench_cbrt},
+    {"ilog10", bench_ilog10}, {"gcd", bench_gcd}, {"modinv", bench_modinv},
+    {"isprime", bench_isprime}, {"muldiv", bench_muldiv}, {"mul_fixed", bench_mul_fixed},
+};
+
+typedef enum { OUT_TABLE, OUT_CSV, OUT_JSON } OutputFormat;
+
+static volatile uint64_t sink;
+
+// Repeats passes until min_ms has elapsed; best ns/op of TRIALS runs
+static void measure(BenchFn fn, const Operands* ops, double min_ms,
+                    double* ns_per_op, double* cycles_per_op, uint64_t* total_ops) {
+    *ns_per_op = 0;
+    *cycles_per_op = 0;
+    *total_ops = 0;
+    sink += fn(ops);   // warm up caches and branch predictors
+
+    for (int t = 0; t < TRIALS; t++) {
+        uint64_t passes = 0, acc = 0;
+        double t0 = now_ns(), t1;
+        uint64_t c0 = now_cycles();
+        do {
+            acc += fn(ops);
+            passes++;
+            t1 = now_ns();
+        } while (t1 - t0 < min_ms * 1e6);
+        uint64_t c1 = now_cycles();
+        sink += acc;
+
+        double ops_done = (double)passes * VALUES;
+        double ns = (t1 - t0) / ops_done;
+        if (t == 0 || ns < *ns_per_op) {
+            *ns_per_op = ns;
+            *cycles_per_op = (double)(c1 - c0) / ops_done;
+        }
+        *total_ops += passes * VALUES;
+    }
+}
+
+static void print_usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--csv | --json] [--min-ms N] [filter]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    OutputFormat format = OUT_TABLE;
+    double min_ms = 20;
+    const char* filter = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            format = OUT_CSV;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            format = OUT_JSON;
+        } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            min_ms = atof(argv[++i]);
+        } else if (argv[i][0] != '-' && filter == NULL) {
+            filter = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    static Operands ops[DIST_COUNT];
+    for (int d = 0; d < DIST_COUNT; d++) fill(&ops[d], (Dist)d);
+
+    if (format == OUT_TABLE) {
+        printf("%-26s %12s %12s\n", "benchmark", "ns/op", "cycles/op");
+    } else if (format == OUT_CSV) {
+        printf("op,distribution,ns_per_op,cycles_per_op,ops\n");
+    } else {
+        printf("{\n  \"values_per_pass\": %d,\n  \"results\": [", VALUES);
+    }
+
+    int emitted = 0;
+    for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+        for (int d = 0; d < DIST_COUNT; d++) {
+            char name[64];
+            snprintf(name, sizeof(name), "%s/%s", benches[b].name, dist_names[d]);
+            if (filter && strstr(name, filter) == NULL) continue;
+
+            double ns, cycles;
+            uint64_t total;
+            measure(benches[b].fn, &ops[d], min_ms, &ns, &cycles, &total);
+
+            if (format == OUT_TABLE) {
+                printf("%-26s %12.2f %12.1f\n", name, ns, cycles);
+            } else if (format == OUT_CSV) {
+                printf("%s,%s,%.3f,%.2f,%llu\n", benches[b].name, dist_names[d], ns, cycles,
+                       (unsigned long long)total);
+            } else {
+                printf("%s\n    {\"op\": \"%s\", \"distribution\": \"%s\", \"ns_per_op\": %.3f, "
+                       "\"cycles_per_op\": %.2f, \"ops\": %llu}",
+                       emitted ? "," : "", benches[b].name, dist_names[d], ns, cycles,
+                       (unsigned long long)total);
+            }
+            fflush(stdout);
+            emitted++;
+        }
+    }
+
+    if (format == OUT_JSON) printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Decimal formatting benchmark: int256_to_decimal against the previous
+// 10^9-per-round routine.
+//
+//   make bench
+//
+// The legacy routine is kept verbatim for timing only; its output is not
+// checked (it dropped zeros inside 9-digit groups).
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "calc256.h"
+
+#define LEGACY_BASE 1000000000ULL
+#define VALUES 4096
+#define ROUNDS 500
+
+static void legacy_int256_to_decimal(const Int256 n, char* buffer, size_t buffer_size) {
+    if (buffer_size < 2) {
+        buffer[0] = '\0';
+        return;
+    }
+    
+    char* buf_ptr = buffer;
+    
+    if (n.sign && buffer_size > 1) {
+        *buf_ptr++ = '-';
+        buffer_size--;
+    }
+    
+    if (n.part[0] == 0 && n.part[1] == 0 && n.part[2] == 0 && n.part[3] == 0) {
+        *buf_ptr++ = '0';
+        *buf_ptr = '\0';
+        return;
+    }
+    
+    // Use a temporary buffer large enough for 256-bit decimal (up to 78 digits)
+    char temp[100] = {0};
+    int pos = sizeof(temp) - 1;
+    temp[pos] = '\0';
+    
+    uint64_t work[8] = {0};
+    work[4] = n.part[0];
+    work[5] = n.part[1];
+    work[6] = n.part[2];
+    work[7] = n.part[3];
+    
+    while (1) {
+        uint64_t remainder = 0;
+        for (int i = 0; i < 8; i++) {
+            __uint128_t value = ((__uint128_t)remainder << 64) | work[i];
+            work[i] = (uint64_t)(value / LEGACY_BASE);
+            remainder = (uint64_t)(value % LEGACY_BASE);
+        }
+        
+        // Extract 9 decimal digits from remainder
+        char digits[10];
+        for (int j = 8; j >= 0; j--) {
+            digits[j] = '0' + (remainder % 10);
+            remainder /= 10;
+        }
+        
+        // Add digits to temp buffer
+        int start = 0;
+        while (start < 9 && digits[start] == '0') start++;
+        for (int j = start; j < 9; j++) {
+            temp[--pos] = digits[j];
+        }
+        
+        int all_zero = 1;
+        for (int i = 0; i < 8; i++) {
+            if (work[i] != 0) {
+                all_zero = 0;
+                break;
+            }
+        }
+        if (all_zero) break;
+    }
+    
+    // Remove leading zeros
+    while (temp[pos] == '0') pos++;
+    
+    // Copy to output buffer
+    size_t len = sizeof(temp) - pos - 1;
+    if (len >= buffer_size) {
+        buffer[0] = '\0';
+        return;
+    }
+    strcpy(buf_ptr, &temp[pos]);
+}
+
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void fill(Int256* values, int limbs) {
+    for (int i = 0; i < VALUES; i++) {
+        for (int j = 0; j < 4; j++) {
+            values[i].part[j] = (j >= 4 - limbs) ? next_random() : 0;
+        }
+        values[i].sign = (int)(next_random() & 1);
+    }
+}
+
+int main(void) {
+    static Int256 values[VALUES];
+    static const struct { const char* name; int limbs; } sets[] = {
+        {"64-bit", 1}, {"128-bit", 2}, {"192-bit", 3}, {"256-bit", 4},
+    };
+    char buffer[100];
+    size_t sink = 0;
+    
+    printf("%-10s %14s %14s %10s\n", "operands", "legacy ns/op", "new ns/op", "speedup");
+    for (size_t s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+        fill(values, sets[s].limbs);
+        
+        double t0 = now_ns();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < VALUES; i++) {
+                legacy_int256_to_decimal(values[i], buffer, sizeof(buffer));
+                sink += (size_t)buffer[1];
+            }
+        }
+        double t1 = now_ns();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < VALUES; i++) {
+                sink += int256_to_decimal(values[i], buffer, sizeof(buffer));
+            }
+        }
+        double t2 = now_ns();
+        
+        double legacy = (t1 - t0) / ((double)ROUNDS * VALUES);
+        double fast = (t2 - t1) / ((double)ROUNDS * VALUES);
+        printf("%-10s %14.1f %14.1f %9.1fx\n", sets[s].name, legacy, fast, legacy / fast);
+    }
+    
+    return sink == 0;
+}
@@ -1,597 +1,265 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdint.h>
 #include <ctype.h>
-#include <inttypes.h>
-#include <limits.h>
+#include <errno.h>
 
-// ==================== 256-BIT INTEGER (EXACT) ====================
+#include "calc256.h"
+#include "calc256_batch.h"
+#include "calc256_server.h"
+#include "calc256_stats.h"
 
-typedef struct {
-    uint64_t part[4];  // part[0] = most significant
-                       // part[1]
-                       // part[2]
-                       // part[3] = least significant
-    int sign;          // 0 = positive, 1 = negative
-} Int256;
+// ==================== MAIN WITH FIXED INPUT HANDLING ====================
 
-// ==================== CONSTANTS ====================
-#define BASE 1000000000ULL  // For decimal conversion (10^9)
+void print_menu() {
+    printf("\n=== 256-Bit Calculator (Exact) ===\n");
+    printf("1. Add (+)          2. Subtract (-)\n");
+    printf("3. Multiply (×)     4. Divide (÷)\n");
+    printf("5. Modulo (%%)       6. AND (&)\n");
+    printf("7. OR (|)           8. XOR (^)\n");
+    printf("9. Shift Left (<<) 10. Shift Right (>>)\n");
+    printf("11. Power (a^b)    12. Factorial (n!)\n");
+    printf("13. Compare        14. Negate (-x)\n");
+    printf("15. Absolute       16. PowMod (a^e mod m)\n");
+    printf("17. Expression     18. Root (n-th)\n");
+    printf("19. Log2 / Log10   20. GCD / LCM / Inverse\n");
+    printf("21. Prime / Factor 22. MulDiv (a*b/c)\n");
+    printf("0. Exit\n");
+    printf("Choice: ");
+}
 
-// ==================== UTILITY FUNCTIONS ====================
+// --round names, in Int256Rounding order
+static const char* rounding_names[] = {"trunc", "floor", "ceil", "away", "half-up", "half-even"};
+
+void print_usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--stats] [--cache N] [--batch [--file PATH] [--hex] [--expr EXPR] [--threads N]]\n", prog);
+    fprintf(stderr, "       %s --batch [--scale N] [--round MODE] ...\n", prog);
+    fprintf(stderr, "       %s --listen ADDR [--hex] [--expr EXPR] [--threads N] [--cache N]\n", prog);
+    fprintf(stderr, "       %s --encode | --decode [--hex] | --records OP [--expr EXPR] [--be] [--file PATH]\n", prog);
+    fprintf(stderr, "  (no options)  interactive menu\n");
+    fprintf(stderr, "  --batch       read one operation per line from stdin, e.g. \"mul 0x1f 123\"\n");
+    fprintf(stderr, "                ops: add sub mul div mod and or xor shl shr pow fact cmp neg abs\n");
+    fprintf(stderr, "                     mulmod powmod (a b m), binom falling (n k)\n");
+    fprintf(stderr, "                     sqrt cbrt log2 log10, root (a n), gcd lcm modinv (a b)\n");
+    fprintf(stderr, "                     isprime factor, muldiv (a*b/c from the 512-bit product)\n");
+    fprintf(stderr, "  --file PATH   read batch input from PATH (memory-mapped) instead of stdin\n");
+    fprintf(stderr, "  --hex         print batch results in hex instead of decimal\n");
+    fprintf(stderr, "  --expr EXPR   compile EXPR once, e.g. \"(a*b + c) %% m\"; each batch line then\n");
+    fprintf(stderr, "                holds values for its variables in order of first appearance\n");
+    fprintf(stderr, "  --threads N   evaluate batch input on N threads (0 = one per CPU); output\n");
+    fprintf(stderr, "                order is unchanged\n");
+    fprintf(stderr, "  --scale N     numbers are fixed-point decimals with N places (at most 77),\n");
+    fprintf(stderr, "                e.g. \"mul 1.25 0.1\"; ops add sub mul div mod cmp neg abs muldiv\n");
+    fprintf(stderr, "  --round MODE  rounding of muldiv and --scale results: trunc (default), floor,\n");
+    fprintf(stderr, "                ceil, away, half-up or half-even\n");
+    fprintf(stderr, "  --cache N     remember up to N results of div, mod, pow and decimal\n");
+    fprintf(stderr, "                output (per thread); hit counts go to stderr\n");
+    fprintf(stderr, "  --listen ADDR serve the batch protocol on a Unix socket path, or on TCP at\n");
+    fprintf(stderr, "                HOST:PORT or :PORT (127.0.0.1), until SIGINT or SIGTERM\n");
+    fprintf(stderr, "  --encode      convert numbers, one per line, to 33-byte binary records\n");
+    fprintf(stderr, "  --decode      convert binary records to result lines\n");
+    fprintf(stderr, "  --records OP  apply OP (or \"expr\" with --expr) to binary operand records,\n");
+    fprintf(stderr, "                writing one result record per operation\n");
+    fprintf(stderr, "  --be          records are big-endian (default little-endian)\n");
+    fprintf(stderr, "  --stats       print operation counts and stage latencies as JSON on stderr\n");
+    fprintf(stderr, "                at exit and on SIGUSR1 (needs a build with CALC256_STATS)\n");
+}
 
-Int256 str_to_int256(const char* str) {
-    Int256 result = {{0, 0, 0, 0}, 0};
-    
-    // Skip leading whitespace
-    while (isspace((unsigned char)*str)) str++;
-    
-    int i = 0;
-    if (str[0] == '-') {
-        result.sign = 1;
-        i = 1;
-    } else if (str[0] == '+') {
-        i = 1;
-    }
-    
-    int base = 10;
-    if (str[i] == '0' && (str[i+1] == 'x' || str[i+1] == 'X')) {
-        base = 16;
-        i += 2;
-    } else if (str[i] == '0' && (str[i+1] == 'b' || str[i+1] == 'B')) {
-        base = 2;
-        i += 2;
-    }
-    
-    while (str[i]) {
-        uint64_t digit;
-        char c = str[i];
-        
-        if (c >= '0' && c <= '9') {
-            digit = c - '0';
-        } else if (base == 16) {
-            if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
-            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
-            else break;
-        } else {
-            break;
-        }
-        
-        if (digit >= (uint64_t)base) break;
-        
-        uint64_t carry = digit;
-        for (int j = 3; j >= 0; j--) {
-            __uint128_t temp = (__uint128_t)result.part[j] * base + carry;
-            result.part[j] = (uint64_t)temp;
-            carry = (uint64_t)(temp >> 64);
-        }
-        
-        if (carry != 0) {
-            for (int j = 3; j > 0; j--) {
-                result.part[j] = result.part[j-1];
-            }
-            result.part[0] = carry;
-        }
-        
-        i++;
-    }
+// Parses a number typed at the menu, warning about anything suspicious
+Int256 menu_parse_number(const char* text) {
+    Int256 result;
+    size_t len = strlen(text), consumed;
+    Int256Status status = parse_int256(text, len, &result, &consumed);
     
     // Skip trailing whitespace
-    while (str[i] && isspace((unsigned char)str[i])) i++;
-    
-    if (str[i] != '\0') {
-        printf("Warning: Invalid characters in number '%s'\n", str);
-    }
+    while (consumed < len && isspace((unsigned char)text[consumed])) consumed++;
     
-    if (result.part[0] == 0 && result.part[1] == 0 && 
-        result.part[2] == 0 && result.part[3] == 0) {
-        result.sign = 0;
+    if (status == INT256_ERR_INVALID || consumed != len) {
+        STATS_INPUT_ERROR();
+        printf("Warning: Invalid characters in number '%s'\n", text);
+    } else if (status == INT256_ERR_OVERFLOW) {
+        STATS_INPUT_ERROR();
+        printf("Warning: Number '%s' exceeds 256 bits\n", text);
     }
-    
     return result;
 }
 
-void int256_to_hex(const Int256 n, char* buffer, size_t buffer_size) {
-    if (buffer_size < 68) {  // 2 for "0x" + 64 hex digits + 1 for sign + 1 for null
-        buffer[0] = '\0';
-        return;
-    }
-    
-    char* ptr = buffer;
-    
-    if (n.sign) *ptr++ = '-';
-    *ptr++ = '0';
-    *ptr++ = 'x';
-    
-    int started = 0;
-    for (int i = 0; i < 4; i++) {
-        if (n.part[i] != 0 || started || i == 3) {
-            if (!started) {
-                int written = snprintf(ptr, buffer_size - (ptr - buffer), 
-                                      "%" PRIx64, n.part[i]);
-                if (written < 0) {
-                    buffer[0] = '\0';
-                    return;
-                }
-                ptr += written;
-                started = 1;
-            } else {
-                int written = snprintf(ptr, buffer_size - (ptr - buffer), 
-                                      "%016" PRIx64, n.part[i]);
-                if (written < 0) {
-                    buffer[0] = '\0';
-                    return;
-                }
-                ptr += written;
-            }
-        }
-    }
-    if (!started) {
-        *ptr++ = '0';
-        *ptr = '\0';
-    } else {
-        *ptr = '\0';
+void menu_report_status(Int256Status status, const char* overflow_message) {
+    STATS_RESULT(status);
+    if (status == INT256_ERR_OVERFLOW) {
+        printf("Warning: %s\n", overflow_message);
+    } else if (status == INT256_ERR_DIV_BY_ZERO) {
+        printf("Error: Division by zero!\n");
+    } else if (status == INT256_ERR_DOMAIN) {
+        printf("Error: Argument out of domain!\n");
     }
 }
 
-void int256_to_decimal(const Int256 n, char* buffer, size_t buffer_size) {
-    if (buffer_size < 2) {
-        buffer[0] = '\0';
-        return;
-    }
-    
-    char* buf_ptr = buffer;
+// Menu option 17: compile an expression, then ask for each variable
+void menu_expression(void) {
+    char text[1024], value[100], err[128];
     
-    if (n.sign && buffer_size > 1) {
-        *buf_ptr++ = '-';
-        buffer_size--;
+    printf("Enter expression (e.g. (a*b + c) %% m): ");
+    fflush(stdout);
+    if (fgets(text, sizeof(text), stdin) == NULL) {
+        printf("Input error\n");
+        return;
     }
+    text[strcspn(text, "\n")] = '\0';
     
-    if (n.part[0] == 0 && n.part[1] == 0 && n.part[2] == 0 && n.part[3] == 0) {
-        *buf_ptr++ = '0';
-        *buf_ptr = '\0';
+    Int256Expr* expr = expr_compile_int256(text, strlen(text), err, sizeof(err));
+    if (expr == NULL) {
+        printf("Error: %s\n", err);
         return;
     }
     
-    // Use a temporary buffer large enough for 256-bit decimal (up to 78 digits)
-    char temp[100] = {0};
-    int pos = sizeof(temp) - 1;
-    temp[pos] = '\0';
-    
-    uint64_t work[8] = {0};
-    work[4] = n.part[0];
-    work[5] = n.part[1];
-    work[6] = n.part[2];
-    work[7] = n.part[3];
-    
-    while (1) {
-        uint64_t remainder = 0;
-        for (int i = 0; i < 8; i++) {
-            __uint128_t value = ((__uint128_t)remainder << 64) | work[i];
-            work[i] = (uint64_t)(value / BASE);
-            remainder = (uint64_t)(value % BASE);
-        }
-        
-        // Extract 9 decimal digits from remainder
-        char digits[10];
-        for (int j = 8; j >= 0; j--) {
-            digits[j] = '0' + (remainder % 10);
-            remainder /= 10;
-        }
-        
-        // Add digits to temp buffer
-        int start = 0;
-        while (start < 9 && digits[start] == '0') start++;
-        for (int j = start; j < 9; j++) {
-            temp[--pos] = digits[j];
-        }
-        
-        int all_zero = 1;
-        for (int i = 0; i < 8; i++) {
-            if (work[i] != 0) {
-                all_zero = 0;
-                break;
-            }
+    Int256 vars[INT256_EXPR_MAX_VARS];
+    for (int i = 0; i < expr_var_count_int256(expr); i++) {
+        printf("Enter %s: ", expr_var_name_int256(expr, i));
+        fflush(stdout);
+        if (fgets(value, sizeof(value), stdin) == NULL) {
+            printf("Input error\n");
+            expr_free_int256(expr);
+            return;
         }
-        if (all_zero) break;
+        value[strcspn(value, "\n")] = '\0';
+        vars[i] = menu_parse_number(value);
     }
     
-    // Remove leading zeros
-    while (temp[pos] == '0') pos++;
-    
-    // Copy to output buffer
-    size_t len = sizeof(temp) - pos - 1;
-    if (len >= buffer_size) {
-        buffer[0] = '\0';
-        return;
-    }
-    strcpy(buf_ptr, &temp[pos]);
-}
-
-int cmp_abs_int256(const Int256 a, const Int256 b) {
-    for (int i = 0; i < 4; i++) {
-        if (a.part[i] < b.part[i]) return -1;
-        if (a.part[i] > b.part[i]) return 1;
-    }
-    return 0;
-}
-
-int is_zero_int256(const Int256 a) {
-    return a.part[0] == 0 && a.part[1] == 0 && a.part[2] == 0 && a.part[3] == 0;
-}
-
-Int256 neg_int256(Int256 a) {
-    if (!is_zero_int256(a)) {
-        a.sign = !a.sign;
-    }
-    return a;
-}
-
-Int256 abs_int256(Int256 a) {
-    a.sign = 0;
-    return a;
-}
-
-// ==================== EXACT ARITHMETIC (FIXED) ====================
-
-static inline uint64_t add_with_carry(uint64_t a, uint64_t b, uint64_t* carry) {
-    __uint128_t sum = (__uint128_t)a + b + *carry;
-    *carry = (uint64_t)(sum >> 64);
-    return (uint64_t)sum;
-}
-
-static inline uint64_t sub_with_borrow(uint64_t a, uint64_t b, uint64_t* borrow) {
-    __uint128_t diff = (__uint128_t)a - b - *borrow;
-    *borrow = (diff >> 127) ? 1 : 0;  // Fix: check if underflow occurred
-    return (uint64_t)diff;
+    Int256 result;
+    Int256Status status = expr_eval_int256(expr, vars, &result);
+    expr_free_int256(expr);
+    menu_report_status(status, "Result exceeds 256 bits (wrapped)");
+    if (status == INT256_ERR_DIV_BY_ZERO) return;
+    
+    char result_hex[70], result_dec[80];
+    int256_to_hex(result, result_hex, sizeof(result_hex));
+    int256_to_decimal(result, result_dec, sizeof(result_dec));
+    printf("\nResult: %s\n", result_dec);
+    printf("Hex: %s\n", result_hex);
 }
 
-Int256 add_int256(Int256 a, Int256 b) {
-    Int256 result;
-    
-    if (a.sign == b.sign) {
-        uint64_t carry = 0;
-        for (int i = 3; i >= 0; i--) {
-            result.part[i] = add_with_carry(a.part[i], b.part[i], &carry);
-        }
-        result.sign = a.sign;
-        // If we have carry out of most significant part, we have overflow
-        if (carry != 0) {
-            printf("Warning: Addition overflow\n");
-        }
-    } else {
-        if (cmp_abs_int256(a, b) >= 0) {
-            uint64_t borrow = 0;
-            for (int i = 3; i >= 0; i--) {
-                result.part[i] = sub_with_borrow(a.part[i], b.part[i], &borrow);
+int main(int argc, char** argv) {
+    int batch = 0;
+    const char* expr_text = NULL;
+    const char* file = NULL;
+    const char* listen_address = NULL;
+    const char* records_op = NULL;
+    int encode = 0, decode = 0, stats = 0;
+    Int256RecordOrder order = INT256_RECORD_LE;
+    BatchOptions opts = {0, NULL, 1, 0, INT256_ROUND_TRUNC, NULL};
+    Int256Fixed fixed;
+    long scale = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0) {
+            batch = 1;
+        } else if (strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+            batch = 1;
+            file = argv[++i];
+        } else if (strcmp(argv[i], "--listen") == 0 && i + 1 < argc) {
+            listen_address = argv[++i];
+        } else if (strcmp(argv[i], "--records") == 0 && i + 1 < argc) {
+            records_op = argv[++i];
+        } else if (strcmp(argv[i], "--encode") == 0) {
+            encode = 1;
+        } else if (strcmp(argv[i], "--decode") == 0) {
+            decode = 1;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats = 1;
+        } else if (strcmp(argv[i], "--be") == 0) {
+            order = INT256_RECORD_BE;
+        } else if (strcmp(argv[i], "--hex") == 0) {
+            opts.hex_output = 1;
+        } else if (strcmp(argv[i], "--expr") == 0 && i + 1 < argc) {
+            expr_text = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            char* end;
+            long n = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || n < 0 || n > BATCH_MAX_THREADS) {
+                print_usage(argv[0]);
+                return 2;
             }
-            result.sign = a.sign;
-        } else {
-            uint64_t borrow = 0;
-            for (int i = 3; i >= 0; i--) {
-                result.part[i] = sub_with_borrow(b.part[i], a.part[i], &borrow);
+            opts.threads = n > 0 ? (int)n : batch_cpu_count();
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            char* end;
+            long long n = strtoll(argv[++i], &end, 10);
+            if (*end != '\0' || n < 0) {
+                print_usage(argv[0]);
+                return 2;
             }
-            result.sign = b.sign;
-        }
-    }
-    
-    if (is_zero_int256(result)) result.sign = 0;
-    return result;
-}
-
-Int256 sub_int256(Int256 a, Int256 b) {
-    b.sign = !b.sign;
-    Int256 result = add_int256(a, b);
-    b.sign = !b.sign;
-    return result;
-}
-
-// FIXED MULTIPLICATION - Schoolbook algorithm
-Int256 mul_int256(Int256 a, Int256 b) {
-    // 4x4 schoolbook multiplication
-    __uint128_t temp[8] = {0};
-    
-    // Multiply each 64-bit part
-    for (int i = 3; i >= 0; i--) {
-        for (int j = 3; j >= 0; j--) {
-            __uint128_t product = (__uint128_t)a.part[i] * b.part[j];
-            int pos = (3 - i) + (3 - j);  // Position in temp array
-            
-            temp[pos] += (uint64_t)product;
-            if (temp[pos] < (uint64_t)product) { // Check for overflow
-                temp[pos + 1] += 1;
+            opts.cache_size = (size_t)n;
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            char* end;
+            scale = strtol(argv[++i], &end, 10);
+            if (*end != '\0' || scale < 0 || scale > INT256_MAX_SCALE) {
+                print_usage(argv[0]);
+                return 2;
             }
-            temp[pos + 1] += (product >> 64);
-        }
-    }
-    
-    // Propagate carries
-    for (int i = 0; i < 7; i++) {
-        uint64_t carry = (uint64_t)(temp[i] >> 64);
-        if (carry != 0) {
-            temp[i] &= 0xFFFFFFFFFFFFFFFFULL;
-            temp[i + 1] += carry;
-        }
-    }
-    
-    // Check for overflow beyond 256 bits
-    if (temp[7] != 0 || temp[6] != 0 || temp[5] != 0 || temp[4] != 0) {
-        printf("Warning: Multiplication overflow (result exceeds 256 bits)\n");
-    }
-    
-    // Build result (256 bits)
-    Int256 result;
-    result.part[3] = (uint64_t)temp[0];
-    result.part[2] = (uint64_t)temp[1];
-    result.part[1] = (uint64_t)temp[2];
-    result.part[0] = (uint64_t)temp[3];
-    
-    // Sign handling
-    result.sign = a.sign ^ b.sign;
-    if (is_zero_int256(result)) result.sign = 0;
-    
-    return result;
-}
-
-// FIXED DIVISION - Binary long division with proper sign handling
-Int256 div_int256(Int256 a, Int256 b) {
-    if (is_zero_int256(b)) {
-        printf("Error: Division by zero!\n");
-        return (Int256){{0, 0, 0, 0}, 0};
-    }
-    
-    int result_sign = a.sign ^ b.sign;
-    
-    // Work with absolute values
-    Int256 a_abs = a;
-    a_abs.sign = 0;
-    Int256 b_abs = b;
-    b_abs.sign = 0;
-    
-    if (cmp_abs_int256(a_abs, b_abs) < 0) {
-        return (Int256){{0, 0, 0, 0}, 0};
-    }
-    
-    // Binary long division
-    Int256 quotient = {{0, 0, 0, 0}, 0};
-    Int256 remainder = {{0, 0, 0, 0}, 0};
-    
-    for (int i = 0; i < 4; i++) {
-        for (int bit = 63; bit >= 0; bit--) {
-            // Shift remainder left by 1
-            uint64_t carry = remainder.part[0] >> 63;
-            remainder.part[0] = (remainder.part[0] << 1) | (remainder.part[1] >> 63);
-            remainder.part[1] = (remainder.part[1] << 1) | (remainder.part[2] >> 63);
-            remainder.part[2] = (remainder.part[2] << 1) | (remainder.part[3] >> 63);
-            remainder.part[3] = (remainder.part[3] << 1);
-            
-            // Add next bit from a
-            remainder.part[3] |= (a_abs.part[i] >> bit) & 1;
-            
-            // Shift quotient left
-            carry = quotient.part[0] >> 63;
-            quotient.part[0] = (quotient.part[0] << 1) | (quotient.part[1] >> 63);
-            quotient.part[1] = (quotient.part[1] << 1) | (quotient.part[2] >> 63);
-            quotient.part[2] = (quotient.part[2] << 1) | (quotient.part[3] >> 63);
-            quotient.part[3] = (quotient.part[3] << 1);
-            
-            if (cmp_abs_int256(remainder, b_abs) >= 0) {
-                // Subtract b from remainder
-                uint64_t borrow = 0;
-                for (int j = 3; j >= 0; j--) {
-                    remainder.part[j] = sub_with_borrow(remainder.part[j], b_abs.part[j], &borrow);
-                }
-                quotient.part[3] |= 1;
+        } else if (strcmp(argv[i], "--round") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            int mode = -1;
+            for (int k = 0; k < (int)(sizeof(rounding_names) / sizeof(rounding_names[0])); k++) {
+                if (strcmp(name, rounding_names[k]) == 0) mode = k;
             }
-        }
-    }
-    
-    quotient.sign = result_sign;
-    if (is_zero_int256(quotient)) quotient.sign = 0;
-    
-    return quotient;
-}
-
-Int256 mod_int256(Int256 a, Int256 b) {
-    if (is_zero_int256(b)) {
-        printf("Error: Division by zero!\n");
-        return (Int256){{0, 0, 0, 0}, 0};
-    }
-    
-    int result_sign = a.sign;  // Remainder takes sign of dividend
-    
-    // Work with absolute values
-    Int256 a_abs = a;
-    a_abs.sign = 0;
-    Int256 b_abs = b;
-    b_abs.sign = 0;
-    
-    if (cmp_abs_int256(a_abs, b_abs) < 0) {
-        return a;  // If |a| < |b|, remainder is a
-    }
-    
-    // Binary long division to get remainder
-    Int256 remainder = {{0, 0, 0, 0}, 0};
-    
-    for (int i = 0; i < 4; i++) {
-        for (int bit = 63; bit >= 0; bit--) {
-            // Shift remainder left by 1
-            uint64_t carry = remainder.part[0] >> 63;
-            remainder.part[0] = (remainder.part[0] << 1) | (remainder.part[1] >> 63);
-            remainder.part[1] = (remainder.part[1] << 1) | (remainder.part[2] >> 63);
-            remainder.part[2] = (remainder.part[2] << 1) | (remainder.part[3] >> 63);
-            remainder.part[3] = (remainder.part[3] << 1);
-            
-            // Add next bit from a
-            remainder.part[3] |= (a_abs.part[i] >> bit) & 1;
-            
-            if (cmp_abs_int256(remainder, b_abs) >= 0) {
-                // Subtract b from remainder
-                uint64_t borrow = 0;
-                for (int j = 3; j >= 0; j--) {
-                    remainder.part[j] = sub_with_borrow(remainder.part[j], b_abs.part[j], &borrow);
-                }
+            if (mode < 0) {
+                print_usage(argv[0]);
+                return 2;
             }
+            opts.rounding = (Int256Rounding)mode;
+        } else {
+            print_usage(argv[0]);
+            return 2;
         }
     }
-    
-    remainder.sign = result_sign;
-    if (is_zero_int256(remainder)) remainder.sign = 0;
-    
-    return remainder;
-}
-
-// ==================== BITWISE OPERATIONS ====================
-
-Int256 and_int256(Int256 a, Int256 b) {
-    Int256 result;
-    for (int i = 0; i < 4; i++) {
-        result.part[i] = a.part[i] & b.part[i];
-    }
-    result.sign = a.sign & b.sign;
-    return result;
-}
-
-Int256 or_int256(Int256 a, Int256 b) {
-    Int256 result;
-    for (int i = 0; i < 4; i++) {
-        result.part[i] = a.part[i] | b.part[i];
-    }
-    result.sign = a.sign | b.sign;
-    return result;
-}
-
-Int256 xor_int256(Int256 a, Int256 b) {
-    Int256 result;
-    for (int i = 0; i < 4; i++) {
-        result.part[i] = a.part[i] ^ b.part[i];
-    }
-    result.sign = a.sign ^ b.sign;
-    return result;
-}
-
-Int256 shift_left_int256(Int256 a, int bits) {
-    if (bits <= 0) return a;
-    if (bits >= 256) return (Int256){{0, 0, 0, 0}, a.sign};
-    
-    Int256 result = {{0, 0, 0, 0}, a.sign};
-    
-    int word_shift = bits / 64;
-    int bit_shift = bits % 64;
-    
-    if (bit_shift == 0) {
-        for (int i = 3; i >= word_shift; i--) {
-            result.part[i] = a.part[i - word_shift];
-        }
-    } else {
-        for (int i = 3; i >= word_shift; i--) {
-            int src_idx = i - word_shift;
-            int prev_idx = src_idx - 1;
-            
-            uint64_t low_part = (prev_idx >= 0) ? (a.part[prev_idx] >> (64 - bit_shift)) : 0;
-            result.part[i] = (a.part[src_idx] << bit_shift) | low_part;
-        }
-    }
-    
-    return result;
-}
-
-Int256 shift_right_int256(Int256 a, int bits) {
-    if (bits <= 0) return a;
-    if (bits >= 256) return (Int256){{0, 0, 0, 0}, a.sign};
-    
-    Int256 result = {{0, 0, 0, 0}, a.sign};
-    
-    int word_shift = bits / 64;
-    int bit_shift = bits % 64;
-    
-    if (bit_shift == 0) {
-        for (int i = 0; i < 4 - word_shift; i++) {
-            result.part[i] = a.part[i + word_shift];
+    if (scale >= 0) {
+        if (opts.hex_output || expr_text) {
+            fprintf(stderr, "calc256: --scale does not combine with --hex or --expr\n");
+            return 2;
         }
-    } else {
-        for (int i = 0; i < 4 - word_shift; i++) {
-            int src_idx = i + word_shift;
-            int next_idx = src_idx + 1;
-            
-            uint64_t high_part = (next_idx < 4) ? (a.part[next_idx] << (64 - bit_shift)) : 0;
-            result.part[i] = (a.part[src_idx] >> bit_shift) | high_part;
-        }
-    }
-    
-    return result;
-}
-
-// ==================== COMPARISON ====================
-
-int cmp_int256(Int256 a, Int256 b) {
-    if (a.sign != b.sign) {
-        return (a.sign > b.sign) ? -1 : 1;
-    }
-    
-    int cmp = cmp_abs_int256(a, b);
-    return a.sign ? -cmp : cmp;
-}
-
-// ==================== POWER AND FACTORIAL (FIXED) ====================
-
-Int256 pow_int256(Int256 base, unsigned int exp) {
-    if (exp == 0) {
-        return (Int256){{0, 0, 0, 1}, 0};
-    }
-    
-    Int256 result = {{0, 0, 0, 1}, 0};
-    Int256 temp = base;
-    
-    while (exp > 0) {
-        if (exp & 1) {
-            result = mul_int256(result, temp);
+        fixed_init_int256(&fixed, (unsigned int)scale, opts.rounding);
+        opts.fixed = &fixed;
+    }
+    if (stats) stats_init();
+    int record_mode = records_op != NULL || encode || decode;
+    if (batch || listen_address || record_mode) {
+        Int256Expr* expr = NULL;
+        if (expr_text) {
+            char err[128];
+            expr = expr_compile_int256(expr_text, strlen(expr_text), err, sizeof(err));
+            if (expr == NULL) {
+                fprintf(stderr, "calc256: --expr: %s\n", err);
+                return 2;
+            }
+            opts.expr = expr;
         }
-        temp = mul_int256(temp, temp);
-        exp >>= 1;
-    }
-    
-    return result;
-}
-
-Int256 factorial_int256(unsigned int n) {
-    if (n <= 1) return (Int256){{0, 0, 0, 1}, 0};
-    
-    Int256 result = {{0, 0, 0, 1}, 0};
-    for (unsigned int i = 2; i <= n; i++) {
-        Int256 multiplier = {{0, 0, 0, i}, 0};
-        result = mul_int256(result, multiplier);
-        if (is_zero_int256(result)) {
-            printf("Warning: Factorial overflow at i=%u\n", i);
-            break;
+        int rc;
+        if (record_mode) {
+            FILE* in = file ? fopen(file, "rb") : stdin;
+            if (in == NULL) {
+                fprintf(stderr, "calc256: %s: %s\n", file, strerror(errno));
+                rc = 1;
+            } else {
+                rc = encode ? run_encode(in, stdout, order, &opts)
+                   : decode ? run_decode(in, stdout, order, &opts)
+                            : run_records(in, stdout, records_op, order, &opts);
+                if (in != stdin) fclose(in);
+            }
+        } else if (listen_address) {
+            rc = run_server(listen_address, &opts);
+        } else {
+            rc = file ? run_batch_file(file, stdout, &opts) : run_batch(stdin, stdout, &opts);
         }
+        expr_free_int256(expr);
+        if (stats) stats_report(stderr);
+        return rc;
     }
     
-    return result;
-}
-
-// ==================== MAIN WITH FIXED INPUT HANDLING ====================
-
-void print_menu() {
-    printf("\n=== 256-Bit Calculator (Exact) ===\n");
-    printf("1. Add (+)          2. Subtract (-)\n");
-    printf("3. Multiply (×)     4. Divide (÷)\n");
-    printf("5. Modulo (%%)       6. AND (&)\n");
-    printf("7. OR (|)           8. XOR (^)\n");
-    printf("9. Shift Left (<<) 10. Shift Right (>>)\n");
-    printf("11. Power (a^b)    12. Factorial (n!)\n");
-    printf("13. Compare        14. Negate (-x)\n");
-    printf("15. Absolute       0. Exit\n");
-    printf("Choice: ");
-}
-
-int main() {
     printf("256-Bit Calculator with Exact Arithmetic\n");
     printf("Supports: Negative numbers, Fixed multiplication\n");
     printf("Max value: ~1.16e77 (2^256 - 1)\n");
     
     char input[100];
+    Int256Cache* cache = opts.cache_size ? cache_create_int256(opts.cache_size) : NULL;
     
     while (1) {
         print_menu();
@@ -606,7 +274,7 @@ int main() {
         
         // Skip empty input
         if (input[0] == '\0') {
-            printf("Please enter a choice (0-15)\n");
+            printf("Please enter a choice (0-22)\n");
             continue;
         }
         
@@ -615,22 +283,24 @@ int main() {
         long choice_long = strtol(input, &endptr, 10);
         
         if (*endptr != '\0') {
-            printf("Invalid input: '%s'. Please enter a number 0-15.\n", input);
+            printf("Invalid input: '%s'. Please enter a number 0-22.\n", input);
             continue;
         }
         
         int choice = (int)choice_long;
         
-        if (choice < 0 || choice > 15) {
-            printf("Invalid choice: %d. Please enter 0-15.\n", choice);
+        if (choice < 0 || choice > 22) {
+            printf("Invalid choice: %d. Please enter 0-22.\n", choice);
             continue;
         }
         
         if (choice == 0) break;
         
-        char buffer1[100], buffer2[100];
+        char buffer1[100], buffer2[100], buffer3[100];
         char result_hex[70], result_dec[80];
         Int256 a, b, result;
+        Int256Mont mont;
+        Int256Status status;
         unsigned int shift = 0, power = 0, factorial_n = 0;
         int cmp;
         
@@ -653,20 +323,30 @@ int main() {
                 }
                 buffer2[strcspn(buffer2, "\n")] = '\0';
                 
-                a = str_to_int256(buffer1);
-                b = str_to_int256(buffer2);
+                a = menu_parse_number(buffer1);
+                b = menu_parse_number(buffer2);
                 
+                status = INT256_OK;
                 switch (choice) {
-                    case 1: result = add_int256(a, b); break;
-                    case 2: result = sub_int256(a, b); break;
-                    case 3: result = mul_int256(a, b); break;
-                    case 4: result = div_int256(a, b); break;
-                    case 5: result = mod_int256(a, b); break;
+                    case 1: status = add_int256_checked(a, b, &result); break;
+                    case 2: status = sub_int256_checked(a, b, &result); break;
+                    case 3: status = mul_int256_checked(a, b, &result); break;
+                    case 4:
+                        status = cache ? cache_div_int256(cache, a, b, &result)
+                                       : div_int256_checked(a, b, &result);
+                        break;
+                    case 5:
+                        status = cache ? cache_mod_int256(cache, a, b, &result)
+                                       : mod_int256_checked(a, b, &result);
+                        break;
                     case 6: result = and_int256(a, b); break;
                     case 7: result = or_int256(a, b); break;
                     case 8: result = xor_int256(a, b); break;
                     default: result = a; break;
                 }
+                menu_report_status(status, choice == 3
+                                   ? "Multiplication overflow (result exceeds 256 bits)"
+                                   : "Addition overflow");
                 
                 int256_to_hex(result, result_hex, sizeof(result_hex));
                 int256_to_decimal(result, result_dec, sizeof(result_dec));
@@ -697,7 +377,7 @@ int main() {
                     shift = 255;
                 }
                 
-                a = str_to_int256(buffer1);
+                a = menu_parse_number(buffer1);
                 result = (choice == 9) ? shift_left_int256(a, shift) 
                                       : shift_right_int256(a, shift);
                 
@@ -725,8 +405,10 @@ int main() {
                 }
                 while (getchar() != '\n');
                 
-                a = str_to_int256(buffer1);
-                result = pow_int256(a, power);
+                a = menu_parse_number(buffer1);
+                status = cache ? cache_pow_int256(cache, a, power, &result)
+                               : pow_int256_checked(a, power, &result);
+                menu_report_status(status, "Power overflow (result exceeds 256 bits)");
                 
                 int256_to_hex(result, result_hex, sizeof(result_hex));
                 int256_to_decimal(result, result_dec, sizeof(result_dec));
@@ -735,7 +417,7 @@ int main() {
                 break;
                 
             case 12:
-                printf("Enter n (0-100): ");
+                printf("Enter n: ");
                 fflush(stdout);
                 if (scanf("%u", &factorial_n) != 1) {
                     while (getchar() != '\n');
@@ -744,14 +426,11 @@ int main() {
                 }
                 while (getchar() != '\n');
                 
-                if (factorial_n > 100) {
-                    printf("Warning: Large factorial will be slow!\n");
-                }
-                
-                result = factorial_int256(factorial_n);
+                status = factorial_int256_checked(factorial_n, &result);
+                menu_report_status(status, "Factorial overflow (result exceeds 256 bits)");
                 int256_to_decimal(result, result_dec, sizeof(result_dec));
                 int256_to_hex(result, result_hex, sizeof(result_hex));
-                printf("\n%d! = %s\n", factorial_n, result_dec);
+                printf("\n%u! = %s\n", factorial_n, result_dec);
                 printf("Hex: %s\n", result_hex);
                 break;
                 
@@ -772,8 +451,8 @@ int main() {
                 }
                 buffer2[strcspn(buffer2, "\n")] = '\0';
                 
-                a = str_to_int256(buffer1);
-                b = str_to_int256(buffer2);
+                a = menu_parse_number(buffer1);
+                b = menu_parse_number(buffer2);
                 
                 cmp = cmp_int256(a, b);
                 printf("\n%s %c %s\n", buffer1, 
@@ -789,7 +468,7 @@ int main() {
                 }
                 buffer1[strcspn(buffer1, "\n")] = '\0';
                 
-                a = str_to_int256(buffer1);
+                a = menu_parse_number(buffer1);
                 result = neg_int256(a);
                 int256_to_decimal(result, result_dec, sizeof(result_dec));
                 printf("\nResult: %s\n", result_dec);
@@ -804,17 +483,232 @@ int main() {
                 }
                 buffer1[strcspn(buffer1, "\n")] = '\0';
                 
-                a = str_to_int256(buffer1);
+                a = menu_parse_number(buffer1);
                 result = abs_int256(a);
                 int256_to_decimal(result, result_dec, sizeof(result_dec));
                 printf("\n|%s| = %s\n", buffer1, result_dec);
                 break;
                 
+            case 16:
+                printf("Enter base: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                printf("Enter exponent: ");
+                fflush(stdout);
+                if (fgets(buffer2, sizeof(buffer2), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer2[strcspn(buffer2, "\n")] = '\0';
+                
+                printf("Enter modulus: ");
+                fflush(stdout);
+                if (fgets(buffer3, sizeof(buffer3), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer3[strcspn(buffer3, "\n")] = '\0';
+                
+                a = menu_parse_number(buffer1);
+                b = menu_parse_number(buffer2);
+                Int256 modulus = menu_parse_number(buffer3);
+                if (mont_init_int256(&mont, modulus) != 0) {
+                    printf("Error: Modulus must be non-zero!\n");
+                    break;
+                }
+                if (b.sign) {
+                    // a^-e = (a^-1)^e
+                    if (modinv_int256(a, modulus, &a) != INT256_OK) {
+                        printf("Error: Base has no inverse modulo the modulus!\n");
+                        break;
+                    }
+                    b.sign = 0;
+                }
+                result = powmod_int256(&mont, a, b);
+                
+                int256_to_hex(result, result_hex, sizeof(result_hex));
+                int256_to_decimal(result, result_dec, sizeof(result_dec));
+                printf("\nResult: %s\n", result_dec);
+                printf("Hex: %s\n", result_hex);
+                break;
+                
+            case 17:
+                menu_expression();
+                break;
+                
+            case 18:
+                printf("Enter number: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                printf("Enter n (2 = square root): ");
+                fflush(stdout);
+                if (scanf("%u", &power) != 1) {
+                    while (getchar() != '\n');
+                    printf("Invalid n.\n");
+                    break;
+                }
+                while (getchar() != '\n');
+                
+                a = menu_parse_number(buffer1);
+                status = iroot_int256(a, power, &result);
+                menu_report_status(status, "");
+                if (status != INT256_OK) break;
+                
+                int256_to_hex(result, result_hex, sizeof(result_hex));
+                int256_to_decimal(result, result_dec, sizeof(result_dec));
+                printf("\nResult: %s\n", result_dec);
+                printf("Hex: %s\n", result_hex);
+                break;
+                
+            case 19:
+                printf("Enter number: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                a = menu_parse_number(buffer1);
+                if (is_zero_int256(a)) {
+                    printf("Error: Logarithm of zero!\n");
+                    break;
+                }
+                printf("\nfloor(log2 |x|) = %d\n", ilog2_int256(a));
+                printf("floor(log10 |x|) = %d\n", ilog10_int256(a));
+                break;
+                
+            case 20: {
+                printf("Enter first number: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                printf("Enter second number: ");
+                fflush(stdout);
+                if (fgets(buffer2, sizeof(buffer2), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer2[strcspn(buffer2, "\n")] = '\0';
+                
+                a = menu_parse_number(buffer1);
+                b = menu_parse_number(buffer2);
+                Int256 x, y;
+                result = xgcd_int256(a, b, &x, &y);
+                int256_to_decimal(result, result_dec, sizeof(result_dec));
+                printf("\ngcd = %s\n", result_dec);
+                int256_to_decimal(x, result_dec, sizeof(result_dec));
+                printf("x = %s\n", result_dec);
+                int256_to_decimal(y, result_dec, sizeof(result_dec));
+                printf("y = %s\n", result_dec);
+                
+                if (lcm_int256(a, b, &result) == INT256_OK) {
+                    int256_to_decimal(result, result_dec, sizeof(result_dec));
+                    printf("lcm = %s\n", result_dec);
+                } else {
+                    printf("lcm exceeds 256 bits\n");
+                }
+                if (modinv_int256(a, b, &result) == INT256_OK) {
+                    int256_to_decimal(result, result_dec, sizeof(result_dec));
+                    printf("a^-1 mod b = %s\n", result_dec);
+                } else {
+                    printf("a has no inverse mod b\n");
+                }
+                break;
+            }
+                
+            case 21: {
+                printf("Enter number: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                a = menu_parse_number(buffer1);
+                printf("\n%s\n", isprime_int256(a) ? "Prime" : "Not prime");
+                if (is_zero_int256(a)) break;
+                
+                Int256Factors factors;
+                int count = factor_int256(a, &factors);
+                printf("Factors:");
+                for (int i = 0; i < count; i++) {
+                    int256_to_decimal(factors.factor[i], result_dec, sizeof(result_dec));
+                    printf(" %s", result_dec);
+                    if (factors.exponent[i] > 1) printf("^%u", factors.exponent[i]);
+                }
+                printf("%s\n", count == 0 ? " 1" : "");
+                if (factors.composite) {
+                    printf("(the last %d could not be split)\n", factors.composite);
+                }
+                break;
+            }
+                
+            case 22:
+                printf("Enter a: ");
+                fflush(stdout);
+                if (fgets(buffer1, sizeof(buffer1), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer1[strcspn(buffer1, "\n")] = '\0';
+                
+                printf("Enter b: ");
+                fflush(stdout);
+                if (fgets(buffer2, sizeof(buffer2), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer2[strcspn(buffer2, "\n")] = '\0';
+                
+                printf("Enter c: ");
+                fflush(stdout);
+                if (fgets(buffer3, sizeof(buffer3), stdin) == NULL) {
+                    printf("Input error\n");
+                    break;
+                }
+                buffer3[strcspn(buffer3, "\n")] = '\0';
+                
+                a = menu_parse_number(buffer1);
+                b = menu_parse_number(buffer2);
+                status = muldiv_int256(a, b, menu_parse_number(buffer3), opts.rounding, &result);
+                menu_report_status(status, "Quotient exceeds 256 bits (wrapped)");
+                if (status == INT256_ERR_DIV_BY_ZERO) break;
+                
+                int256_to_hex(result, result_hex, sizeof(result_hex));
+                int256_to_decimal(result, result_dec, sizeof(result_dec));
+                printf("\na*b/c (%s) = %s\n", rounding_names[opts.rounding], result_dec);
+                printf("Hex: %s\n", result_hex);
+                break;
+                
             default:
-                printf("Invalid choice! Please enter 0-15.\n");
+                printf("Invalid choice! Please enter 0-22.\n");
         }
     }
     
+    if (cache) {
+        Int256CacheStats stats;
+        cache_stats_int256(cache, &stats);
+        printf("\nCache: %llu hits, %llu misses\n", (unsigned long long)stats.hits,
+               (unsigned long long)stats.misses);
+        cache_free_int256(cache);
+    }
+    if (stats) stats_report(stderr);
     printf("\nGoodbye!\n");
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,703 @@
+#ifndef CALC256_H
+#define CALC256_H
+
+// libcalc256: exact 256-bit integer arithmetic.
+//
+// Int256 is sign-magnitude (the magnitude is a full 256 bits); UInt256 and
+// SInt256 are 32-byte two's complement values. The small operations that
+// sit in every inner loop (compare, negate, add, subtract, bitwise, shifts)
+// are static inline here so callers get them without a call; everything
+// else lives in the library.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ==================== TYPES ====================
+
+typedef struct {
+    uint64_t part[4];  // part[0] = most significant
+                       // part[1]
+                       // part[2]
+                       // part[3] = least significant
+    int sign;          // 0 = positive, 1 = negative
+} Int256;
+
+typedef struct {
+    uint64_t part[8];  // part[0] = most significant
+    int sign;          // 0 = positive, 1 = negative
+} Int512;
+
+typedef enum {
+    INT256_OK = 0,
+    INT256_ERR_EMPTY,      // no digits
+    INT256_ERR_INVALID,    // unexpected character
+    INT256_ERR_OVERFLOW,   // magnitude does not fit in 256 bits
+    INT256_ERR_DIV_BY_ZERO, // zero divisor
+    INT256_ERR_DOMAIN      // argument outside the function's domain
+} Int256Status;
+
+// How a result that falls between two representable values is rounded
+typedef enum {
+    INT256_ROUND_TRUNC,     // toward zero
+    INT256_ROUND_FLOOR,     // toward -infinity
+    INT256_ROUND_CEIL,      // toward +infinity
+    INT256_ROUND_AWAY,      // away from zero
+    INT256_ROUND_HALF_UP,   // to nearest, ties away from zero
+    INT256_ROUND_HALF_EVEN  // to nearest, ties to even
+} Int256Rounding;
+
+typedef enum {
+    DIVIDER_POW2,     // |d| = 2^shift
+    DIVIDER_WORD,     // |d| fits in one limb: 2-by-1 reciprocal division
+    DIVIDER_GENERAL   // 3-by-2 reciprocal per quotient limb
+} DividerKind;
+
+// A divisor prepared by divider_init_int256
+typedef struct {
+    DividerKind kind;
+    int sign;          // sign of the divisor
+    int shift;         // log2(|d|) for DIVIDER_POW2, normalization shift otherwise
+    int n;             // significant limbs of the divisor
+    uint64_t d[4];     // normalized divisor, little-endian limbs
+    uint64_t v;        // precomputed reciprocal
+} Int256Divider;
+
+// A modulus prepared by mont_init_int256
+typedef struct {
+    uint64_t n[4];     // |modulus|, little-endian
+    int len;           // significant limbs of n
+    int odd;           // 1 => Montgomery arithmetic, 0 => plain reduction
+    uint64_t n0inv;    // -n^-1 mod 2^64
+    uint64_t one[4];   // R mod n (1 in Montgomery form)
+    uint64_t r2[4];    // R^2 mod n, converts into Montgomery form
+} Int256Mont;
+
+// A fixed-point format prepared by fixed_init_int256: the value x is held
+// as the integer x * 10^scale
+typedef struct {
+    unsigned int scale;       // decimal places
+    Int256Rounding rounding;  // applied to every result with more places
+    Int256 one;               // 10^scale
+    Int256Divider unit;       // division by 10^scale
+} Int256Fixed;
+
+// A 256-bit number has at most 43 distinct prime factors
+#define INT256_MAX_FACTORS 64
+
+// Result of factor_int256: |n| = product of factor[i]^exponent[i]. The
+// first count - composite entries are primes in ascending order; the last
+// composite entries are cofactors Pollard rho could not split.
+typedef struct {
+    int count;
+    int composite;
+    Int256 factor[INT256_MAX_FACTORS];
+    unsigned int exponent[INT256_MAX_FACTORS];
+} Int256Factors;
+
+typedef struct {
+    uint64_t part[4];  // part[0] = most significant
+} UInt256;
+
+typedef struct {
+    uint64_t part[4];  // part[0] = most significant, bit 255 = sign
+} SInt256;
+
+// ==================== PARSING AND FORMATTING ====================
+
+// Parses at most len bytes of str: optional whitespace and sign, then
+// decimal digits, 0x-prefixed hex or 0b-prefixed binary. *out holds the
+// (wrapped) value on INT256_OK and INT256_ERR_OVERFLOW; consumed may be NULL.
+Int256Status parse_int256(const char* str, size_t len, Int256* out, size_t* consumed);
+Int256 str_to_int256(const char* str);
+Int256 str_to_int256_wrapping(const char* str);
+Int256 str_to_int256_saturating(const char* str);
+
+// buffer_size must be at least 68
+void int256_to_hex(const Int256 n, char* buffer, size_t buffer_size);
+// Returns the length written, or 0 with an empty string if it does not fit
+size_t int256_to_decimal(const Int256 n, char* buffer, size_t buffer_size);
+
+// ==================== BINARY RECORDS ====================
+//
+// A record is 33 bytes: the 32-byte magnitude in the chosen byte order,
+// then a sign byte: 0 = non-negative, 1 = negative, or
+// INT256_RECORD_ERROR | status for an operation that produced no value
+// (the magnitude is then zero).
+
+#define INT256_RECORD_SIZE 33
+#define INT256_RECORD_ERROR 0x80
+
+typedef enum {
+    INT256_RECORD_LE,   // least significant byte first
+    INT256_RECORD_BE    // most significant byte first
+} Int256RecordOrder;
+
+void int256_to_records(const Int256* values, size_t count, Int256RecordOrder order,
+                       unsigned char* out);
+// Decodes count records; those that hold no value decode as 0. Returns how
+// many did not hold a value (0 for clean input).
+size_t records_to_int256(const unsigned char* in, size_t count, Int256RecordOrder order,
+                         Int256* values);
+// INT256_OK for a value, the recorded status for an error record, and
+// INT256_ERR_INVALID for any other sign byte
+Int256Status record_status_int256(const unsigned char* record);
+void record_error_int256(Int256Status status, unsigned char* record);
+
+// ==================== INLINE CORE ====================
+
+static inline int cmp_abs_int256(const Int256 a, const Int256 b) {
+    for (int i = 0; i < 4; i++) {
+        if (a.part[i] < b.part[i]) return -1;
+        if (a.part[i] > b.part[i]) return 1;
+    }
+    return 0;
+}
+
+static inline int is_zero_int256(const Int256 a) {
+    return (a.part[0] | a.part[1] | a.part[2] | a.part[3]) == 0;
+}
+
+static inline Int256 neg_int256(Int256 a) {
+    if (!is_zero_int256(a)) {
+        a.sign = !a.sign;
+    }
+    return a;
+}
+
+static inline Int256 abs_int256(Int256 a) {
+    a.sign = 0;
+    return a;
+}
+
+static inline int cmp_int256(Int256 a, Int256 b) {
+    if (a.sign != b.sign) {
+        return (a.sign > b.sign) ? -1 : 1;
+    }
+
+    int cmp = cmp_abs_int256(a, b);
+    return a.sign ? -cmp : cmp;
+}
+
+static inline uint64_t add_with_carry(uint64_t a, uint64_t b, uint64_t* carry) {
+    __uint128_t sum = (__uint128_t)a + b + *carry;
+    *carry = (uint64_t)(sum >> 64);
+    return (uint64_t)sum;
+}
+
+static inline uint64_t sub_with_borrow(uint64_t a, uint64_t b, uint64_t* borrow) {
+    __uint128_t diff = (__uint128_t)a - b - *borrow;
+    *borrow = (diff >> 127) ? 1 : 0;
+    return (uint64_t)diff;
+}
+
+// Sets *overflow when the magnitude carries out of 256 bits (the result wraps)
+static inline Int256 add_int256_core(Int256 a, Int256 b, int* overflow) {
+    Int256 result;
+    *overflow = 0;
+
+    if (a.sign == b.sign) {
+        uint64_t carry = 0;
+        for (int i = 3; i >= 0; i--) {
+            result.part[i] = add_with_carry(a.part[i], b.part[i], &carry);
+        }
+        result.sign = a.sign;
+        *overflow = carry != 0;
+    } else {
+        if (cmp_abs_int256(a, b) >= 0) {
+            uint64_t borrow = 0;
+            for (int i = 3; i >= 0; i--) {
+                result.part[i] = sub_with_borrow(a.part[i], b.part[i], &borrow);
+            }
+            result.sign = a.sign;
+        } else {
+            uint64_t borrow = 0;
+            for (int i = 3; i >= 0; i--) {
+                result.part[i] = sub_with_borrow(b.part[i], a.part[i], &borrow);
+            }
+            result.sign = b.sign;
+        }
+    }
+
+    if (is_zero_int256(result)) result.sign = 0;
+    return result;
+}
+
+// Wraps on overflow; see add_int256_checked
+static inline Int256 add_int256(Int256 a, Int256 b) {
+    int overflow;
+    return add_int256_core(a, b, &overflow);
+}
+
+static inline Int256 sub_int256(Int256 a, Int256 b) {
+    b.sign = !b.sign;
+    return add_int256(a, b);
+}
+
+// Bitwise operations act on the magnitudes; the sign bits combine the same way
+static inline Int256 and_int256(Int256 a, Int256 b) {
+    Int256 result;
+    for (int i = 0; i < 4; i++) {
+        result.part[i] = a.part[i] & b.part[i];
+    }
+    result.sign = is_zero_int256(result) ? 0 : a.sign & b.sign;
+    return result;
+}
+
+static inline Int256 or_int256(Int256 a, Int256 b) {
+    Int256 result;
+    for (int i = 0; i < 4; i++) {
+        result.part[i] = a.part[i] | b.part[i];
+    }
+    result.sign = is_zero_int256(result) ? 0 : a.sign | b.sign;
+    return result;
+}
+
+static inline Int256 xor_int256(Int256 a, Int256 b) {
+    Int256 result;
+    for (int i = 0; i < 4; i++) {
+        result.part[i] = a.part[i] ^ b.part[i];
+    }
+    result.sign = is_zero_int256(result) ? 0 : a.sign ^ b.sign;
+    return result;
+}
+
+// Shifts the magnitude toward part[0]; bits past 256 are lost
+static inline Int256 shift_left_int256(Int256 a, int bits) {
+    if (bits <= 0) return a;
+    Int256 result = {{0, 0, 0, 0}, 0};
+    if (bits >= 256) return result;
+
+    int word_shift = bits / 64;
+    int bit_shift = bits % 64;
+    for (int i = 0; i + word_shift < 4; i++) {
+        uint64_t low_part = (bit_shift && i + word_shift + 1 < 4)
+                          ? a.part[i + word_shift + 1] >> (64 - bit_shift) : 0;
+        result.part[i] = (a.part[i + word_shift] << bit_shift) | low_part;
+    }
+    result.sign = is_zero_int256(result) ? 0 : a.sign;
+    return result;
+}
+
+// Shifts the magnitude toward part[3] (rounds toward zero)
+static inline Int256 shift_right_int256(Int256 a, int bits) {
+    if (bits <= 0) return a;
+    Int256 result = {{0, 0, 0, 0}, 0};
+    if (bits >= 256) return result;
+
+    int word_shift = bits / 64;
+    int bit_shift = bits % 64;
+    for (int i = word_shift; i < 4; i++) {
+        uint64_t high_part = (bit_shift && i > word_shift)
+                           ? a.part[i - word_shift - 1] << (64 - bit_shift) : 0;
+        result.part[i] = (a.part[i - word_shift] >> bit_shift) | high_part;
+    }
+    result.sign = is_zero_int256(result) ? 0 : a.sign;
+    return result;
+}
+
+// ==================== ARITHMETIC ====================
+//
+// The plain functions wrap silently. _checked returns a status and stores
+// the wrapped result in *out; _wrapping keeps the low 256 bits of the
+// magnitude; _saturating clamps to +/-(2^256 - 1).
+
+Int256 mul_int256(Int256 a, Int256 b);
+Int256 mul_lo_int256(Int256 a, Int256 b);
+Int256 sqr_int256(Int256 a);
+Int512 mul_int256_full(Int256 a, Int256 b);
+
+// Quotient truncated toward zero, remainder with the dividend's sign;
+// remainder may be NULL. Division by zero gives zero.
+Int256 divmod_int256(Int256 a, Int256 b, Int256* remainder);
+Int256 div_int256(Int256 a, Int256 b);
+Int256 mod_int256(Int256 a, Int256 b);
+
+Int256 pow_int256(Int256 base, unsigned int exp);
+Int256 factorial_int256(unsigned int n);
+
+// n! / (n-k)! and n! / (k! (n-k)!), both 0 for k > n. On overflow *out is
+// zero and INT256_ERR_OVERFLOW is returned.
+Int256Status falling_factorial_int256(unsigned int n, unsigned int k, Int256* out);
+Int256Status binomial_int256(unsigned int n, unsigned int k, Int256* out);
+
+Int256Status add_int256_checked(Int256 a, Int256 b, Int256* out);
+Int256 add_int256_wrapping(Int256 a, Int256 b);
+Int256 add_int256_saturating(Int256 a, Int256 b);
+Int256Status sub_int256_checked(Int256 a, Int256 b, Int256* out);
+Int256 sub_int256_wrapping(Int256 a, Int256 b);
+Int256 sub_int256_saturating(Int256 a, Int256 b);
+Int256Status mul_int256_checked(Int256 a, Int256 b, Int256* out);
+Int256 mul_int256_wrapping(Int256 a, Int256 b);
+Int256 mul_int256_saturating(Int256 a, Int256 b);
+Int256Status divmod_int256_checked(Int256 a, Int256 b, Int256* quotient, Int256* remainder);
+Int256Status div_int256_checked(Int256 a, Int256 b, Int256* out);
+Int256 div_int256_wrapping(Int256 a, Int256 b);
+Int256 div_int256_saturating(Int256 a, Int256 b);
+Int256Status mod_int256_checked(Int256 a, Int256 b, Int256* out);
+Int256 mod_int256_wrapping(Int256 a, Int256 b);
+Int256 mod_int256_saturating(Int256 a, Int256 b);
+Int256Status pow_int256_checked(Int256 base, unsigned int exp, Int256* out);
+Int256 pow_int256_wrapping(Int256 base, unsigned int exp);
+Int256 pow_int256_saturating(Int256 base, unsigned int exp);
+Int256Status factorial_int256_checked(unsigned int n, Int256* out);
+Int256 factorial_int256_wrapping(unsigned int n);
+Int256 factorial_int256_saturating(unsigned int n);
+
+// ==================== ROOTS AND LOGARITHMS ====================
+
+// floor(|a|^(1/n)). Odd roots keep the sign of a; even roots of negative
+// numbers and n == 0 return INT256_ERR_DOMAIN.
+Int256Status iroot_int256(Int256 a, unsigned int n, Int256* out);
+Int256Status isqrt_int256(Int256 a, Int256* out);
+Int256 icbrt_int256(Int256 a);
+
+// floor(log2 |a|) and floor(log10 |a|); -1 for zero
+int ilog2_int256(Int256 a);
+int ilog10_int256(Int256 a);
+
+// ==================== GCD AND MODULAR INVERSE ====================
+
+// gcd(|a|, |b|); gcd(0, 0) = 0
+Int256 gcd_int256(Int256 a, Int256 b);
+// lcm(|a|, |b|); INT256_ERR_OVERFLOW if it does not fit
+Int256Status lcm_int256(Int256 a, Int256 b, Int256* out);
+// Returns g = gcd(a, b) and sets x, y with a x + b y = g
+Int256 xgcd_int256(Int256 a, Int256 b, Int256* x, Int256* y);
+// a^-1 mod |m| in [0, |m|); INT256_ERR_DIV_BY_ZERO for m == 0 and
+// INT256_ERR_DOMAIN when a and m are not coprime
+Int256Status modinv_int256(Int256 a, Int256 m, Int256* out);
+
+// ==================== PRIMES AND FACTORING ====================
+
+// 1 if n is prime, 0 otherwise (negative n included). Exact below
+// 3.3 * 10^24; larger n get a Miller-Rabin test with 24 bases.
+int isprime_int256(Int256 n);
+// Miller-Rabin to base 2 and rounds - 1 more bases derived from n; 1 if n
+// is a strong probable prime
+int miller_rabin_int256(Int256 n, int rounds);
+// Trial division, then Pollard-Brent rho; returns out->count (0 for |n| < 2)
+int factor_int256(Int256 n, Int256Factors* out);
+
+// ==================== DIVISION BY AN INVARIANT DIVISOR ====================
+
+// Returns 0 on success, -1 if the divisor is zero
+int divider_init_int256(Int256Divider* dv, Int256 divisor);
+Int256 divider_divmod_int256(const Int256Divider* dv, Int256 a, Int256* remainder);
+Int256 divider_div_int256(const Int256Divider* dv, Int256 a);
+Int256 divider_mod_int256(const Int256Divider* dv, Int256 a);
+
+// ==================== MULTIPLY THEN DIVIDE ====================
+//
+// a * b / c from the full 512-bit product, rounded once. The quotient
+// must fit in 256 bits: otherwise INT256_ERR_OVERFLOW with the low 256
+// bits of its magnitude in *out. c == 0 gives INT256_ERR_DIV_BY_ZERO and
+// zero.
+
+Int256Status muldiv_int256(Int256 a, Int256 b, Int256 c, Int256Rounding rounding, Int256* out);
+// The same with c prepared by divider_init_int256
+Int256Status divider_muldiv_int256(const Int256Divider* dv, Int256 a, Int256 b,
+                                   Int256Rounding rounding, Int256* out);
+
+// ==================== FIXED POINT ====================
+//
+// Values are plain Int256 holding x * 10^scale, so addition, subtraction,
+// comparison and negation are the integer operations. Multiplication and
+// division go through muldiv_int256 and round with the context's mode.
+
+#define INT256_MAX_SCALE 77
+
+// Returns 0 on success, -1 if scale > INT256_MAX_SCALE
+int fixed_init_int256(Int256Fixed* fx, unsigned int scale, Int256Rounding rounding);
+// Parses [whitespace][sign]digits[.digits] like parse_int256 (decimal
+// only). Places beyond the scale are rounded; a value of 2^256 or more
+// units gives INT256_ERR_OVERFLOW.
+Int256Status parse_fixed_int256(const Int256Fixed* fx, const char* str, size_t len,
+                                Int256* out, size_t* consumed);
+// Writes n with exactly fx->scale places, e.g. "-1.500" at scale 3.
+// Returns the length written, or 0 with an empty string if it does not fit.
+size_t fixed_to_decimal_int256(const Int256Fixed* fx, Int256 n, char* buffer, size_t buffer_size);
+// a * b and a / b in the format; b == 0 gives INT256_ERR_DIV_BY_ZERO
+Int256Status mul_fixed_int256(const Int256Fixed* fx, Int256 a, Int256 b, Int256* out);
+Int256Status div_fixed_int256(const Int256Fixed* fx, Int256 a, Int256 b, Int256* out);
+
+// ==================== MODULAR ARITHMETIC ====================
+
+// Returns 0 on success, -1 if the modulus is zero. The modulus sign is ignored.
+int mont_init_int256(Int256Mont* ctx, Int256 modulus);
+Int256 mont_to_int256(const Int256Mont* ctx, Int256 a);
+Int256 mont_from_int256(const Int256Mont* ctx, Int256 a);
+Int256 mont_mul_int256(const Int256Mont* ctx, Int256 a, Int256 b);
+Int256 mont_sqr_int256(const Int256Mont* ctx, Int256 a);
+// a * b and a^2 mod m in [0, m) on ordinary values, for any modulus. These
+// skip Montgomery form even for odd m: the full product is reduced by long
+// division. For chains of products, convert once with mont_to_int256 and
+// use mont_mul_int256 / mont_sqr_int256.
+Int256 mulmod_int256(const Int256Mont* ctx, Int256 a, Int256 b);
+Int256 sqrmod_int256(const Int256Mont* ctx, Int256 a);
+// base^exp mod m. exp must be non-negative (its sign is ignored): for
+// base^-e, pass modinv_int256(base, m) and e.
+Int256 powmod_int256(const Int256Mont* ctx, Int256 base, Int256 exp);
+
+// ==================== ARRAY OPERATIONS ====================
+
+// Element-wise; each returns how many elements overflowed (those wrap).
+// dst may alias a or b.
+size_t add_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n);
+size_t sub_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n);
+size_t mul_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n);
+void cmp_int256_n(int* dst, const Int256* a, const Int256* b, size_t n);
+
+// ==================== EXPRESSIONS ====================
+//
+// Infix expressions over + - * / % & | ^ << >> and ** (power) with C
+// precedence; ** binds tighter than unary minus and groups right to left.
+// Operands are decimal or 0x hex literals and variables ([A-Za-z_][A-Za-z0-9_]*).
+// Compiling folds constant subexpressions; the result can be evaluated any
+// number of times against new variable values without re-parsing.
+
+typedef struct Int256Expr Int256Expr;
+
+#define INT256_EXPR_MAX_VARS 64
+
+// Returns NULL on a syntax error and describes it in err (err may be NULL)
+Int256Expr* expr_compile_int256(const char* text, size_t len, char* err, size_t err_size);
+void expr_free_int256(Int256Expr* expr);
+// Variables are numbered in order of first appearance
+int expr_var_count_int256(const Int256Expr* expr);
+const char* expr_var_name_int256(const Int256Expr* expr, int index);
+// vars[i] is the value of variable i. Overflow stores the wrapped result and
+// returns INT256_ERR_OVERFLOW; a zero divisor returns INT256_ERR_DIV_BY_ZERO.
+// Safe to call concurrently on the same compiled expression.
+Int256Status expr_eval_int256(const Int256Expr* expr, const Int256* vars, Int256* out);
+
+// ==================== RESULT CACHE ====================
+//
+// A bounded memo table for callers that repeat the same operations, keyed
+// on the operation and the operands' limbs. Entries past the capacity are
+// evicted with the CLOCK algorithm. A cache is not thread-safe; give each
+// thread its own.
+
+typedef struct Int256Cache Int256Cache;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;
+    size_t capacity;
+} Int256CacheStats;
+
+// Keeps up to capacity entries (at least 1, at most 2^28); returns NULL
+// if out of memory
+Int256Cache* cache_create_int256(size_t capacity);
+void cache_free_int256(Int256Cache* cache);
+// Drops every entry and zeroes the counters
+void cache_clear_int256(Int256Cache* cache);
+void cache_stats_int256(const Int256Cache* cache, Int256CacheStats* stats);
+
+// Same results as div/mod/pow_int256_checked and int256_to_decimal
+Int256Status cache_div_int256(Int256Cache* cache, Int256 a, Int256 b, Int256* out);
+Int256Status cache_mod_int256(Int256Cache* cache, Int256 a, Int256 b, Int256* out);
+Int256Status cache_pow_int256(Int256Cache* cache, Int256 base, unsigned int exp, Int256* out);
+size_t cache_to_decimal_int256(Int256Cache* cache, Int256 n, char* buffer, size_t buffer_size);
+
+// ==================== TWO'S COMPLEMENT 256-BIT TYPES ====================
+//
+// UInt256 is unsigned, SInt256 is signed two's complement; add, subtract
+// and multiply produce the same bits for both and wrap modulo 2^256 like
+// hardware integers. Limb order matches Int256 so conversions are copies.
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define CALC256_HAVE_ADDC 1
+#endif
+#endif
+
+// One step of a carry chain; compiles to adc where available
+static inline uint64_t addc_u64(uint64_t a, uint64_t b, unsigned char carry_in,
+                                unsigned char* carry_out) {
+#if defined(CALC256_HAVE_ADDC)
+    unsigned long long c;
+    unsigned long long r = __builtin_addcll(a, b, carry_in, &c);
+    *carry_out = (unsigned char)c;
+    return r;
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    unsigned long long r;
+    *carry_out = _addcarry_u64(carry_in, a, b, &r);
+    return r;
+#else
+    __uint128_t sum = (__uint128_t)a + b + carry_in;
+    *carry_out = (unsigned char)(sum >> 64);
+    return (uint64_t)sum;
+#endif
+}
+
+static inline uint64_t subb_u64(uint64_t a, uint64_t b, unsigned char borrow_in,
+                                unsigned char* borrow_out) {
+#if defined(CALC256_HAVE_ADDC)
+    unsigned long long c;
+    unsigned long long r = __builtin_subcll(a, b, borrow_in, &c);
+    *borrow_out = (unsigned char)c;
+    return r;
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    unsigned long long r;
+    *borrow_out = _subborrow_u64(borrow_in, a, b, &r);
+    return r;
+#else
+    __uint128_t diff = (__uint128_t)a - b - borrow_in;
+    *borrow_out = (unsigned char)((diff >> 64) & 1);
+    return (uint64_t)diff;
+#endif
+}
+
+static inline UInt256 add_uint256(UInt256 a, UInt256 b) {
+    UInt256 r;
+    unsigned char c = 0;
+    r.part[3] = addc_u64(a.part[3], b.part[3], c, &c);
+    r.part[2] = addc_u64(a.part[2], b.part[2], c, &c);
+    r.part[1] = addc_u64(a.part[1], b.part[1], c, &c);
+    r.part[0] = addc_u64(a.part[0], b.part[0], c, &c);
+    return r;
+}
+
+static inline UInt256 sub_uint256(UInt256 a, UInt256 b) {
+    UInt256 r;
+    unsigned char c = 0;
+    r.part[3] = subb_u64(a.part[3], b.part[3], c, &c);
+    r.part[2] = subb_u64(a.part[2], b.part[2], c, &c);
+    r.part[1] = subb_u64(a.part[1], b.part[1], c, &c);
+    r.part[0] = subb_u64(a.part[0], b.part[0], c, &c);
+    return r;
+}
+
+// Low 256 bits of the product
+UInt256 mul_uint256(UInt256 a, UInt256 b);
+
+static inline UInt256 not_uint256(UInt256 a) {
+    for (int i = 0; i < 4; i++) a.part[i] = ~a.part[i];
+    return a;
+}
+
+static inline UInt256 and_uint256(UInt256 a, UInt256 b) {
+    for (int i = 0; i < 4; i++) a.part[i] &= b.part[i];
+    return a;
+}
+
+static inline UInt256 or_uint256(UInt256 a, UInt256 b) {
+    for (int i = 0; i < 4; i++) a.part[i] |= b.part[i];
+    return a;
+}
+
+static inline UInt256 xor_uint256(UInt256 a, UInt256 b) {
+    for (int i = 0; i < 4; i++) a.part[i] ^= b.part[i];
+    return a;
+}
+
+// Shifts toward the most significant end; bits >= 256 give zero
+static inline UInt256 shl_uint256(UInt256 a, unsigned int bits) {
+    UInt256 r = {{0, 0, 0, 0}};
+    if (bits >= 256) return r;
+    unsigned int ws = bits / 64, bs = bits % 64;
+    for (unsigned int i = 0; i + ws < 4; i++) {
+        uint64_t lo = (i + ws + 1 < 4 && bs) ? a.part[i + ws + 1] >> (64 - bs) : 0;
+        r.part[i] = (a.part[i + ws] << bs) | lo;
+    }
+    return r;
+}
+
+// Logical shift toward the least significant end
+static inline UInt256 shr_uint256(UInt256 a, unsigned int bits) {
+    UInt256 r = {{0, 0, 0, 0}};
+    if (bits >= 256) return r;
+    unsigned int ws = bits / 64, bs = bits % 64;
+    for (unsigned int i = ws; i < 4; i++) {
+        uint64_t hi = (i > ws && bs) ? a.part[i - ws - 1] << (64 - bs) : 0;
+        r.part[i] = (a.part[i - ws] >> bs) | hi;
+    }
+    return r;
+}
+
+static inline int cmp_uint256(UInt256 a, UInt256 b) {
+    for (int i = 0; i < 4; i++) {
+        if (a.part[i] != b.part[i]) return a.part[i] < b.part[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static inline UInt256 sint256_bits(SInt256 a) {
+    UInt256 r;
+    memcpy(r.part, a.part, sizeof(r.part));
+    return r;
+}
+
+static inline SInt256 bits_sint256(UInt256 a) {
+    SInt256 r;
+    memcpy(r.part, a.part, sizeof(r.part));
+    return r;
+}
+
+static inline SInt256 add_sint256(SInt256 a, SInt256 b) {
+    return bits_sint256(add_uint256(sint256_bits(a), sint256_bits(b)));
+}
+
+static inline SInt256 sub_sint256(SInt256 a, SInt256 b) {
+    return bits_sint256(sub_uint256(sint256_bits(a), sint256_bits(b)));
+}
+
+static inline SInt256 mul_sint256(SInt256 a, SInt256 b) {
+    return bits_sint256(mul_uint256(sint256_bits(a), sint256_bits(b)));
+}
+
+static inline SInt256 neg_sint256(SInt256 a) {
+    UInt256 zero = {{0, 0, 0, 0}};
+    return bits_sint256(sub_uint256(zero, sint256_bits(a)));
+}
+
+static inline int is_negative_sint256(SInt256 a) {
+    return (int)(a.part[0] >> 63);
+}
+
+// Arithmetic shift: vacated bits copy the sign bit
+static inline SInt256 sar_sint256(SInt256 a, unsigned int bits) {
+    uint64_t fill = 0 - (a.part[0] >> 63);
+    if (bits >= 256) {
+        SInt256 r = {{fill, fill, fill, fill}};
+        return r;
+    }
+    UInt256 r = shr_uint256(sint256_bits(a), bits);
+    if (bits > 0) {
+        UInt256 mask = shl_uint256((UInt256){{fill, fill, fill, fill}}, 256 - bits);
+        r = or_uint256(r, mask);
+    }
+    return bits_sint256(r);
+}
+
+static inline int cmp_sint256(SInt256 a, SInt256 b) {
+    // Flipping the sign bits turns signed order into unsigned order
+    UInt256 x = sint256_bits(a), y = sint256_bits(b);
+    x.part[0] ^= 0x8000000000000000ULL;
+    y.part[0] ^= 0x8000000000000000ULL;
+    return cmp_uint256(x, y);
+}
+
+UInt256 int256_to_uint256(Int256 a);
+Int256 uint256_to_int256(UInt256 a);
+// Returns 1 (and the value modulo 2^256) when a is outside
+// [-2^255, 2^255 - 1], otherwise 0
+int int256_to_sint256(Int256 a, SInt256* out);
+Int256 sint256_to_int256(SInt256 a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CALC256_H
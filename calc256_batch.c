@@ -0,0 +1,1140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "calc256.h"
+#include "calc256_batch.h"
+#include "calc256_stats.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// ==================== BATCH MODE ====================
+//
+// calc256 --batch [--hex] < ops.txt
+// calc256 --batch --expr "(a*b + c) % m" < rows.txt
+// calc256 --batch --scale 18 < ledger.txt
+//
+// Reads one operation per line ("mul 0x1f 123", "fact 40", "neg -5") and
+// writes one result per line, with no prompts. With --expr each line instead
+// holds the values of the expression's variables, in order of first
+// appearance. With --scale numbers are fixed-point decimals ("mul 1.5
+// 2.25") and results print with exactly that many places. Blank lines and
+// lines starting with '#' are skipped. Output goes through a large stdio buffer
+// so a whole run costs a handful of write() calls.
+
+typedef enum {
+    BOP_ADD, BOP_SUB, BOP_MUL, BOP_DIV, BOP_MOD,
+    BOP_AND, BOP_OR, BOP_XOR, BOP_SHL, BOP_SHR,
+    BOP_POW, BOP_FACT, BOP_CMP, BOP_NEG, BOP_ABS,
+    BOP_MULMOD, BOP_POWMOD, BOP_BINOM, BOP_FALLING,
+    BOP_SQRT, BOP_CBRT, BOP_ROOT, BOP_LOG2, BOP_LOG10,
+    BOP_GCD, BOP_LCM, BOP_MODINV, BOP_ISPRIME, BOP_FACTOR,
+    BOP_MULDIV
+} BatchOp;
+
+// Operand kinds: 'n' = Int256, 'u' = unsigned count
+static const struct {
+    const char* name;
+    BatchOp op;
+    const char* args;
+} batch_ops[] = {
+    {"add", BOP_ADD, "nn"}, {"sub", BOP_SUB, "nn"}, {"mul", BOP_MUL, "nn"},
+    {"div", BOP_DIV, "nn"}, {"mod", BOP_MOD, "nn"}, {"and", BOP_AND, "nn"},
+    {"or",  BOP_OR,  "nn"}, {"xor", BOP_XOR, "nn"}, {"shl", BOP_SHL, "nu"},
+    {"shr", BOP_SHR, "nu"}, {"pow", BOP_POW, "nu"}, {"fact", BOP_FACT, "u"},
+    {"cmp", BOP_CMP, "nn"}, {"neg", BOP_NEG, "n"},  {"abs", BOP_ABS, "n"},
+    {"mulmod", BOP_MULMOD, "nnn"}, {"powmod", BOP_POWMOD, "nnn"},
+    {"binom", BOP_BINOM, "uu"}, {"falling", BOP_FALLING, "uu"},
+    {"sqrt", BOP_SQRT, "n"}, {"cbrt", BOP_CBRT, "n"}, {"root", BOP_ROOT, "nu"},
+    {"log2", BOP_LOG2, "n"}, {"log10", BOP_LOG10, "n"},
+    {"gcd", BOP_GCD, "nn"}, {"lcm", BOP_LCM, "nn"}, {"modinv", BOP_MODINV, "nn"},
+    {"isprime", BOP_ISPRIME, "n"}, {"factor", BOP_FACTOR, "n"},
+    {"muldiv", BOP_MULDIV, "nnn"},
+};
+
+#define BATCH_OP_COUNT (sizeof(batch_ops) / sizeof(batch_ops[0]))
+#define BATCH_OP_EXPR ((int)BATCH_OP_COUNT)   // statistics slot for --expr lines
+
+const char* batch_op_name(int index) {
+    if (index >= 0 && index < (int)BATCH_OP_COUNT) return batch_ops[index].name;
+    return index == BATCH_OP_EXPR ? "expr" : NULL;
+}
+
+// Whether op means the same on fixed-point values: the rest would act on
+// the scaled integers
+static int batch_fixed_op(BatchOp op) {
+    switch (op) {
+        case BOP_ADD: case BOP_SUB: case BOP_MUL: case BOP_DIV: case BOP_MOD:
+        case BOP_CMP: case BOP_NEG: case BOP_ABS: case BOP_MULDIV:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int batch_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Returns the start of the next token and stores its length, or NULL at end
+static const char* batch_next_token(const char** cursor, const char* end, size_t* len) {
+    const char* p = *cursor;
+    while (p < end && batch_is_space(*p)) p++;
+    if (p == end) {
+        *cursor = p;
+        return NULL;
+    }
+    const char* start = p;
+    while (p < end && !batch_is_space(*p)) p++;
+    *len = (size_t)(p - start);
+    *cursor = p;
+    return start;
+}
+
+static int batch_parse_count(const char* s, size_t len, unsigned int* out) {
+    uint64_t value = 0;
+    if (len == 0 || len > 10) return 0;
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return 0;
+        value = value * 10 + (uint64_t)(s[i] - '0');
+    }
+    if (value > INT_MAX) return 0;
+    *out = (unsigned int)value;
+    return 1;
+}
+
+static Int256Status batch_parse_value(const char* tok, size_t tok_len, const BatchOptions* opts,
+                                      Int256* value) {
+    if (opts->fixed) return parse_fixed_int256(opts->fixed, tok, tok_len, value, NULL);
+    return parse_int256(tok, tok_len, value, NULL);
+}
+
+// Parses a number operand. Returns 0 on success, otherwise the length of
+// the error line written to out.
+static size_t batch_parse_number(const char* tok, size_t tok_len, const BatchOptions* opts,
+                                 Int256* value, char* out, size_t out_size) {
+    Int256Status status = batch_parse_value(tok, tok_len, opts, value);
+    if (status == INT256_ERR_OVERFLOW) {
+        return (size_t)snprintf(out, out_size, "error: number exceeds 256 bits\n");
+    }
+    if (status != INT256_OK) {
+        return (size_t)snprintf(out, out_size, "error: invalid number '%.*s'\n",
+                                (int)(tok_len > 80 ? 80 : tok_len), tok);
+    }
+    return 0;
+}
+
+// Writes the result line for a finished operation
+static size_t batch_format_result(Int256Status status, Int256 result, const BatchOptions* opts,
+                                  Int256Cache* cache, char* out, size_t out_size) {
+    if (status == INT256_ERR_DIV_BY_ZERO) {
+        return (size_t)snprintf(out, out_size, "error: division by zero\n");
+    }
+    if (status == INT256_ERR_OVERFLOW) {
+        return (size_t)snprintf(out, out_size, "error: overflow\n");
+    }
+    if (status == INT256_ERR_DOMAIN) {
+        return (size_t)snprintf(out, out_size, "error: argument out of domain\n");
+    }
+    if (status != INT256_OK) {
+        return (size_t)snprintf(out, out_size, "error: invalid number\n");
+    }
+    
+    size_t written;
+    if (opts->hex_output) {
+        int256_to_hex(result, out, out_size - 1);
+        written = strlen(out);
+    } else if (opts->fixed) {
+        written = fixed_to_decimal_int256(opts->fixed, result, out, out_size - 1);
+    } else if (cache) {
+        written = cache_to_decimal_int256(cache, result, out, out_size - 1);
+    } else {
+        written = int256_to_decimal(result, out, out_size - 1);
+    }
+    out[written++] = '\n';
+    return written;
+}
+
+// Writes "p^e q ..." for the factorization of n, with a leading -1 for
+// negative n and cofactors that could not be split in parentheses
+static size_t batch_format_factors(Int256 n, int hex_output, char* out, size_t out_size) {
+    if (is_zero_int256(n)) {
+        return (size_t)snprintf(out, out_size, "error: argument out of domain\n");
+    }
+    Int256Factors f;
+    int count = factor_int256(n, &f);
+    size_t len = 0;
+    if (n.sign) len += (size_t)snprintf(out, out_size, count ? "-1 " : "-1");
+    else if (count == 0) len += (size_t)snprintf(out, out_size, "1");
+    
+    char digits[80];
+    for (int i = 0; i < count && len < out_size; i++) {
+        if (hex_output) {
+            int256_to_hex(f.factor[i], digits, sizeof(digits));
+        } else {
+            int256_to_decimal(f.factor[i], digits, sizeof(digits));
+        }
+        int composite = i >= count - f.composite;
+        len += (size_t)snprintf(out + len, out_size - len, "%s%s%s", composite ? "(" : "",
+                                digits, composite ? ")" : "");
+        if (f.exponent[i] > 1 && len < out_size) {
+            len += (size_t)snprintf(out + len, out_size - len, "^%u", f.exponent[i]);
+        }
+        if (i + 1 < count && len < out_size) out[len++] = ' ';
+    }
+    if (len > out_size - 1) len = out_size - 1;
+    out[len++] = '\n';
+    return len;
+}
+
+// A line of variable values for opts->expr
+static size_t batch_eval_expr(const char* cursor, const char* end, const BatchOptions* opts,
+                              char* out, size_t out_size) {
+    Int256 vars[INT256_EXPR_MAX_VARS];
+    int var_count = expr_var_count_int256(opts->expr);
+    size_t tok_len, err;
+    
+    STATS_CLOCK(t);
+    for (int k = 0; k < var_count; k++) {
+        const char* tok = batch_next_token(&cursor, end, &tok_len);
+        if (tok == NULL) {
+            STATS_INPUT_ERROR();
+            return (size_t)snprintf(out, out_size, "error: missing value for '%s'\n",
+                                    expr_var_name_int256(opts->expr, k));
+        }
+        if ((err = batch_parse_number(tok, tok_len, opts, &vars[k], out, out_size)) != 0) {
+            STATS_INPUT_ERROR();
+            return err;
+        }
+    }
+    if (batch_next_token(&cursor, end, &tok_len) != NULL) {
+        STATS_INPUT_ERROR();
+        return (size_t)snprintf(out, out_size, "error: too many values\n");
+    }
+    STATS_STAGE(STAGE_PARSE, t);
+    STATS_REQUEST(BATCH_OP_EXPR);
+    
+    Int256 result;
+    Int256Status status = expr_eval_int256(opts->expr, vars, &result);
+    STATS_STAGE(STAGE_COMPUTE, t);
+    STATS_RESULT(status);
+    size_t written = batch_format_result(status, result, opts, NULL, out, out_size);
+    STATS_STAGE(STAGE_FORMAT, t);
+    return written;
+}
+
+// Index of the operation called name in batch_ops, or -1
+static int batch_find_op(const char* name, size_t len) {
+    for (size_t i = 0; i < BATCH_OP_COUNT; i++) {
+        if (strlen(batch_ops[i].name) == len && memcmp(batch_ops[i].name, name, len) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// Runs an operation on parsed operands: num holds the numbers and count
+// the counts, in the order they appear in batch_ops[].args. BOP_FACTOR has
+// no single result and is left to the caller. With opts->fixed, mul and
+// div are fixed-point; muldiv needs no change as the scales cancel.
+static Int256Status batch_apply(BatchOp op, const Int256* num, const unsigned int* count,
+                                const BatchOptions* opts, Int256Cache* cache, Int256* out) {
+    Int256 a = num[0], b = num[1], result;
+    Int256Mont mont;
+    Int256Status status = INT256_OK;
+    switch (op) {
+        case BOP_ADD: status = add_int256_checked(a, b, &result); break;
+        case BOP_SUB: status = sub_int256_checked(a, b, &result); break;
+        case BOP_MUL:
+            status = opts->fixed ? mul_fixed_int256(opts->fixed, a, b, &result)
+                                 : mul_int256_checked(a, b, &result);
+            break;
+        case BOP_DIV:
+            if (opts->fixed) {
+                status = div_fixed_int256(opts->fixed, a, b, &result);
+            } else {
+                status = cache ? cache_div_int256(cache, a, b, &result)
+                               : div_int256_checked(a, b, &result);
+            }
+            break;
+        case BOP_MULDIV: status = muldiv_int256(a, b, num[2], opts->rounding, &result); break;
+        case BOP_MOD:
+            status = cache ? cache_mod_int256(cache, a, b, &result)
+                           : mod_int256_checked(a, b, &result);
+            break;
+        case BOP_AND: result = and_int256(a, b); break;
+        case BOP_OR:  result = or_int256(a, b); break;
+        case BOP_XOR: result = xor_int256(a, b); break;
+        case BOP_SHL: result = shift_left_int256(a, (int)count[0]); break;
+        case BOP_SHR: result = shift_right_int256(a, (int)count[0]); break;
+        case BOP_POW:
+            status = cache ? cache_pow_int256(cache, a, count[0], &result)
+                           : pow_int256_checked(a, count[0], &result);
+            break;
+        case BOP_FACT: status = factorial_int256_checked(count[0], &result); break;
+        case BOP_BINOM: status = binomial_int256(count[0], count[1], &result); break;
+        case BOP_FALLING: status = falling_factorial_int256(count[0], count[1], &result); break;
+        case BOP_SQRT: status = isqrt_int256(a, &result); break;
+        case BOP_CBRT: result = icbrt_int256(a); break;
+        case BOP_ROOT: status = iroot_int256(a, count[0], &result); break;
+        case BOP_GCD: result = gcd_int256(a, b); break;
+        case BOP_LCM: status = lcm_int256(a, b, &result); break;
+        case BOP_MODINV: status = modinv_int256(a, b, &result); break;
+        case BOP_LOG2:
+        case BOP_LOG10: {
+            int log = op == BOP_LOG2 ? ilog2_int256(a) : ilog10_int256(a);
+            if (log < 0) status = INT256_ERR_DOMAIN;
+            result = (Int256){{0, 0, 0, (uint64_t)(log < 0 ? 0 : log)}, 0};
+            break;
+        }
+        case BOP_CMP: {
+            int c = cmp_int256(a, b);
+            result = (Int256){{0, 0, 0, (uint64_t)(c != 0)}, c < 0};
+            break;
+        }
+        case BOP_ISPRIME: result = (Int256){{0, 0, 0, (uint64_t)isprime_int256(a)}, 0}; break;
+        case BOP_NEG: result = neg_int256(a); break;
+        case BOP_ABS: result = abs_int256(a); break;
+        case BOP_MULMOD:
+        case BOP_POWMOD:
+            if (mont_init_int256(&mont, num[2]) != 0) {
+                status = INT256_ERR_DIV_BY_ZERO;
+                result = (Int256){{0, 0, 0, 0}, 0};
+                break;
+            }
+            if (op == BOP_POWMOD && b.sign) {
+                // a^-e = (a^-1)^e; DOMAIN when a has no inverse
+                status = modinv_int256(a, num[2], &a);
+                if (status != INT256_OK) {
+                    result = (Int256){{0, 0, 0, 0}, 0};
+                    break;
+                }
+                b.sign = 0;
+            }
+            result = op == BOP_MULMOD ? mulmod_int256(&mont, a, b) : powmod_int256(&mont, a, b);
+            break;
+        default: result = a; break;
+    }
+    *out = result;
+    return status;
+}
+
+// Reads the operands described by args (see batch_ops) from [cursor, end).
+// Returns 0 on success, otherwise the length of the error line written to out.
+static size_t batch_parse_operands(const char* cursor, const char* end, const char* args,
+                                   const BatchOptions* opts, Int256* num, unsigned int* count,
+                                   char* out, size_t out_size) {
+    int num_count = 0, count_count = 0;
+    size_t tok_len;
+    for (int k = 0; args[k]; k++) {
+        const char* tok = batch_next_token(&cursor, end, &tok_len);
+        if (tok == NULL) {
+            return (size_t)snprintf(out, out_size, "error: missing operand\n");
+        }
+        if (args[k] == 'n') {
+            size_t err = batch_parse_number(tok, tok_len, opts, &num[num_count++], out, out_size);
+            if (err) return err;
+        } else if (!batch_parse_count(tok, tok_len, &count[count_count++])) {
+            return (size_t)snprintf(out, out_size, "error: invalid count '%.*s'\n",
+                                    (int)(tok_len > 80 ? 80 : tok_len), tok);
+        }
+    }
+    if (batch_next_token(&cursor, end, &tok_len) != NULL) {
+        return (size_t)snprintf(out, out_size, "error: too many operands\n");
+    }
+    return 0;
+}
+
+size_t batch_eval_line(const char* line, size_t len, const BatchOptions* opts,
+                       Int256Cache* cache, char* out, size_t out_size) {
+    STATS_CLOCK(t);
+    const char* cursor = line;
+    const char* end = line + len;
+    size_t tok_len;
+    const char* tok = batch_next_token(&cursor, end, &tok_len);
+    
+    if (tok == NULL || tok[0] == '#') return 0;
+    if (opts->expr) return batch_eval_expr(line, end, opts, out, out_size);
+    
+    int op_index = batch_find_op(tok, tok_len);
+    if (op_index < 0) {
+        STATS_INPUT_ERROR();
+        return (size_t)snprintf(out, out_size, "error: unknown operation '%.*s'\n",
+                                (int)(tok_len > 32 ? 32 : tok_len), tok);
+    }
+    
+    Int256 num[3] = {{{0, 0, 0, 0}, 0}, {{0, 0, 0, 0}, 0}, {{0, 0, 0, 0}, 0}};
+    unsigned int count[2] = {0, 0};
+    if (opts->fixed && !batch_fixed_op(batch_ops[op_index].op)) {
+        STATS_INPUT_ERROR();
+        return (size_t)snprintf(out, out_size, "error: '%s' does not take fixed-point operands\n",
+                                batch_ops[op_index].name);
+    }
+    size_t err = batch_parse_operands(cursor, end, batch_ops[op_index].args, opts, num, count,
+                                      out, out_size);
+    if (err) {
+        STATS_INPUT_ERROR();
+        return err;
+    }
+    STATS_STAGE(STAGE_PARSE, t);
+    STATS_REQUEST(op_index);
+    
+    BatchOp op = batch_ops[op_index].op;
+    if (op == BOP_FACTOR) {
+        size_t written = batch_format_factors(num[0], opts->hex_output, out, out_size);
+        STATS_STAGE(STAGE_COMPUTE, t);
+        STATS_RESULT(is_zero_int256(num[0]) ? INT256_ERR_DOMAIN : INT256_OK);
+        return written;
+    }
+    if ((op == BOP_MULMOD || op == BOP_POWMOD) && is_zero_int256(num[2])) {
+        STATS_RESULT(INT256_ERR_DIV_BY_ZERO);
+        return (size_t)snprintf(out, out_size, "error: zero modulus\n");
+    }
+    
+    Int256 result;
+    Int256Status status = batch_apply(op, num, count, opts, cache, &result);
+    STATS_STAGE(STAGE_COMPUTE, t);
+    STATS_RESULT(status);
+    size_t written;
+    if (op == BOP_CMP || op == BOP_ISPRIME) {
+        written = (size_t)snprintf(out, out_size, "%s%d\n", result.sign ? "-" : "", (int)result.part[3]);
+    } else {
+        written = batch_format_result(status, result, opts, cache, out, out_size);
+    }
+    STATS_STAGE(STAGE_FORMAT, t);
+    return written;
+}
+
+// Next '\n' in [p, end), or end if there is none. Lines are short, so an
+// inline 16-byte compare beats a memchr call per line.
+static inline const char* batch_find_newline(const char* p, const char* end) {
+#ifdef __SSE2__
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)p);
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, nl));
+        if (mask) return p + __builtin_ctz((unsigned int)mask);
+    }
+#endif
+    while (p < end && *p != '\n') p++;
+    return p;
+}
+
+// Evaluates every line in [p, end), writing results to out
+static void batch_eval_span(const char* p, const char* end, const BatchOptions* opts,
+                            Int256Cache* cache, FILE* out) {
+    char result[BATCH_LINE_MAX];
+    while (p < end) {
+        const char* nl = batch_find_newline(p, end);
+        size_t n = batch_eval_line(p, (size_t)(nl - p), opts, cache, result, sizeof(result));
+        if (n > 0) fwrite(result, 1, n, out);
+        p = nl < end ? nl + 1 : end;
+    }
+}
+
+// ==================== RESULT CACHE ====================
+//
+// calc256 --batch --cache N
+//
+// Every thread that evaluates lines owns a cache of N entries, so lookups
+// take no locks. The counters are summed when the run ends and reported on
+// stderr.
+
+// NULL when caching is off, or (with a warning) when out of memory
+Int256Cache* batch_cache_open(const BatchOptions* opts) {
+    if (opts->cache_size == 0) return NULL;
+    Int256Cache* cache = cache_create_int256(opts->cache_size);
+    if (cache == NULL) fprintf(stderr, "calc256: no memory for --cache, running without\n");
+    return cache;
+}
+
+// Adds the counters of cache to total and frees it
+void batch_cache_close(Int256Cache* cache, Int256CacheStats* total) {
+    if (cache == NULL) return;
+    Int256CacheStats s;
+    cache_stats_int256(cache, &s);
+    total->hits += s.hits;
+    total->misses += s.misses;
+    total->evictions += s.evictions;
+    total->entries += s.entries;
+    total->capacity += s.capacity;
+    cache_free_int256(cache);
+}
+
+void batch_cache_report(const BatchOptions* opts, const Int256CacheStats* total) {
+    if (opts->cache_size == 0) return;
+    uint64_t lookups = total->hits + total->misses;
+    fprintf(stderr, "calc256: cache: %llu hits, %llu misses, %llu evictions (%.1f%% hit rate)\n",
+            (unsigned long long)total->hits, (unsigned long long)total->misses,
+            (unsigned long long)total->evictions,
+            lookups ? 100.0 * (double)total->hits / (double)lookups : 0.0);
+}
+
+// ==================== PARALLEL BATCH MODE ====================
+//
+// calc256 --batch --threads N
+//
+// The main thread cuts the input into chunks of whole lines and deals them
+// out to per-worker deques; a worker whose deque is empty steals from the
+// back of another's. Every chunk collects its results in its own buffer
+// and the main thread writes the buffers in input order, so the output is
+// byte-for-byte the same as a single-threaded run.
+
+#define BATCH_CHUNK_SIZE (1 << 20)
+#define BATCH_CHUNKS_PER_THREAD 4   // chunks in flight per worker
+
+typedef struct {
+    const char* data;          // lines to evaluate: in, or a slice of a mapped file
+    size_t len;
+    char* in;                  // copy of stream input
+    size_t in_len, in_cap;
+    char* out;
+    size_t out_len, out_cap;
+    int done;                  // guarded by BatchPool.lock
+    int failed;                // out of memory while growing out
+} BatchChunk;
+
+typedef struct {
+    BatchChunk** slot;         // ring buffer
+    size_t head, count, cap;
+    pthread_mutex_t lock;
+} ChunkDeque;
+
+typedef struct {
+    ChunkDeque* deques;
+    int workers;
+    const BatchOptions* opts;
+    pthread_mutex_t lock;      // guards queued, stop and BatchChunk.done
+    pthread_cond_t work_ready;
+    pthread_cond_t chunk_done;
+    int queued;                // chunks pushed but not yet claimed
+    int stop;
+} BatchPool;
+
+typedef struct {
+    BatchPool* pool;
+    int index;
+    Int256CacheStats cache_stats;   // filled in when the worker exits
+} BatchWorker;
+
+typedef struct {
+    FILE* in;                  // stream input, read through buf
+    char* buf;
+    size_t filled;
+    int eof;
+    const char* map;           // or a mapped file, sliced in place
+    size_t map_len, map_pos;
+} BatchSource;
+
+static void deque_push_back(ChunkDeque* d, BatchChunk* c) {
+    pthread_mutex_lock(&d->lock);
+    d->slot[(d->head + d->count) % d->cap] = c;
+    d->count++;
+    pthread_mutex_unlock(&d->lock);
+}
+
+// The owner takes the oldest chunk, thieves the newest
+static BatchChunk* deque_pop(ChunkDeque* d, int front) {
+    BatchChunk* c = NULL;
+    pthread_mutex_lock(&d->lock);
+    if (d->count > 0) {
+        if (front) {
+            c = d->slot[d->head];
+            d->head = (d->head + 1) % d->cap;
+        } else {
+            c = d->slot[(d->head + d->count - 1) % d->cap];
+        }
+        d->count--;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return c;
+}
+
+static void batch_eval_chunk(BatchChunk* c, const BatchOptions* opts, Int256Cache* cache) {
+    const char* p = c->data;
+    const char* end = c->data + c->len;
+    c->out_len = 0;
+    c->failed = 0;
+    while (p < end) {
+        const char* nl = batch_find_newline(p, end);
+        if (c->out_cap - c->out_len < BATCH_LINE_MAX) {
+            size_t cap = c->out_cap ? 2 * c->out_cap : BATCH_CHUNK_SIZE;
+            char* grown = realloc(c->out, cap);
+            if (grown == NULL) {
+                c->failed = 1;
+                return;
+            }
+            c->out = grown;
+            c->out_cap = cap;
+        }
+        c->out_len += batch_eval_line(p, (size_t)(nl - p), opts, cache, c->out + c->out_len,
+                                      BATCH_LINE_MAX);
+        p = nl < end ? nl + 1 : end;
+    }
+}
+
+static void* batch_worker(void* arg) {
+    BatchWorker* self = arg;
+    BatchPool* pool = self->pool;
+    Int256Cache* cache = batch_cache_open(pool->opts);
+    
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->queued == 0 && !pool->stop) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->queued == 0) {
+            pthread_mutex_unlock(&pool->lock);
+            batch_cache_close(cache, &self->cache_stats);
+            return NULL;
+        }
+        pool->queued--;
+        pthread_mutex_unlock(&pool->lock);
+        
+        // A chunk is reserved for us in some deque: own first, then steal
+        BatchChunk* c = deque_pop(&pool->deques[self->index], 1);
+        for (int k = 1; c == NULL; k++) {
+            c = deque_pop(&pool->deques[(self->index + k) % pool->workers], 0);
+        }
+        batch_eval_chunk(c, pool->opts, cache);
+        
+        pthread_mutex_lock(&pool->lock);
+        c->done = 1;
+        pthread_cond_broadcast(&pool->chunk_done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+// Points c at the next run of whole lines. A mapped file is sliced in
+// place; stream input is moved from the read buffer (BATCH_CHUNK_SIZE
+// bytes) into c->in, taking a line longer than the buffer in pieces.
+// Returns 0 once the input is exhausted, -1 if out of memory.
+static int batch_next_chunk(BatchSource* src, BatchChunk* c) {
+    if (src->map) {
+        const char* end = src->map + src->map_len;
+        const char* p = src->map + src->map_pos;
+        if (p == end) return 0;
+        const char* stop = end;
+        if ((size_t)(end - p) > BATCH_CHUNK_SIZE) {
+            stop = batch_find_newline(p + BATCH_CHUNK_SIZE, end);
+            if (stop < end) stop++;
+        }
+        c->data = p;
+        c->len = (size_t)(stop - p);
+        src->map_pos = (size_t)(stop - src->map);
+        return 1;
+    }
+    
+    FILE* in = src->in;
+    char* buf = src->buf;
+    size_t* filled = &src->filled;
+    int* eof = &src->eof;
+    c->in_len = 0;
+    c->data = c->in;
+    c->len = 0;
+    for (;;) {
+        if (!*eof && *filled < BATCH_CHUNK_SIZE) {
+            *filled += fread(buf + *filled, 1, BATCH_CHUNK_SIZE - *filled, in);
+            if (*filled < BATCH_CHUNK_SIZE) *eof = 1;
+        }
+        if (*filled == 0) break;
+        
+        size_t take = *filled;
+        while (take > 0 && buf[take - 1] != '\n') take--;
+        int complete = take > 0 || *eof;
+        if (take == 0) take = *filled;
+        
+        if (c->in_cap - c->in_len < take) {
+            size_t cap = c->in_cap ? c->in_cap : BATCH_CHUNK_SIZE;
+            while (cap - c->in_len < take) cap *= 2;
+            char* grown = realloc(c->in, cap);
+            if (grown == NULL) return -1;
+            c->in = grown;
+            c->in_cap = cap;
+        }
+        memcpy(c->in + c->in_len, buf, take);
+        c->in_len += take;
+        memmove(buf, buf + take, *filled - take);
+        *filled -= take;
+        if (complete) break;
+    }
+    c->data = c->in;
+    c->len = c->in_len;
+    return c->len > 0;
+}
+
+int batch_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) return 1;
+    return n > BATCH_MAX_THREADS ? BATCH_MAX_THREADS : (int)n;
+}
+
+static int run_batch_parallel(BatchSource* src, FILE* out, const BatchOptions* opts) {
+    int workers = opts->threads;
+    size_t slots = (size_t)workers * BATCH_CHUNKS_PER_THREAD;
+    BatchPool pool;
+    memset(&pool, 0, sizeof(pool));
+    pool.opts = opts;
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.work_ready, NULL);
+    pthread_cond_init(&pool.chunk_done, NULL);
+    
+    BatchChunk* chunks = calloc(slots, sizeof(BatchChunk));
+    BatchChunk** rings = calloc(slots * (size_t)workers, sizeof(BatchChunk*));
+    pool.deques = calloc((size_t)workers, sizeof(ChunkDeque));
+    BatchWorker* args = calloc((size_t)workers, sizeof(BatchWorker));
+    pthread_t* threads = calloc((size_t)workers, sizeof(pthread_t));
+    int rc = 0;
+    
+    if (src->map == NULL && (src->buf = malloc(BATCH_CHUNK_SIZE)) == NULL) rc = 1;
+    if (rc != 0 || !chunks || !rings || !pool.deques || !args || !threads) {
+        fprintf(stderr, "calc256: out of memory\n");
+        rc = 1;
+        workers = 0;
+    }
+    for (int w = 0; w < workers; w++) {
+        pool.deques[w].slot = rings + (size_t)w * slots;
+        pool.deques[w].cap = slots;
+        pthread_mutex_init(&pool.deques[w].lock, NULL);
+        args[w].pool = &pool;
+        args[w].index = w;
+        if (pthread_create(&threads[w], NULL, batch_worker, &args[w]) != 0) {
+            fprintf(stderr, "calc256: cannot start worker thread\n");
+            rc = 1;
+            workers = w;
+            break;
+        }
+    }
+    pool.workers = workers;
+    
+    size_t next_read = 0, next_write = 0;
+    int input_done = rc != 0;
+    for (;;) {
+        if (!input_done && next_read - next_write < slots) {
+            BatchChunk* c = &chunks[next_read % slots];
+            int got = batch_next_chunk(src, c);
+            if (got > 0) {
+                c->done = 0;
+                deque_push_back(&pool.deques[next_read % (size_t)workers], c);
+                pthread_mutex_lock(&pool.lock);
+                pool.queued++;
+                pthread_cond_signal(&pool.work_ready);
+                pthread_mutex_unlock(&pool.lock);
+                next_read++;
+                continue;
+            }
+            if (got < 0) {
+                fprintf(stderr, "calc256: out of memory\n");
+                rc = 1;
+            }
+            input_done = 1;
+        }
+        if (next_write == next_read) break;
+        
+        // Oldest chunk in flight: wait for it, then write it out
+        BatchChunk* c = &chunks[next_write % slots];
+        pthread_mutex_lock(&pool.lock);
+        while (!c->done) pthread_cond_wait(&pool.chunk_done, &pool.lock);
+        pthread_mutex_unlock(&pool.lock);
+        if (c->failed && rc == 0) {
+            fprintf(stderr, "calc256: out of memory\n");
+            rc = 1;
+        }
+        if (rc == 0) fwrite(c->out, 1, c->out_len, out);
+        next_write++;
+        // Stop reading after an error but drain the chunks in flight
+        if (rc != 0) input_done = 1;
+    }
+    
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 1;
+    pthread_cond_broadcast(&pool.work_ready);
+    pthread_mutex_unlock(&pool.lock);
+    Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+    for (int w = 0; w < workers; w++) {
+        pthread_join(threads[w], NULL);
+        pthread_mutex_destroy(&pool.deques[w].lock);
+        cache_total.hits += args[w].cache_stats.hits;
+        cache_total.misses += args[w].cache_stats.misses;
+        cache_total.evictions += args[w].cache_stats.evictions;
+    }
+    batch_cache_report(opts, &cache_total);
+    
+    for (size_t i = 0; chunks && i < slots; i++) {
+        free(chunks[i].in);
+        free(chunks[i].out);
+    }
+    free(chunks);
+    free(rings);
+    free(pool.deques);
+    free(args);
+    free(threads);
+    free(src->buf);
+    pthread_cond_destroy(&pool.chunk_done);
+    pthread_cond_destroy(&pool.work_ready);
+    pthread_mutex_destroy(&pool.lock);
+    
+    if (fflush(out) != 0 || (src->in && ferror(src->in))) {
+        if (rc == 0) fprintf(stderr, "calc256: I/O error\n");
+        rc = 1;
+    }
+    return rc;
+}
+
+// Output goes through one large stdio buffer
+static void batch_buffer_output(FILE* out) {
+    static char out_buffer[BATCH_IO_SIZE];
+    setvbuf(out, out_buffer, _IOFBF, sizeof(out_buffer));
+}
+
+// Single-threaded stream reader: evaluates whole lines as they arrive
+static int run_batch_stream(FILE* in, FILE* out, const BatchOptions* opts, Int256Cache* cache) {
+    size_t cap = BATCH_IO_SIZE;
+    char* buf = malloc(cap);
+    if (buf == NULL) {
+        fprintf(stderr, "calc256: out of memory\n");
+        return 1;
+    }
+    
+    size_t filled = 0;
+    int eof = 0;
+    
+    while (!eof || filled > 0) {
+        if (!eof && filled < cap) {
+            size_t got = fread(buf + filled, 1, cap - filled, in);
+            filled += got;
+            if (got == 0) eof = 1;
+        }
+        
+        // Evaluate every complete line in the buffer, and at EOF a last
+        // line without a trailing newline
+        size_t start = filled;
+        if (!eof) {
+            while (start > 0 && buf[start - 1] != '\n') start--;
+        }
+        batch_eval_span(buf, buf + start, opts, cache, out);
+        
+        memmove(buf, buf + start, filled - start);
+        filled -= start;
+        
+        if (filled == cap) {
+            // A single line longer than the buffer: grow it
+            char* grown = realloc(buf, cap * 2);
+            if (grown == NULL) {
+                free(buf);
+                fprintf(stderr, "calc256: out of memory\n");
+                return 1;
+            }
+            buf = grown;
+            cap *= 2;
+        }
+    }
+    
+    free(buf);
+    if (fflush(out) != 0 || ferror(in)) {
+        fprintf(stderr, "calc256: I/O error\n");
+        return 1;
+    }
+    return 0;
+}
+
+int run_batch(FILE* in, FILE* out, const BatchOptions* opts) {
+    batch_buffer_output(out);
+    
+    if (opts->threads > 1) {
+        BatchSource src = {in, NULL, 0, 0, NULL, 0, 0};
+        return run_batch_parallel(&src, out, opts);
+    }
+    
+    Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+    Int256Cache* cache = batch_cache_open(opts);
+    int rc = run_batch_stream(in, out, opts, cache);
+    batch_cache_close(cache, &cache_total);
+    batch_cache_report(opts, &cache_total);
+    return rc;
+}
+
+// ==================== FILE INPUT ====================
+//
+// calc256 --batch --file numbers.txt
+//
+// Maps the file and evaluates lines where they lie: no read() copies, no
+// per-line buffers, and no limit on line length. Anything that cannot be
+// mapped (a pipe, /dev/stdin) goes through the stream reader instead.
+
+int run_batch_file(const char* path, FILE* out, const BatchOptions* opts) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "calc256: %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+    
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    if (map == MAP_FAILED) {
+        FILE* in = fdopen(fd, "rb");
+        if (in == NULL) {
+            close(fd);
+            fprintf(stderr, "calc256: %s: %s\n", path, strerror(errno));
+            return 1;
+        }
+        int rc = run_batch(in, out, opts);
+        fclose(in);
+        return rc;
+    }
+    close(fd);
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    
+    batch_buffer_output(out);
+    
+    int rc = 0;
+    if (opts->threads > 1) {
+        BatchSource src = {NULL, NULL, 0, 0, map, (size_t)st.st_size, 0};
+        rc = run_batch_parallel(&src, out, opts);
+    } else {
+        Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+        Int256Cache* cache = batch_cache_open(opts);
+        batch_eval_span(map, (const char*)map + st.st_size, opts, cache, out);
+        batch_cache_close(cache, &cache_total);
+        batch_cache_report(opts, &cache_total);
+        if (fflush(out) != 0) {
+            fprintf(stderr, "calc256: I/O error\n");
+            rc = 1;
+        }
+    }
+    munmap(map, (size_t)st.st_size);
+    return rc;
+}
+
+// ==================== RECORD MODE ====================
+//
+// calc256 --encode [--be] < numbers.txt > values.bin
+// calc256 --records OP [--be] < operands.bin > results.bin
+// calc256 --decode [--be] [--hex] < results.bin > results.txt
+//
+// Pipeline stages exchange values as INT256_RECORD_SIZE-byte records
+// (calc256.h) instead of text. --records reads one record per operand of
+// OP (or per variable of --expr with OP "expr") and writes one result
+// record per group; a failed operation, or an operand that is itself an
+// error record, gives an error record. Records move in blocks of
+// RECORD_BLOCK groups, so text conversion happens only in --encode and
+// --decode at the ends of the pipeline.
+
+#define RECORD_BLOCK 4096
+
+// Evaluates one group of operands for batch_ops[op_index], or for
+// opts->expr when op_index is negative
+static Int256Status records_eval(int op_index, const Int256* v, const BatchOptions* opts,
+                                 Int256Cache* cache, Int256* out) {
+    if (op_index < 0) return expr_eval_int256(opts->expr, v, out);
+    
+    const char* args = batch_ops[op_index].args;
+    Int256 num[3] = {{{0, 0, 0, 0}, 0}, {{0, 0, 0, 0}, 0}, {{0, 0, 0, 0}, 0}};
+    unsigned int count[2] = {0, 0};
+    int num_count = 0, count_count = 0;
+    for (int k = 0; args[k]; k++) {
+        if (args[k] == 'n') {
+            num[num_count++] = v[k];
+        } else {
+            // Counts are the values 0 to INT_MAX, as in text mode
+            if (v[k].sign || v[k].part[0] | v[k].part[1] | v[k].part[2] || v[k].part[3] > INT_MAX) {
+                return INT256_ERR_INVALID;
+            }
+            count[count_count++] = (unsigned int)v[k].part[3];
+        }
+    }
+    return batch_apply(batch_ops[op_index].op, num, count, opts, cache, out);
+}
+
+static Int256Status records_apply(int op_index, const Int256* v, const BatchOptions* opts,
+                                  Int256Cache* cache, Int256* out) {
+    STATS_CLOCK(t);
+    Int256Status status = records_eval(op_index, v, opts, cache, out);
+    STATS_STAGE(STAGE_COMPUTE, t);
+    STATS_REQUEST(op_index < 0 ? BATCH_OP_EXPR : op_index);
+    STATS_RESULT(status);
+    return status;
+}
+
+int run_records(FILE* in, FILE* out, const char* op, Int256RecordOrder order,
+                const BatchOptions* opts) {
+    int op_index = -1, arity;
+    if (opts->expr && strcmp(op, "expr") == 0) {
+        arity = expr_var_count_int256(opts->expr);
+    } else {
+        op_index = batch_find_op(op, strlen(op));
+        if (op_index < 0 || batch_ops[op_index].op == BOP_FACTOR) {
+            fprintf(stderr, "calc256: --records: no single-valued operation '%s'\n", op);
+            return 1;
+        }
+        if (opts->fixed && !batch_fixed_op(batch_ops[op_index].op)) {
+            fprintf(stderr, "calc256: --records: '%s' does not take fixed-point operands\n", op);
+            return 1;
+        }
+        arity = (int)strlen(batch_ops[op_index].args);
+    }
+    if (arity == 0) {
+        fprintf(stderr, "calc256: --records: the expression has no variables\n");
+        return 1;
+    }
+    
+    size_t group = (size_t)arity * INT256_RECORD_SIZE;
+    unsigned char* in_block = malloc(RECORD_BLOCK * group);
+    unsigned char* out_block = malloc(RECORD_BLOCK * INT256_RECORD_SIZE);
+    Int256* operands = malloc(RECORD_BLOCK * (size_t)arity * sizeof(Int256));
+    Int256* results = malloc(RECORD_BLOCK * sizeof(Int256));
+    Int256Status* status = malloc(RECORD_BLOCK * sizeof(Int256Status));
+    int rc = 0;
+    if (!in_block || !out_block || !operands || !results || !status) {
+        fprintf(stderr, "calc256: out of memory\n");
+        rc = 1;
+    }
+    
+    batch_buffer_output(out);
+    Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+    Int256Cache* cache = rc == 0 ? batch_cache_open(opts) : NULL;
+    while (rc == 0) {
+        size_t got = fread(in_block, 1, RECORD_BLOCK * group, in);
+        size_t n = got / group;
+        size_t bad = records_to_int256(in_block, n * (size_t)arity, order, operands);
+        for (size_t i = 0; i < n; i++) {
+            status[i] = INT256_OK;
+            // An error record among the operands passes its status on
+            for (int k = 0; bad && k < arity && status[i] == INT256_OK; k++) {
+                status[i] = record_status_int256(in_block + i * group + (size_t)k * INT256_RECORD_SIZE);
+            }
+            if (status[i] != INT256_OK) {
+                STATS_INPUT_ERROR();
+            } else {
+                status[i] = records_apply(op_index, operands + i * (size_t)arity, opts, cache, &results[i]);
+            }
+        }
+        int256_to_records(results, n, order, out_block);
+        for (size_t i = 0; i < n; i++) {
+            if (status[i] != INT256_OK) record_error_int256(status[i], out_block + i * INT256_RECORD_SIZE);
+        }
+        fwrite(out_block, INT256_RECORD_SIZE, n, out);
+        
+        if (got % group != 0) {
+            fprintf(stderr, "calc256: input ends inside a group of %d records\n", arity);
+            rc = 1;
+        }
+        if (got < RECORD_BLOCK * group) break;
+    }
+    batch_cache_close(cache, &cache_total);
+    batch_cache_report(opts, &cache_total);
+    
+    free(in_block);
+    free(out_block);
+    free(operands);
+    free(results);
+    free(status);
+    if (fflush(out) != 0 || ferror(in)) {
+        if (rc == 0) fprintf(stderr, "calc256: I/O error\n");
+        rc = 1;
+    }
+    return rc;
+}
+
+int run_encode(FILE* in, FILE* out, Int256RecordOrder order, const BatchOptions* opts) {
+    Int256* values = malloc(RECORD_BLOCK * sizeof(Int256));
+    Int256Status* status = malloc(RECORD_BLOCK * sizeof(Int256Status));
+    unsigned char* block = malloc(RECORD_BLOCK * INT256_RECORD_SIZE);
+    char* line = NULL;
+    size_t line_cap = 0, n = 0;
+    ssize_t len = 0;
+    if (!values || !status || !block) {
+        fprintf(stderr, "calc256: out of memory\n");
+        len = -1;
+    }
+    
+    batch_buffer_output(out);
+    while (len >= 0) {
+        len = getline(&line, &line_cap, in);
+        if (len >= 0) {
+            const char* cursor = line;
+            const char* end = line + len - (len > 0 && line[len - 1] == '\n');
+            size_t tok_len;
+            const char* tok = batch_next_token(&cursor, end, &tok_len);
+            if (tok == NULL || tok[0] == '#') continue;
+            
+            // One number per line; anything else is an invalid-number record
+            status[n] = batch_parse_value(tok, tok_len, opts, &values[n]);
+            if (status[n] == INT256_OK && batch_next_token(&cursor, end, &tok_len) != NULL) {
+                status[n] = INT256_ERR_INVALID;
+            }
+            if (status[n] != INT256_OK) values[n] = (Int256){{0, 0, 0, 0}, 0};
+            if (++n < RECORD_BLOCK) continue;
+        }
+        int256_to_records(values, n, order, block);
+        for (size_t i = 0; i < n; i++) {
+            if (status[i] != INT256_OK) record_error_int256(status[i], block + i * INT256_RECORD_SIZE);
+        }
+        fwrite(block, INT256_RECORD_SIZE, n, out);
+        n = 0;
+    }
+    
+    int rc = values && status && block ? 0 : 1;
+    free(line);
+    free(values);
+    free(status);
+    free(block);
+    if (fflush(out) != 0 || ferror(in)) {
+        if (rc == 0) fprintf(stderr, "calc256: I/O error\n");
+        rc = 1;
+    }
+    return rc;
+}
+
+int run_decode(FILE* in, FILE* out, Int256RecordOrder order, const BatchOptions* opts) {
+    Int256* values = malloc(RECORD_BLOCK * sizeof(Int256));
+    unsigned char* block = malloc(RECORD_BLOCK * INT256_RECORD_SIZE);
+    int rc = 0;
+    if (!values || !block) {
+        fprintf(stderr, "calc256: out of memory\n");
+        rc = 1;
+    }
+    
+    batch_buffer_output(out);
+    Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+    Int256Cache* cache = rc == 0 ? batch_cache_open(opts) : NULL;
+    char text[BATCH_LINE_MAX];
+    while (rc == 0) {
+        size_t got = fread(block, 1, RECORD_BLOCK * INT256_RECORD_SIZE, in);
+        size_t n = got / INT256_RECORD_SIZE;
+        size_t bad = records_to_int256(block, n, order, values);
+        for (size_t i = 0; i < n; i++) {
+            Int256Status status = bad ? record_status_int256(block + i * INT256_RECORD_SIZE) : INT256_OK;
+            size_t len = batch_format_result(status, values[i], opts, cache, text, sizeof(text));
+            fwrite(text, 1, len, out);
+        }
+        
+        if (got % INT256_RECORD_SIZE != 0) {
+            fprintf(stderr, "calc256: input ends inside a record\n");
+            rc = 1;
+        }
+        if (got < RECORD_BLOCK * INT256_RECORD_SIZE) break;
+    }
+    batch_cache_close(cache, &cache_total);
+    batch_cache_report(opts, &cache_total);
+    
+    free(values);
+    free(block);
+    if (fflush(out) != 0 || ferror(in)) {
+        if (rc == 0) fprintf(stderr, "calc256: I/O error\n");
+        rc = 1;
+    }
+    return rc;
+}
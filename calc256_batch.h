@@ -0,0 +1,60 @@
+#ifndef CALC256_BATCH_H
+#define CALC256_BATCH_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "calc256.h"
+
+#define BATCH_IO_SIZE (1 << 20)
+#define BATCH_LINE_MAX 512    // formatted result line
+#define BATCH_MAX_THREADS 256
+
+typedef struct {
+    int hex_output;            // print results in hex instead of decimal
+    const Int256Expr* expr;    // if set, each line holds values for its variables
+    int threads;               // > 1 evaluates chunks of lines in parallel
+    size_t cache_size;         // > 0 memoizes div, mod, pow and decimal output per thread
+    Int256Rounding rounding;   // muldiv rounding
+    const Int256Fixed* fixed;  // if set, numbers are decimals with fixed->scale places
+} BatchOptions;
+
+// Evaluates one input line and writes the result line (with trailing
+// newline) into out. Returns the number of bytes written, 0 for lines that
+// produce no output. out_size should be at least BATCH_LINE_MAX. cache may
+// be NULL; otherwise div, mod, pow and decimal results go through it.
+size_t batch_eval_line(const char* line, size_t len, const BatchOptions* opts,
+                       Int256Cache* cache, char* out, size_t out_size);
+
+// Evaluates every line of in, writing results to out. Returns 0 on
+// success, 1 on an I/O or allocation error.
+int run_batch(FILE* in, FILE* out, const BatchOptions* opts);
+
+// Same for the file at path, memory-mapped and parsed in place
+int run_batch_file(const char* path, FILE* out, const BatchOptions* opts);
+
+// Binary records (INT256_RECORD_SIZE bytes each, see calc256.h). run_records
+// reads one record per operand of the batch operation op (or per variable
+// of opts->expr when op is "expr") and writes one result record per group.
+// run_encode turns text numbers, one per line, into records and run_decode
+// turns records into result lines. Each returns 0 on success, 1 on an
+// error (reported on stderr).
+int run_records(FILE* in, FILE* out, const char* op, Int256RecordOrder order,
+                const BatchOptions* opts);
+int run_encode(FILE* in, FILE* out, Int256RecordOrder order, const BatchOptions* opts);
+int run_decode(FILE* in, FILE* out, Int256RecordOrder order, const BatchOptions* opts);
+
+// Per-thread caches for opts->cache_size: open returns NULL when caching
+// is off (or, with a warning, out of memory); close adds the counters to
+// total and frees the cache; report prints total on stderr.
+Int256Cache* batch_cache_open(const BatchOptions* opts);
+void batch_cache_close(Int256Cache* cache, Int256CacheStats* total);
+void batch_cache_report(const BatchOptions* opts, const Int256CacheStats* total);
+
+// Name of batch operation index for reports ("expr" for --expr lines), or NULL
+const char* batch_op_name(int index);
+
+// Online CPUs, at least 1 and at most BATCH_MAX_THREADS
+int batch_cpu_count(void);
+
+#endif // CALC256_BATCH_H
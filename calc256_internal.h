@@ -0,0 +1,230 @@
+#ifndef CALC256_INTERNAL_H
+#define CALC256_INTERNAL_H
+
+// Limb-level helpers shared by the library sources. Not installed; the
+// functions declared here are hidden from the shared library's exports.
+
+#include "calc256.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CALC256_INTERNAL __attribute__((visibility("hidden")))
+#else
+#define CALC256_INTERNAL
+#endif
+
+// ==================== CONSTANTS ====================
+#define POW10_19 10000000000000000000ULL       // Decimal chunk (10^19, high bit set)
+#define POW10_19_RECIP 0xd83c94fb6d2ac34aULL   // reciprocal_word(POW10_19)
+
+// ==================== LIMB HELPERS ====================
+
+// Internal helpers work on little-endian limb arrays (l[0] = least significant),
+// the natural order for carry chains; Int256.part[] is most significant first.
+static inline void int256_to_limbs(const Int256* a, uint64_t l[4]) {
+    l[0] = a->part[3];
+    l[1] = a->part[2];
+    l[2] = a->part[1];
+    l[3] = a->part[0];
+}
+
+static inline Int256 limbs_to_int256(const uint64_t l[4], int sign) {
+    Int256 r = {{l[3], l[2], l[1], l[0]}, sign};
+    if ((l[0] | l[1] | l[2] | l[3]) == 0) r.sign = 0;
+    return r;
+}
+
+// Number of significant limbs (0 for zero)
+static inline int limbs_len(const uint64_t* l, int n) {
+    while (n > 0 && l[n - 1] == 0) n--;
+    return n;
+}
+
+// Number of significant bits in a little-endian limb array
+static inline int limbs_bits(const uint64_t* l, int n) {
+    n = limbs_len(l, n);
+    return n == 0 ? 0 : 64 * n - __builtin_clzll(l[n - 1]);
+}
+
+static inline int cmp_limbs_4(const uint64_t a[4], const uint64_t b[4]) {
+    for (int i = 3; i >= 0; i--) {
+        if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+// Trailing zero bits (256 for zero)
+static inline int ctz_limbs_4(const uint64_t a[4]) {
+    for (int i = 0; i < 4; i++) {
+        if (a[i]) return 64 * i + __builtin_ctzll(a[i]);
+    }
+    return 256;
+}
+
+static inline void shr_limbs_4(uint64_t a[4], int s) {
+    int w = s / 64, b = s % 64;
+    for (int i = 0; i < 4; i++) {
+        uint64_t lo = i + w < 4 ? a[i + w] : 0;
+        uint64_t hi = i + w + 1 < 4 ? a[i + w + 1] : 0;
+        a[i] = b ? (lo >> b) | (hi << (64 - b)) : lo;
+    }
+}
+
+// Inverse of odd m modulo 2^64 (Newton: each step doubles the correct bits)
+static inline uint64_t inverse_word(uint64_t m) {
+    uint64_t inv = m;
+    for (int i = 0; i < 5; i++) inv *= 2 - m * inv;
+    return inv;
+}
+
+// ==================== MULTIPLICATION KERNELS ====================
+
+// Full-product kernel, switched to MULX/ADX at startup when available
+extern CALC256_INTERNAL void (*mul_full_kernel)(uint64_t r[8], const uint64_t a[4],
+                                                const uint64_t b[4]);
+
+static inline void mul_limbs_4x4(uint64_t r[8], const uint64_t a[4], const uint64_t b[4]) {
+    mul_full_kernel(r, a, b);
+}
+
+// Squaring: the six cross products are computed once and doubled
+CALC256_INTERNAL void sqr_limbs_4(uint64_t r[8], const uint64_t a[4]);
+
+// Low 256 bits only: the 10 partial products that land there
+static inline void mullo_limbs_4x4(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; i + j < 4; j++) {
+            __uint128_t p = (__uint128_t)a[i] * b[j] + t[i + j] + carry;
+            t[i + j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+    }
+    memcpy(r, t, sizeof(t));
+}
+
+// Low 256 bits of a^2: the four cross products that land there, doubled,
+// plus two squares on the diagonal
+static inline void sqrlo_limbs_4(uint64_t r[4], const uint64_t a[4]) {
+    __uint128_t p = (__uint128_t)a[0] * a[1];
+    uint64_t t1 = (uint64_t)p;
+    p = (__uint128_t)a[0] * a[2] + (uint64_t)(p >> 64);
+    uint64_t t2 = (uint64_t)p;
+    uint64_t t3 = (uint64_t)(p >> 64) + a[0] * a[3] + a[1] * a[2];
+    t3 = (t3 << 1) | (t2 >> 63);
+    t2 = (t2 << 1) | (t1 >> 63);
+    t1 <<= 1;
+    
+    __uint128_t d0 = (__uint128_t)a[0] * a[0];
+    __uint128_t d1 = (__uint128_t)a[1] * a[1];
+    __uint128_t s = (__uint128_t)t1 + (uint64_t)(d0 >> 64);
+    r[0] = (uint64_t)d0;
+    r[1] = (uint64_t)s;
+    s = (__uint128_t)t2 + (uint64_t)d1 + (uint64_t)(s >> 64);
+    r[2] = (uint64_t)s;
+    r[3] = t3 + (uint64_t)(d1 >> 64) + (uint64_t)(s >> 64);
+}
+
+// |x|^exp modulo 2^256; returns nonzero if the true power exceeds 256 bits
+CALC256_INTERNAL int pow_limbs(uint64_t r[4], const uint64_t x[4], unsigned int exp);
+
+// ==================== DIVISION KERNELS ====================
+
+// 128-by-64 division. Requires hi < d so the quotient fits in 64 bits.
+static inline uint64_t udiv128_64(uint64_t hi, uint64_t lo, uint64_t d, uint64_t* rem) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    uint64_t q, r;
+    __asm__("divq %4" : "=a"(q), "=d"(r) : "a"(lo), "d"(hi), "rm"(d) : "cc");
+    *rem = r;
+    return q;
+#else
+    __uint128_t num = ((__uint128_t)hi << 64) | lo;
+    *rem = (uint64_t)(num % d);
+    return (uint64_t)(num / d);
+#endif
+}
+
+// floor((2^128 - 1) / d) - 2^64 for normalized d (high bit set)
+static inline uint64_t reciprocal_word(uint64_t d) {
+    uint64_t rem;
+    return udiv128_64(~d, UINT64_MAX, d, &rem);
+}
+
+// (u1:u0) / d for normalized d and u1 < d
+static inline uint64_t div_2by1_preinv(uint64_t u1, uint64_t u0, uint64_t d,
+                                       uint64_t v, uint64_t* rem) {
+    __uint128_t q = (__uint128_t)v * u1 + ((((__uint128_t)u1) << 64) | u0);
+    uint64_t q1 = (uint64_t)(q >> 64) + 1;
+    uint64_t q0 = (uint64_t)q;
+    uint64_t r = u0 - q1 * d;
+    if (r > q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+    *rem = r;
+    return q1;
+}
+
+// Divides u[0..m) by v[0..n) where v[n-1] != 0, m >= n, n <= 4 and m <= 8.
+// Writes m-n+1 quotient limbs to q and n remainder limbs to r (either may
+// be NULL).
+CALC256_INTERNAL void divmod_limbs(uint64_t* q, uint64_t* r,
+                                   const uint64_t* u, int m, const uint64_t* v, int n);
+
+// Divides the len (4 or 8) little-endian limbs u by the prepared divisor
+// into len quotient limbs and 4 remainder limbs
+CALC256_INTERNAL void divider_divmod_limbs(const Int256Divider* dv, const uint64_t* u, int len,
+                                           uint64_t* q, uint64_t r[4]);
+
+// Whether a magnitude truncated toward zero must grow by one unit under
+// mode: neg is the sign of the result, inexact whether anything was
+// dropped, half compares the dropped part with half a unit (-1, 0, 1) and
+// odd is the low bit of the truncated magnitude
+static inline int round_up_magnitude(Int256Rounding mode, int neg, int inexact, int half, int odd) {
+    switch (mode) {
+    case INT256_ROUND_FLOOR:     return inexact && neg;
+    case INT256_ROUND_CEIL:      return inexact && !neg;
+    case INT256_ROUND_AWAY:      return inexact;
+    case INT256_ROUND_HALF_UP:   return half >= 0 && inexact;
+    case INT256_ROUND_HALF_EVEN: return half > 0 || (half == 0 && inexact && odd);
+    default:                     return 0;
+    }
+}
+
+// ==================== MONTGOMERY KERNELS ====================
+
+// r = a * b * R^-1 and a^2 * R^-1 mod n (R = 2^256); odd moduli only
+CALC256_INTERNAL void mont_mul_limbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                                     const Int256Mont* ctx);
+CALC256_INTERNAL void mont_sqr_limbs(uint64_t r[4], const uint64_t a[4], const Int256Mont* ctx);
+
+// r = x^e with x and r in the context's representation
+CALC256_INTERNAL void mont_pow_limbs(uint64_t r[4], const uint64_t x[4], const uint64_t e[4],
+                                     const Int256Mont* ctx);
+
+// ==================== GCD ====================
+
+// gcd of nonzero words by binary GCD
+static inline uint64_t gcd_word(uint64_t x, uint64_t y) {
+    int shift = __builtin_ctzll(x | y);
+    x >>= __builtin_ctzll(x);
+    while (y) {
+        y >>= __builtin_ctzll(y);
+        if (x > y) {
+            uint64_t t = x;
+            x = y;
+            y = t;
+        }
+        y -= x;
+    }
+    return x << shift;
+}
+
+// gcd of little-endian magnitudes
+CALC256_INTERNAL void gcd_limbs(uint64_t r[4], const uint64_t x[4], const uint64_t y[4]);
+
+#endif // CALC256_INTERNAL_H
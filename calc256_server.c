@@ -0,0 +1,441 @@
+#define _GNU_SOURCE   // accept4
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "calc256.h"
+#include "calc256_server.h"
+
+// ==================== SERVER MODE ====================
+//
+// calc256 --listen /run/calc256.sock [--threads N] [--cache N]
+// calc256 --listen :7256
+//
+// Speaks the --batch protocol over stream sockets: a client writes request
+// lines ("mul 0x1f 123\n") and reads one reply line per request, in order.
+// Requests may be pipelined. Every wakeup reads whatever has arrived with
+// one read(), evaluates each complete line, and sends all the replies with
+// one send(). Each worker thread runs its own epoll loop and owns the
+// connections it accepts; only the listening socket is shared. A client
+// that stops reading gets up to SERVER_OUTPUT_MAX bytes of replies queued,
+// then the server stops reading its requests until they drain.
+
+typedef struct ServerConn {
+    int fd;
+    int eof;                           // client has shut down its sending side
+    uint32_t events;                   // current epoll interest
+    char* in;
+    size_t in_start, in_len, in_cap;   // unevaluated requests are in[in_start, in_len)
+    char* out;
+    size_t out_sent, out_len, out_cap;
+    struct ServerConn* prev;
+    struct ServerConn* next;
+} ServerConn;
+
+typedef struct {
+    const BatchOptions* opts;
+    int listen_fd;
+    int epoll_fd;
+    int accepting;                     // listen_fd is in epoll_fd
+    int spare_fd;                      // given up to shed a connection when out of descriptors
+    Int256Cache* cache;
+    ServerConn* conns;
+    Int256CacheStats cache_stats;
+} ServerWorker;
+
+// epoll_event.data.ptr of the two descriptors that are not connections
+static char server_listen_tag, server_wake_tag;
+
+static void server_watch_listener(ServerWorker* w) {
+    // EPOLLEXCLUSIVE wakes one worker per connection instead of all of them
+    struct epoll_event ev = {EPOLLIN | EPOLLEXCLUSIVE, {.ptr = &server_listen_tag}};
+    int rc = epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->listen_fd, &ev);
+    if (rc < 0 && errno == EINVAL) {
+        ev.events = EPOLLIN;   // kernel before 4.5
+        rc = epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->listen_fd, &ev);
+    }
+    w->accepting = rc == 0;
+}
+
+// Doubles *buf up to max bytes; 0 if it is that large already or memory is short
+static int server_grow(char** buf, size_t* cap, size_t max) {
+    if (*cap >= max) return 0;
+    char* grown = realloc(*buf, *cap * 2);
+    if (grown == NULL) return 0;
+    *buf = grown;
+    *cap *= 2;
+    return 1;
+}
+
+static void server_close(ServerWorker* w, ServerConn* c) {
+    close(c->fd);
+    if (c->prev) c->prev->next = c->next;
+    else w->conns = c->next;
+    if (c->next) c->next->prev = c->prev;
+    free(c->in);
+    free(c->out);
+    free(c);
+    // A descriptor is free again
+    if (!w->accepting) server_watch_listener(w);
+}
+
+static void server_accept(ServerWorker* w) {
+    for (;;) {
+        int fd = accept4(w->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EMFILE && errno != ENFILE) return;
+            if (!w->conns) {
+                // No client here will leave and free a descriptor, and the
+                // level-triggered listener would keep waking us: take the
+                // connection with the spare descriptor and drop it
+                if (w->spare_fd < 0) w->spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                if (w->spare_fd >= 0) {
+                    close(w->spare_fd);
+                    fd = accept4(w->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+                    if (fd >= 0) close(fd);
+                    w->spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                    if (fd >= 0) continue;
+                }
+            }
+            // Out of descriptors: stop polling the listener until a client
+            // leaves, or for SERVER_RETRY_MS if none is connected
+            epoll_ctl(w->epoll_fd, EPOLL_CTL_DEL, w->listen_fd, NULL);
+            w->accepting = 0;
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // fails harmlessly on Unix sockets
+
+        ServerConn* c = calloc(1, sizeof(*c));
+        if (c) {
+            c->in = malloc(SERVER_BUFFER_SIZE);
+            c->out = malloc(SERVER_BUFFER_SIZE);
+        }
+        struct epoll_event ev = {EPOLLIN, {.ptr = c}};
+        if (c == NULL || c->in == NULL || c->out == NULL ||
+            epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            if (c) {
+                free(c->in);
+                free(c->out);
+                free(c);
+            }
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->events = EPOLLIN;
+        c->in_cap = c->out_cap = SERVER_BUFFER_SIZE;
+        c->next = w->conns;
+        if (w->conns) w->conns->prev = c;
+        w->conns = c;
+    }
+}
+
+// One read() into the input buffer; -1 if the connection should be dropped
+static int server_read(ServerConn* c) {
+    if (c->in_start > 0) {
+        memmove(c->in, c->in + c->in_start, c->in_len - c->in_start);
+        c->in_len -= c->in_start;
+        c->in_start = 0;
+    }
+    // Reads only happen once every complete line has been answered, so a
+    // full buffer holds part of a single long line
+    if (c->in_len == c->in_cap && !server_grow(&c->in, &c->in_cap, SERVER_INPUT_MAX)) return -1;
+
+    ssize_t got = read(c->fd, c->in + c->in_len, c->in_cap - c->in_len);
+    if (got > 0) {
+        c->in_len += (size_t)got;
+    } else if (got == 0) {
+        c->eof = 1;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        return -1;
+    }
+    return 0;
+}
+
+// Answers buffered requests (at EOF also a last one without a newline)
+// while the reply buffer has room. Returns 1 if requests are left over.
+static int server_eval(ServerWorker* w, ServerConn* c) {
+    const char* p = c->in + c->in_start;
+    const char* end = c->in + c->in_len;
+    int more = 0;
+    while (p < end) {
+        const char* nl = memchr(p, '\n', (size_t)(end - p));
+        if (nl == NULL && !c->eof) break;
+        if (c->out_cap - c->out_len < BATCH_LINE_MAX &&
+            !server_grow(&c->out, &c->out_cap, SERVER_OUTPUT_MAX)) {
+            more = 1;
+            break;
+        }
+        if (nl == NULL) nl = end;
+        c->out_len += batch_eval_line(p, (size_t)(nl - p), w->opts, w->cache,
+                                      c->out + c->out_len, BATCH_LINE_MAX);
+        p = nl < end ? nl + 1 : end;
+    }
+    c->in_start = (size_t)(p - c->in);
+    return more;
+}
+
+// Sends pending replies; -1 if the client is gone
+static int server_flush(ServerConn* c) {
+    while (c->out_sent < c->out_len) {
+        ssize_t n = send(c->fd, c->out + c->out_sent, c->out_len - c->out_sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+        }
+        c->out_sent += (size_t)n;
+    }
+    c->out_sent = c->out_len = 0;
+    return 0;
+}
+
+// Handles any event on c. Errors and hangups may arrive without EPOLLIN or
+// EPOLLOUT; the read() or send() below reports them.
+static void server_serve(ServerWorker* w, ServerConn* c) {
+    if (c->events == EPOLLIN && server_read(c) < 0) {
+        server_close(w, c);
+        return;
+    }
+
+    // Answer and send until the requests run out or the socket fills up
+    for (;;) {
+        int more = server_eval(w, c);
+        if (server_flush(c) < 0) {
+            server_close(w, c);
+            return;
+        }
+        if (!more || c->out_len > 0) break;
+    }
+    if (c->eof && c->out_len == 0) {
+        server_close(w, c);
+        return;
+    }
+
+    // Wait for the socket to drain before reading more requests
+    uint32_t want = c->out_len > 0 ? EPOLLOUT : EPOLLIN;
+    if (want != c->events) {
+        struct epoll_event ev = {want, {.ptr = c}};
+        if (epoll_ctl(w->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev) < 0) {
+            server_close(w, c);
+            return;
+        }
+        c->events = want;
+    }
+}
+
+static void* server_worker(void* arg) {
+    ServerWorker* w = arg;
+    w->cache = batch_cache_open(w->opts);
+
+    struct epoll_event events[SERVER_MAX_EVENTS];
+    int running = 1;
+    while (running) {
+        int timeout = w->accepting || w->conns ? -1 : SERVER_RETRY_MS;
+        int n = epoll_wait(w->epoll_fd, events, SERVER_MAX_EVENTS, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "calc256: epoll_wait: %s\n", strerror(errno));
+            break;
+        }
+        if (!w->accepting && !w->conns) server_watch_listener(w);
+        for (int i = 0; i < n; i++) {
+            void* tag = events[i].data.ptr;
+            if (tag == &server_wake_tag) {
+                running = 0;
+            } else if (tag == &server_listen_tag) {
+                server_accept(w);
+            } else {
+                server_serve(w, tag);
+            }
+        }
+    }
+
+    while (w->conns) server_close(w, w->conns);
+    batch_cache_close(w->cache, &w->cache_stats);
+    return NULL;
+}
+
+// ==================== LISTENING SOCKET ====================
+
+// Unix socket at path. A socket file nobody listens on any more (left by a
+// server that was killed) is replaced; a live one is not.
+static int server_listen_unix(const char* path) {
+    struct sockaddr_un sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(sa.sun_path)) {
+        fprintf(stderr, "calc256: %s: socket path too long\n", path);
+        return -1;
+    }
+    strcpy(sa.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fprintf(stderr, "calc256: socket: %s\n", strerror(errno));
+        return -1;
+    }
+    struct stat st;
+    if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe >= 0 && connect(probe, (struct sockaddr*)&sa, sizeof(sa)) < 0 &&
+            errno == ECONNREFUSED) {
+            unlink(path);
+        }
+        if (probe >= 0) close(probe);
+    }
+    if (bind(fd, (struct sockaddr*)&sa, sizeof(sa)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        fprintf(stderr, "calc256: %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    fprintf(stderr, "calc256: listening on %s\n", path);
+    return fd;
+}
+
+// TCP socket at HOST:PORT, :PORT or [IPV6]:PORT
+static int server_listen_tcp(const char* address, const char* colon) {
+    char host[256];
+    size_t host_len = (size_t)(colon - address);
+    const char* host_start = address;
+    if (host_len >= 2 && address[0] == '[' && colon[-1] == ']') {
+        host_start++;
+        host_len -= 2;
+    }
+    if (host_len >= sizeof(host)) {
+        fprintf(stderr, "calc256: %s: host name too long\n", address);
+        return -1;
+    }
+    memcpy(host, host_start, host_len);
+    host[host_len] = '\0';
+
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    int err = getaddrinfo(host_len ? host : "127.0.0.1", colon + 1, &hints, &res);
+    if (err != 0) {
+        fprintf(stderr, "calc256: %s: %s\n", address, gai_strerror(err));
+        return -1;
+    }
+
+    int fd = -1;
+    err = 0;
+    for (struct addrinfo* ai = res; ai != NULL && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            err = errno;
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(fd, ai->ai_addr, ai->ai_addrlen) < 0 || listen(fd, SOMAXCONN) < 0) {
+            err = errno;
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    if (fd < 0) {
+        fprintf(stderr, "calc256: %s: %s\n", address, strerror(err));
+        return -1;
+    }
+
+    // Report the bound address, which tells clients the port when it was 0
+    struct sockaddr_storage sa;
+    socklen_t sa_len = sizeof(sa);
+    char name[NI_MAXHOST], port[NI_MAXSERV];
+    if (getsockname(fd, (struct sockaddr*)&sa, &sa_len) == 0 &&
+        getnameinfo((struct sockaddr*)&sa, sa_len, name, sizeof(name), port, sizeof(port),
+                    NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
+        fprintf(stderr, strchr(name, ':') ? "calc256: listening on [%s]:%s\n"
+                                          : "calc256: listening on %s:%s\n", name, port);
+    }
+    return fd;
+}
+
+int run_server(const char* address, const BatchOptions* opts) {
+    // Anything with a '/' or without a ':' is a socket path
+    const char* colon = strrchr(address, ':');
+    int is_unix = strchr(address, '/') != NULL || colon == NULL;
+    int listen_fd = is_unix ? server_listen_unix(address) : server_listen_tcp(address, colon);
+    if (listen_fd < 0) return 1;
+
+    // Workers inherit the blocked mask; this thread takes the signals with sigwait
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, NULL);
+
+    int workers = opts->threads > 0 ? opts->threads : 1;
+    int wake_fd = eventfd(0, EFD_CLOEXEC);
+    ServerWorker* args = calloc((size_t)workers, sizeof(ServerWorker));
+    pthread_t* threads = calloc((size_t)workers, sizeof(pthread_t));
+    int rc = 0, started = 0;
+    if (wake_fd < 0 || args == NULL || threads == NULL) {
+        fprintf(stderr, "calc256: out of memory\n");
+        rc = 1;
+    }
+
+    for (; rc == 0 && started < workers; started++) {
+        ServerWorker* w = &args[started];
+        w->opts = opts;
+        w->listen_fd = listen_fd;
+        w->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        w->spare_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        struct epoll_event ev = {EPOLLIN, {.ptr = &server_wake_tag}};
+        if (w->epoll_fd >= 0 && epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev) == 0) {
+            server_watch_listener(w);
+        }
+        if (!w->accepting || w->spare_fd < 0 ||
+            pthread_create(&threads[started], NULL, server_worker, w) != 0) {
+            fprintf(stderr, "calc256: cannot start server thread\n");
+            if (w->epoll_fd >= 0) close(w->epoll_fd);
+            if (w->spare_fd >= 0) close(w->spare_fd);
+            rc = 1;
+            break;
+        }
+    }
+
+    if (rc == 0) {
+        int sig;
+        sigwait(&stop_signals, &sig);
+    }
+
+    // The eventfd stays readable, so every worker sees it
+    if (wake_fd >= 0) eventfd_write(wake_fd, 1);
+    Int256CacheStats cache_total = {0, 0, 0, 0, 0};
+    for (int w = 0; w < started; w++) {
+        pthread_join(threads[w], NULL);
+        close(args[w].epoll_fd);
+        if (args[w].spare_fd >= 0) close(args[w].spare_fd);
+        cache_total.hits += args[w].cache_stats.hits;
+        cache_total.misses += args[w].cache_stats.misses;
+        cache_total.evictions += args[w].cache_stats.evictions;
+    }
+    batch_cache_report(opts, &cache_total);
+
+    if (wake_fd >= 0) close(wake_fd);
+    close(listen_fd);
+    if (is_unix) unlink(address);
+    free(args);
+    free(threads);
+    return rc;
+}
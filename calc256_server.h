@@ -0,0 +1,21 @@
+#ifndef CALC256_SERVER_H
+#define CALC256_SERVER_H
+
+#include "calc256_batch.h"
+
+#define SERVER_MAX_EVENTS 64
+#define SERVER_BUFFER_SIZE (16 << 10)    // initial per-connection read and reply buffers
+#define SERVER_INPUT_MAX (1 << 20)       // longest request line accepted
+#define SERVER_OUTPUT_MAX (1 << 20)      // replies queued per connection before backpressure
+#define SERVER_RETRY_MS 100              // listener pause when out of descriptors with no clients
+
+// Serves the batch line protocol at address until SIGINT or SIGTERM: each
+// request line gets its reply line, in order, and clients may send any
+// number of requests before reading. address is a Unix socket path, or
+// HOST:PORT or :PORT for TCP (HOST defaults to 127.0.0.1; port 0 picks a
+// free one). opts->threads event loops share the listening socket; each has
+// its own cache when opts->cache_size is set. Returns 0 on a clean
+// shutdown, 1 if the socket cannot be set up.
+int run_server(const char* address, const BatchOptions* opts);
+
+#endif // CALC256_SERVER_H
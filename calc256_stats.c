@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <signal.h>
+#include <pthread.h>
+
+#include "calc256_batch.h"
+#include "calc256_stats.h"
+
+// ==================== STATISTICS ====================
+//
+// calc256 --stats --batch < ops.txt      JSON totals on stderr at exit
+// kill -USR1 <pid>                       a snapshot at any time
+//
+// Every thread's counter block is allocated on its first update and linked
+// into a list that is never pruned, so the counts of batch workers that
+// have exited still appear in the totals.
+
+#ifdef CALC256_STATS
+
+#include <stdlib.h>
+#include <string.h>
+
+#define STATS_LINE 64           // cache line size the counter blocks are padded to
+
+__thread StatsCounters* stats_local;
+static StatsCounters* stats_list;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Where a thread counts when it cannot get a block: never reported
+static StatsCounters stats_discard;
+
+StatsCounters* stats_register(void) {
+    // Whole cache lines, so no other thread's data shares the first or last
+    // line of the block
+    size_t size = (sizeof(StatsCounters) + STATS_LINE - 1) & ~(size_t)(STATS_LINE - 1);
+    StatsCounters* s = aligned_alloc(STATS_LINE, size);
+    if (s == NULL) {
+        s = &stats_discard;
+    } else {
+        memset(s, 0, size);
+        pthread_mutex_lock(&stats_lock);
+        s->next = stats_list;
+        stats_list = s;
+        pthread_mutex_unlock(&stats_lock);
+    }
+    stats_local = s;
+    return s;
+}
+
+static uint64_t stats_load(const uint64_t* counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+static void stats_sum(StatsCounters* total) {
+    memset(total, 0, sizeof(*total));
+    pthread_mutex_lock(&stats_lock);
+    for (StatsCounters* s = stats_list; s != NULL; s = s->next) {
+        total->requests += stats_load(&s->requests);
+        total->input_errors += stats_load(&s->input_errors);
+        for (int i = 0; i < STATS_MAX_OPS; i++) total->ops[i] += stats_load(&s->ops[i]);
+        for (int i = 0; i <= INT256_ERR_DOMAIN; i++) total->results[i] += stats_load(&s->results[i]);
+        for (int g = 0; g < STAGE_COUNT; g++) {
+            total->stage_count[g] += stats_load(&s->stage_count[g]);
+            total->stage_time[g] += stats_load(&s->stage_time[g]);
+            for (int b = 0; b < STATS_BUCKETS; b++) {
+                total->histogram[g][b] += stats_load(&s->histogram[g][b]);
+            }
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+}
+
+void stats_report(FILE* out) {
+    static const char* status_names[INT256_ERR_DOMAIN + 1] = {
+        "ok", "empty", "invalid", "overflow", "div_by_zero", "domain"};
+    static const char* stage_names[STAGE_COUNT] = {"parse", "compute", "format"};
+    StatsCounters total;
+    stats_sum(&total);
+
+    fprintf(out, "{\"unit\":\"%s\",\"requests\":%llu,\"input_errors\":%llu,\"ops\":{", STATS_UNIT,
+            (unsigned long long)total.requests, (unsigned long long)total.input_errors);
+    const char* sep = "";
+    for (int i = 0; i < STATS_MAX_OPS; i++) {
+        const char* name = batch_op_name(i);
+        if (total.ops[i] == 0) continue;
+        fprintf(out, "%s\"%s\":%llu", sep, name ? name : "other", (unsigned long long)total.ops[i]);
+        sep = ",";
+    }
+    fprintf(out, "},\"results\":{");
+    for (int i = 0; i <= INT256_ERR_DOMAIN; i++) {
+        fprintf(out, "%s\"%s\":%llu", i ? "," : "", status_names[i],
+                (unsigned long long)total.results[i]);
+    }
+    fprintf(out, "},\"stages\":{");
+    for (int g = 0; g < STAGE_COUNT; g++) {
+        // histogram keys are bucket lower bounds: "64":n counts [64, 128)
+        fprintf(out, "%s\"%s\":{\"count\":%llu,\"total\":%llu,\"histogram\":{", g ? "," : "",
+                stage_names[g], (unsigned long long)total.stage_count[g],
+                (unsigned long long)total.stage_time[g]);
+        sep = "";
+        for (int b = 0; b < STATS_BUCKETS; b++) {
+            if (total.histogram[g][b] == 0) continue;
+            fprintf(out, "%s\"%llu\":%llu", sep, b ? 1ULL << (b - 1) : 0ULL,
+                    (unsigned long long)total.histogram[g][b]);
+            sep = ",";
+        }
+        fprintf(out, "}}");
+    }
+    fprintf(out, "}}\n");
+    fflush(out);
+}
+
+static void* stats_signal_thread(void* arg) {
+    sigset_t* usr1 = arg;
+    for (;;) {
+        int sig;
+        if (sigwait(usr1, &sig) == 0) stats_report(stderr);
+    }
+    return NULL;
+}
+
+void stats_init(void) {
+    static sigset_t usr1;
+    sigemptyset(&usr1);
+    sigaddset(&usr1, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &usr1, NULL);
+
+    // The reporter blocks every signal so SIGINT and SIGTERM still reach
+    // the threads that handle them
+    sigset_t all, saved;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &saved);
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, stats_signal_thread, &usr1) == 0) pthread_detach(thread);
+    pthread_sigmask(SIG_SETMASK, &saved, NULL);
+}
+
+#else
+
+void stats_init(void) {
+}
+
+void stats_report(FILE* out) {
+    (void)out;
+    fprintf(stderr, "calc256: --stats needs a build with -DCALC256_STATS (make stats)\n");
+}
+
+#endif // CALC256_STATS
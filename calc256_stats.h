@@ -0,0 +1,100 @@
+#ifndef CALC256_STATS_H
+#define CALC256_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "calc256.h"
+
+// ==================== STATISTICS ====================
+//
+// Built with -DCALC256_STATS (make stats), calc256 counts operations,
+// results by status and input errors, and times the parse, compute and
+// format stage of every request into log2 histograms of TSC cycles
+// (nanoseconds off x86). Each thread updates its own block of counters,
+// so nothing is shared on the hot path. Without the flag the STATS_*
+// macros expand to nothing.
+
+#define STATS_MAX_OPS 64        // batch operations, plus one slot for --expr
+#define STATS_BUCKETS 48        // bucket b counts durations in [2^(b-1), 2^b)
+
+typedef enum { STAGE_PARSE, STAGE_COMPUTE, STAGE_FORMAT, STAGE_COUNT } StatsStage;
+
+typedef struct StatsCounters {
+    uint64_t requests;
+    uint64_t input_errors;                      // rejected before computing
+    uint64_t ops[STATS_MAX_OPS];
+    uint64_t results[INT256_ERR_DOMAIN + 1];    // by Int256Status
+    uint64_t stage_count[STAGE_COUNT];
+    uint64_t stage_time[STAGE_COUNT];
+    uint64_t histogram[STAGE_COUNT][STATS_BUCKETS];
+    struct StatsCounters* next;
+} StatsCounters;
+
+// Blocks SIGUSR1 and starts a thread that prints a snapshot on each one.
+// Call before starting any other thread so they inherit the mask.
+void stats_init(void);
+// Writes the totals over every thread as one JSON object
+void stats_report(FILE* out);
+
+#ifdef CALC256_STATS
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STATS_UNIT "tsc_cycles"
+static inline uint64_t stats_clock(void) { return __rdtsc(); }
+#else
+#include <time.h>
+#define STATS_UNIT "ns"
+static inline uint64_t stats_clock(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+extern __thread StatsCounters* stats_local;
+StatsCounters* stats_register(void);
+
+static inline StatsCounters* stats_counters(void) {
+    StatsCounters* s = stats_local;
+    return s ? s : stats_register();
+}
+
+// Only the owning thread writes a counter; the reporter reads it with a
+// relaxed load, so a plain store that cannot tear is all an update needs
+#define STATS_BUMP(field, n) __atomic_store_n(&(field), (field) + (n), __ATOMIC_RELAXED)
+
+// Records the time since t in stage and returns the current time
+static inline uint64_t stats_stage(StatsStage stage, uint64_t t) {
+    uint64_t now = stats_clock(), d = now - t;
+    int bucket = d ? 64 - __builtin_clzll(d) : 0;
+    if (bucket >= STATS_BUCKETS) bucket = STATS_BUCKETS - 1;
+    StatsCounters* s = stats_counters();
+    STATS_BUMP(s->stage_count[stage], 1);
+    STATS_BUMP(s->stage_time[stage], d);
+    STATS_BUMP(s->histogram[stage][bucket], 1);
+    return now;
+}
+
+#define STATS_CLOCK(t) uint64_t t = stats_clock()
+#define STATS_STAGE(stage, t) (t = stats_stage(stage, t))
+#define STATS_REQUEST(op) do { \
+        StatsCounters* s_ = stats_counters(); \
+        STATS_BUMP(s_->requests, 1); \
+        STATS_BUMP(s_->ops[(op) < STATS_MAX_OPS ? (op) : STATS_MAX_OPS - 1], 1); \
+    } while (0)
+#define STATS_RESULT(status) STATS_BUMP(stats_counters()->results[status], 1)
+#define STATS_INPUT_ERROR() STATS_BUMP(stats_counters()->input_errors, 1)
+
+#else
+
+#define STATS_CLOCK(t) ((void)0)
+#define STATS_STAGE(stage, t) ((void)0)
+#define STATS_REQUEST(op) ((void)0)
+#define STATS_RESULT(status) ((void)0)
+#define STATS_INPUT_ERROR() ((void)0)
+
+#endif // CALC256_STATS
+
+#endif // CALC256_STATS_H
@@ -0,0 +1,848 @@
+// libcalc256: parsing and formatting, multiplication, power and factorial,
+// and the checked / wrapping / saturating variants.
+
+#include <stdio.h>
+#include <ctype.h>
+#include <inttypes.h>
+
+#include "calc256_internal.h"
+#include "int256_factorial_table.h"
+#include "int256_pow10_table.h"
+
+// ==================== UTILITY FUNCTIONS ====================
+
+// Little-endian 8-byte load (s[0] in the low byte)
+static inline uint64_t load_u64_le(const char* s) {
+    uint64_t x;
+    memcpy(&x, s, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+// SWAR: all 8 bytes are '0'..'9'
+static inline int is_8_digits(uint64_t x) {
+    return ((x & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+           == 0x3333333333333333ULL;
+}
+
+// SWAR: value of 8 decimal digits, s[0] most significant
+static inline uint32_t parse_8_digits(uint64_t x) {
+    x -= 0x3030303030303030ULL;
+    x = (x * 10) + (x >> 8);
+    x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t)x;
+}
+
+// SWAR: all 8 bytes are hex digits (either case)
+static inline int is_8_hex_digits(uint64_t x) {
+    const uint64_t ones = 0x0101010101010101ULL, high = 0x8080808080808080ULL;
+    uint64_t y = x | 0x2020202020202020ULL;   // fold 'A'-'F' onto 'a'-'f'
+    // Digits are tested unfolded: the fold would map 0x10-0x19 onto '0'-'9'
+    uint64_t digit = (x + (0x80 - '0') * ones) & ~(x + (0x7F - '9') * ones);
+    uint64_t alpha = (y + (0x80 - 'a') * ones) & ~(y + (0x7F - 'f') * ones);
+    return ((digit | alpha) & ~x & high) == high;
+}
+
+// SWAR: value of 8 hex digits, s[0] most significant
+static inline uint32_t parse_8_hex_digits(uint64_t x) {
+    // '0'-'9' -> low nibble; letters have bit 6 set and low nibble 1..6
+    uint64_t v = (x & 0x0F0F0F0F0F0F0F0FULL) + 9 * ((x >> 6) & 0x0101010101010101ULL);
+    v = ((v & 0x000F000F000F000FULL) << 4) | ((v >> 8) & 0x000F000F000F000FULL);
+    v = ((v & 0x000000FF000000FFULL) << 8) | ((v >> 16) & 0x000000FF000000FFULL);
+    return (uint32_t)(((v & 0xFFFF) << 16) | ((v >> 32) & 0xFFFF));
+}
+
+static inline int hex_digit_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// acc = acc * mul + add over little-endian limbs; returns the carry out
+static inline uint64_t mul_add_limbs(uint64_t acc[4], uint64_t mul, uint64_t add) {
+    uint64_t carry = add;
+    for (int j = 0; j < 4; j++) {
+        __uint128_t t = (__uint128_t)acc[j] * mul + carry;
+        acc[j] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    return carry;
+}
+
+// Parses a decimal, hex (0x) or binary (0b) number from the first len bytes
+// of str, with optional leading whitespace and sign. Never reads past len
+// and needs no terminator. *consumed receives the offset just past the
+// digits. The number must be followed by whitespace or the end of input,
+// otherwise INT256_ERR_INVALID is returned. On INT256_ERR_OVERFLOW *out
+// holds the value modulo 2^256.
+Int256Status parse_int256(const char* str, size_t len, Int256* out, size_t* consumed) {
+    uint64_t acc[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    int sign = 0;
+    
+    while (i < len && isspace((unsigned char)str[i])) i++;
+    if (i < len && (str[i] == '-' || str[i] == '+')) {
+        sign = str[i] == '-';
+        i++;
+    }
+    
+    int base = 10;
+    if (i + 1 < len && str[i] == '0' && (str[i+1] == 'x' || str[i+1] == 'X')) {
+        base = 16;
+        i += 2;
+    } else if (i + 1 < len && str[i] == '0' && (str[i+1] == 'b' || str[i+1] == 'B')) {
+        base = 2;
+        i += 2;
+    }
+    
+    // Find the digit run [start, end), eight bytes at a time where possible
+    size_t start = i;
+    if (base == 10) {
+        while (i + 8 <= len && is_8_digits(load_u64_le(str + i))) i += 8;
+        while (i < len && str[i] >= '0' && str[i] <= '9') i++;
+    } else if (base == 16) {
+        while (i + 8 <= len && is_8_hex_digits(load_u64_le(str + i))) i += 8;
+        while (i < len && hex_digit_value(str[i]) >= 0) i++;
+    } else {
+        while (i < len && (str[i] == '0' || str[i] == '1')) i++;
+    }
+    size_t end = i;
+    
+    if (consumed) *consumed = end;
+    
+    Int256Status status = INT256_OK;
+    if (end < len && !isspace((unsigned char)str[end])) {
+        status = INT256_ERR_INVALID;
+    } else if (end == start) {
+        status = INT256_ERR_EMPTY;
+    }
+    
+    // Leading zeros never count towards overflow
+    while (start < end && str[start] == '0') start++;
+    size_t digits = end - start;
+    int overflow = 0;
+    
+    if (base == 10) {
+        // First a partial chunk so that the rest are whole 19-digit chunks
+        size_t head = digits % 19;
+        const char* p = str + start;
+        for (size_t k = 0; k < head; k++) acc[0] = acc[0] * 10 + (uint64_t)(p[k] - '0');
+        p += head;
+        for (size_t k = head; k < digits; k += 19, p += 19) {
+            uint64_t chunk = (uint64_t)parse_8_digits(load_u64_le(p)) * 100000000000ULL
+                           + (uint64_t)parse_8_digits(load_u64_le(p + 8)) * 1000
+                           + (uint64_t)(p[16] - '0') * 100
+                           + (uint64_t)(p[17] - '0') * 10
+                           + (uint64_t)(p[18] - '0');
+            if (mul_add_limbs(acc, POW10_19, chunk) != 0) overflow = 1;
+        }
+    } else if (base == 16) {
+        // Whole limbs from the least significant end, 16 digits each
+        overflow = digits > 64;
+        const char* p = str + end;
+        size_t left = digits;
+        for (int limb = 0; limb < 4 && left > 0; limb++) {
+            if (left >= 16) {
+                p -= 16;
+                left -= 16;
+                acc[limb] = ((uint64_t)parse_8_hex_digits(load_u64_le(p)) << 32)
+                          | parse_8_hex_digits(load_u64_le(p + 8));
+            } else {
+                uint64_t v = 0;
+                for (const char* q = p - left; q < p; q++) v = (v << 4) | (uint64_t)hex_digit_value(*q);
+                acc[limb] = v;
+                left = 0;
+            }
+        }
+    } else {
+        overflow = digits > 256;
+        size_t bits = digits > 256 ? 256 : digits;
+        for (size_t k = 0; k < bits; k++) {
+            if (str[end - 1 - k] == '1') acc[k / 64] |= 1ULL << (k % 64);
+        }
+    }
+    
+    if (overflow && status == INT256_OK) status = INT256_ERR_OVERFLOW;
+    *out = limbs_to_int256(acc, sign);
+    return status;
+}
+
+// Parses as much of str as forms a number; values past 256 bits wrap.
+// Use parse_int256 to detect invalid input or overflow.
+Int256 str_to_int256(const char* str) {
+    Int256 result;
+    parse_int256(str, strlen(str), &result, NULL);
+    return result;
+}
+
+void int256_to_hex(const Int256 n, char* buffer, size_t buffer_size) {
+    if (buffer_size < 68) {  // 2 for "0x" + 64 hex digits + 1 for sign + 1 for null
+        buffer[0] = '\0';
+        return;
+    }
+    
+    char* ptr = buffer;
+    
+    if (n.sign) *ptr++ = '-';
+    *ptr++ = '0';
+    *ptr++ = 'x';
+    
+    int started = 0;
+    for (int i = 0; i < 4; i++) {
+        if (n.part[i] != 0 || started || i == 3) {
+            if (!started) {
+                int written = snprintf(ptr, buffer_size - (ptr - buffer), 
+                                      "%" PRIx64, n.part[i]);
+                if (written < 0) {
+                    buffer[0] = '\0';
+                    return;
+                }
+                ptr += written;
+                started = 1;
+            } else {
+                int written = snprintf(ptr, buffer_size - (ptr - buffer), 
+                                      "%016" PRIx64, n.part[i]);
+                if (written < 0) {
+                    buffer[0] = '\0';
+                    return;
+                }
+                ptr += written;
+            }
+        }
+    }
+    if (!started) {
+        *ptr++ = '0';
+        *ptr = '\0';
+    } else {
+        *ptr = '\0';
+    }
+}
+
+// ==================== MULTIPLICATION ====================
+
+// Full 256x256 -> 512-bit product, little-endian
+static void mul_limbs_4x4_generic(uint64_t r[8], const uint64_t a[4], const uint64_t b[4]) {
+    memset(r, 0, 8 * sizeof(uint64_t));
+    for (int i = 0; i < 4; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; j++) {
+            __uint128_t t = (__uint128_t)a[i] * b[j] + r[i + j] + carry;
+            r[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        r[i + 4] = carry;
+    }
+}
+
+// Squaring: the six cross products are computed once and doubled
+void sqr_limbs_4(uint64_t r[8], const uint64_t a[4]) {
+    uint64_t cross[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 3; i++) {
+        uint64_t carry = 0;
+        for (int j = i + 1; j < 4; j++) {
+            __uint128_t t = (__uint128_t)a[i] * a[j] + cross[i + j] + carry;
+            cross[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        cross[i + 4] = carry;
+    }
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; i++) {
+        __uint128_t sq = (__uint128_t)a[i] * a[i];
+        __uint128_t lo = (__uint128_t)(uint64_t)sq + ((uint64_t)(cross[2 * i] << 1))
+                       + carry;
+        r[2 * i] = (uint64_t)lo;
+        __uint128_t hi = (__uint128_t)(uint64_t)(sq >> 64)
+                       + ((cross[2 * i + 1] << 1) | (cross[2 * i] >> 63))
+                       + (uint64_t)(lo >> 64);
+        r[2 * i + 1] = (uint64_t)hi;
+        carry = (uint64_t)(hi >> 64) + (cross[2 * i + 1] >> 63);
+    }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+// Same product using MULX (flags untouched) and two independent carry
+// chains for the low and high halves of each partial product (ADCX/ADOX)
+static __attribute__((target("bmi2,adx"))) void mul_limbs_4x4_adx(uint64_t r[8], const uint64_t a[4],
+                                                                 const uint64_t b[4]) {
+    unsigned long long t[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        unsigned char c_lo = 0, c_hi = 0;
+        for (int j = 0; j < 4; j++) {
+            unsigned long long hi;
+            unsigned long long lo = _mulx_u64(a[j], b[i], &hi);
+            c_lo = _addcarryx_u64(c_lo, t[i + j], lo, &t[i + j]);
+            c_hi = _addcarryx_u64(c_hi, t[i + j + 1], hi, &t[i + j + 1]);
+        }
+        // The row sum fits in i + 5 limbs, so c_hi is zero here
+        _addcarryx_u64(c_lo, t[i + 4], 0, &t[i + 4]);
+    }
+    memcpy(r, t, sizeof(t));
+}
+#endif
+
+// Full-product kernel, switched to MULX/ADX at startup when available
+void (*mul_full_kernel)(uint64_t r[8], const uint64_t a[4], const uint64_t b[4]) =
+    mul_limbs_4x4_generic;
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+__attribute__((constructor)) static void select_mul_kernel(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        mul_full_kernel = mul_limbs_4x4_adx;
+    }
+}
+#endif
+// Only computes the high half when the operand bit lengths say the product
+// might not fit in 256 bits
+static Int256 mul_int256_core(Int256 a, Int256 b, int* overflow) {
+    uint64_t x[4], y[4], t[8];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    
+    *overflow = 0;
+    if (limbs_bits(x, 4) + limbs_bits(y, 4) <= 256) {
+        mullo_limbs_4x4(t, x, y);
+    } else {
+        mul_limbs_4x4(t, x, y);
+        *overflow = (t[4] | t[5] | t[6] | t[7]) != 0;
+    }
+    return limbs_to_int256(t, a.sign ^ b.sign);
+}
+
+// Low 256 bits of the product (wraps); see mul_int256_checked
+Int256 mul_int256(Int256 a, Int256 b) {
+    int overflow;
+    return mul_int256_core(a, b, &overflow);
+}
+
+// Low 256 bits of the product, silently wrapping
+Int256 mul_lo_int256(Int256 a, Int256 b) {
+    uint64_t x[4], y[4], t[4];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    mullo_limbs_4x4(t, x, y);
+    return limbs_to_int256(t, a.sign ^ b.sign);
+}
+
+// a * a with the dedicated squaring kernel; wraps like mul_int256
+Int256 sqr_int256(Int256 a) {
+    uint64_t x[4], t[8];
+    int256_to_limbs(&a, x);
+    sqr_limbs_4(t, x);
+    return limbs_to_int256(t, 0);
+}
+
+// Exact 512-bit product
+Int512 mul_int256_full(Int256 a, Int256 b) {
+    uint64_t x[4], y[4], t[8];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    mul_limbs_4x4(t, x, y);
+    
+    Int512 r;
+    for (int i = 0; i < 8; i++) r.part[i] = t[7 - i];
+    r.sign = limbs_len(t, 8) ? a.sign ^ b.sign : 0;
+    return r;
+}
+
+// ==================== DECIMAL FORMATTING ====================
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// 10^38 as a prepared divisor, set up at load time
+static Int256Divider pow10_38_divider;
+
+__attribute__((constructor)) static void init_pow10_38_divider(void) {
+    divider_init_int256(&pow10_38_divider, pow10_table[38]);
+}
+
+// floor(log2 |a|), or -1 for zero
+int ilog2_int256(Int256 a) {
+    for (int i = 0; i < 4; i++) {
+        if (a.part[i]) return 64 * (4 - i) - 1 - __builtin_clzll(a.part[i]);
+    }
+    return -1;
+}
+
+// floor(log10) of a nonzero len-limb magnitude. A b-bit value has
+// floor(b * log10(2)) or one fewer digits past the first (1233 / 4096 ~
+// log10(2), exact for b <= 256); one table compare decides which.
+static inline int ilog10_limbs(const uint64_t l[4], int len) {
+    int bits = 64 * len - __builtin_clzll(l[len - 1]);
+    int d = (bits * 1233) >> 12;
+    const uint64_t* p = pow10_table[d].part;
+    for (int i = len - 1; i >= 0; i--) {
+        if (l[i] != p[3 - i]) return d - (l[i] < p[3 - i]);
+    }
+    return d;
+}
+
+// floor(log10 |a|), or -1 for zero
+int ilog10_int256(Int256 a) {
+    uint64_t l[4];
+    int256_to_limbs(&a, l);
+    int len = limbs_len(l, 4);
+    return len ? ilog10_limbs(l, len) : -1;
+}
+
+// Writes the 8 digits of x < 10^8
+static inline void write_8_digits(char* out, uint32_t x) {
+    uint32_t hi = x / 10000, lo = x % 10000;
+    memcpy(out, &digit_pairs[2 * (hi / 100)], 2);
+    memcpy(out + 2, &digit_pairs[2 * (hi % 100)], 2);
+    memcpy(out + 4, &digit_pairs[2 * (lo / 100)], 2);
+    memcpy(out + 6, &digit_pairs[2 * (lo % 100)], 2);
+}
+
+// Writes exactly `digits` digits of x (zero padded), eight at a time from
+// the right and then two at a time
+static inline void write_digits_u64(char* out, uint64_t x, int digits) {
+    char* p = out + digits;
+    while (p - out >= 8) {
+        p -= 8;
+        write_8_digits(p, (uint32_t)(x % 100000000));
+        x /= 100000000;
+    }
+    uint32_t y = (uint32_t)x;
+    while (p - out >= 2) {
+        p -= 2;
+        memcpy(p, &digit_pairs[2 * (y % 100)], 2);
+        y /= 100;
+    }
+    if (p > out) *--p = (char)('0' + y);
+}
+
+// x mod 10^19 for a little-endian limb array, dividing x in place
+static inline uint64_t divrem_pow10_19(uint64_t* x, int len) {
+    uint64_t rem = 0;
+    for (int i = len - 1; i >= 0; i--) {
+        x[i] = div_2by1_preinv(rem, x[i], POW10_19, POW10_19_RECIP, &rem);
+    }
+    return rem;
+}
+
+// Formats n into buffer and returns the number of characters written
+// (excluding the terminator), or 0 with an empty string if it does not fit.
+size_t int256_to_decimal(const Int256 n, char* buffer, size_t buffer_size) {
+    if (buffer_size < 2) {
+        if (buffer_size) buffer[0] = '\0';
+        return 0;
+    }
+    
+    uint64_t l[4];
+    int256_to_limbs(&n, l);
+    int len = limbs_len(l, 4);
+    
+    // The length is known before any division
+    int neg = n.sign && len != 0;
+    size_t total = (size_t)neg + (size_t)(len ? ilog10_limbs(l, len) + 1 : 1);
+    if (total + 1 > buffer_size) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    
+    // Split the magnitude into base-10^19 chunks, least significant first.
+    // Above 2^128 one division by 10^38 splits the value into two halves
+    // whose chunks no longer depend on each other.
+    uint64_t chunk[5];
+    int chunks = 0;
+    
+    if (len <= 1) {
+        chunk[chunks++] = l[0];
+    } else {
+        uint64_t hi[3] = {0, 0, 0}, lo[2] = {l[0], l[1]};
+        int hi_len = 0;
+        if (len > 2) {
+            uint64_t q[4], r[4];
+            divider_divmod_limbs(&pow10_38_divider, l, 4, q, r);
+            memcpy(hi, q, sizeof(hi));
+            memcpy(lo, r, sizeof(lo));
+            hi_len = limbs_len(hi, 3);
+        }
+        uint64_t lo_q;
+        chunk[0] = 0;
+        lo_q = div_2by1_preinv(lo[1] % POW10_19, lo[0], POW10_19, POW10_19_RECIP, &chunk[0]);
+        if (lo[1] >= POW10_19) {
+            // Only possible below 2^128 (no 10^38 split): quotient needs two limbs
+            uint64_t q[2] = {lo_q, 1};
+            chunk[1] = divrem_pow10_19(q, 2);
+            chunks = 2;
+            if (q[0]) chunk[chunks++] = q[0];
+        } else {
+            chunk[1] = lo_q;
+            chunks = 2;
+            if (hi_len) {
+                chunk[chunks++] = divrem_pow10_19(hi, hi_len);
+                hi_len = limbs_len(hi, hi_len);
+                if (hi_len) {
+                    chunk[chunks++] = divrem_pow10_19(hi, hi_len);
+                    if (hi[0]) chunk[chunks++] = hi[0];
+                }
+            }
+        }
+        while (chunks > 1 && chunk[chunks - 1] == 0) chunks--;
+    }
+    
+    int top_digits = (int)(total - (size_t)neg) - 19 * (chunks - 1);
+    
+    char* p = buffer;
+    if (neg) *p++ = '-';
+    write_digits_u64(p, chunk[chunks - 1], top_digits);
+    p += top_digits;
+    for (int i = chunks - 2; i >= 0; i--) {
+        write_digits_u64(p, chunk[i], 19);
+        p += 19;
+    }
+    *p = '\0';
+    return total;
+}
+
+// ==================== POWER AND FACTORIAL (FIXED) ====================
+
+// r = a * b, or a^2 when b is NULL, keeping the low 256 bits. With track
+// set the full product is formed and a nonzero high half is reported.
+static inline int pow_step(uint64_t r[4], const uint64_t a[4], const uint64_t* b, int track) {
+    if (!track) {
+        if (b) {
+            mullo_limbs_4x4(r, a, b);
+        } else {
+            sqrlo_limbs_4(r, a);
+        }
+        return 0;
+    }
+    uint64_t t[8];
+    if (b) {
+        mul_limbs_4x4(t, a, b);
+    } else {
+        sqr_limbs_4(t, a);
+    }
+    memcpy(r, t, 4 * sizeof(uint64_t));
+    return (t[4] | t[5] | t[6] | t[7]) != 0;
+}
+
+// |x|^exp modulo 2^256 into r; returns nonzero if the true power exceeds
+// 256 bits. A b-bit base gives a power of (b-1)*exp + 1 to b*exp bits, so
+// overflow is decided from the bit length up front and the high halves of
+// the products are only computed when that range straddles 256 bits.
+int pow_limbs(uint64_t r[4], const uint64_t x[4], unsigned int exp) {
+    int bits = limbs_bits(x, 4);
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (exp == 0 || bits == 1) {
+        r[0] = 1;
+        return 0;
+    }
+    if (bits == 0) return 0;
+    
+    uint64_t min_bits = (uint64_t)(bits - 1) * exp + 1;
+    uint64_t max_bits = (uint64_t)bits * exp;
+    
+    // 2^k: a shift
+    if (__builtin_popcountll(x[0]) + __builtin_popcountll(x[1]) +
+        __builtin_popcountll(x[2]) + __builtin_popcountll(x[3]) == 1) {
+        uint64_t shift = min_bits - 1;
+        if (shift >= 256) return 1;
+        r[shift / 64] = 1ULL << (shift % 64);
+        return 0;
+    }
+    
+    // Small powers in machine words (10^k up to k = 38 for scale factors)
+    if (max_bits <= 64) {
+        uint64_t b = x[0], p = 1;
+        for (;;) {
+            if (exp & 1) p *= b;
+            if ((exp >>= 1) == 0) break;
+            b *= b;
+        }
+        r[0] = p;
+        return 0;
+    }
+    if (max_bits <= 128) {
+        __uint128_t b = ((__uint128_t)x[1] << 64) | x[0], p = 1;
+        for (;;) {
+            if (exp & 1) p *= b;
+            if ((exp >>= 1) == 0) break;
+            b *= b;
+        }
+        r[0] = (uint64_t)p;
+        r[1] = (uint64_t)(p >> 64);
+        return 0;
+    }
+    
+    int overflow = min_bits > 256;
+    int track = !overflow && max_bits > 256;
+    
+    // Left-to-right square-and-multiply. A window table only saves
+    // products on exponents long enough that every base above 2 overflows.
+    int shift = 31 - __builtin_clz(exp);
+    memcpy(r, x, 4 * sizeof(uint64_t));
+    while (--shift >= 0) {
+        overflow |= pow_step(r, r, NULL, track);
+        if ((exp >> shift) & 1) overflow |= pow_step(r, r, x, track);
+    }
+    return overflow;
+}
+
+// base^exp modulo 2^256 (sign of base for odd exp); see pow_int256_checked
+Int256 pow_int256(Int256 base, unsigned int exp) {
+    uint64_t x[4], r[4];
+    int256_to_limbs(&base, x);
+    pow_limbs(r, x, exp);
+    return limbs_to_int256(r, base.sign & exp & 1);
+}
+
+// n! modulo 2^256 (wraps from 58! on); see factorial_int256_checked
+Int256 factorial_int256(unsigned int n) {
+    if (n < FACTORIAL_TABLE_SIZE) return factorial_table[n];
+    
+    // Past the table only the wrapped value is left, and it sticks at zero
+    // once n! has 256 factors of two
+    uint64_t acc[4];
+    int256_to_limbs(&factorial_table[FACTORIAL_TABLE_SIZE - 1], acc);
+    for (unsigned int i = FACTORIAL_TABLE_SIZE; i <= n && (acc[0] | acc[1] | acc[2] | acc[3]); i++) {
+        mul_add_limbs(acc, i, 0);
+    }
+    return limbs_to_int256(acc, 0);
+}
+
+// n * (n-1) * ... * (n-k+1). Consecutive terms are packed into one 64-bit
+// word while their product fits, so the 256-bit accumulator takes about one
+// multiply per 64 bits of result.
+Int256Status falling_factorial_int256(unsigned int n, unsigned int k, Int256* out) {
+    uint64_t acc[4] = {1, 0, 0, 0};
+    *out = (Int256){{0, 0, 0, 0}, 0};
+    if (k > n) return INT256_OK;   // one of the terms is zero
+    
+    uint64_t word = 1;
+    for (unsigned int i = 0; i < k; i++) {
+        uint64_t term = (uint64_t)(n - i), packed;
+        if (__builtin_mul_overflow(word, term, &packed)) {
+            if (mul_add_limbs(acc, word, 0) != 0) return INT256_ERR_OVERFLOW;
+            packed = term;
+        }
+        word = packed;
+    }
+    if (mul_add_limbs(acc, word, 0) != 0) return INT256_ERR_OVERFLOW;
+    *out = limbs_to_int256(acc, 0);
+    return INT256_OK;
+}
+
+// C(n, k) built up as C(m+j, j) for m = n - k and j = 1..k, where each step
+// multiplies by (m+j) and divides by j exactly. Runs of numerator and
+// denominator terms are packed into single words, so a step costs one
+// 4x1 multiply and one 5-limb division by a word. C(m+j, j) grows with j,
+// so the first intermediate past 256 bits means the result overflows.
+Int256Status binomial_int256(unsigned int n, unsigned int k, Int256* out) {
+    uint64_t acc[4] = {1, 0, 0, 0};
+    *out = (Int256){{0, 0, 0, 0}, 0};
+    if (k > n) return INT256_OK;
+    if (k > n - k) k = n - k;
+    
+    uint64_t m = n - k;
+    unsigned int j = 1;
+    while (j <= k) {
+        uint64_t num = m + j, den = j, next;
+        for (j++; j <= k && !__builtin_mul_overflow(num, m + j, &next); j++) {
+            num = next;
+            den *= j;   // den <= num
+        }
+        
+        uint64_t top = mul_add_limbs(acc, num, 0), rem;
+        if (top >= den) return INT256_ERR_OVERFLOW;
+        rem = top;
+        for (int i = 3; i >= 0; i--) acc[i] = udiv128_64(rem, acc[i], den, &rem);
+    }
+    *out = limbs_to_int256(acc, 0);
+    return INT256_OK;
+}
+
+// ==================== CHECKED, WRAPPING AND SATURATING VARIANTS ====================
+//
+// None of these print. _checked returns a status and stores the wrapped
+// result in *out; _wrapping keeps the low 256 bits of the magnitude (what
+// the plain functions do); _saturating clamps to +/-(2^256 - 1).
+
+static const Int256 INT256_MAX_MAGNITUDE = {{UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX}, 0};
+
+static inline Int256 saturate_int256(int sign) {
+    Int256 r = INT256_MAX_MAGNITUDE;
+    r.sign = sign;
+    return r;
+}
+
+Int256Status add_int256_checked(Int256 a, Int256 b, Int256* out) {
+    int overflow;
+    *out = add_int256_core(a, b, &overflow);
+    return overflow ? INT256_ERR_OVERFLOW : INT256_OK;
+}
+
+Int256 add_int256_wrapping(Int256 a, Int256 b) {
+    return add_int256(a, b);
+}
+
+Int256 add_int256_saturating(Int256 a, Int256 b) {
+    Int256 r;
+    return add_int256_checked(a, b, &r) == INT256_OK ? r : saturate_int256(a.sign);
+}
+
+Int256Status sub_int256_checked(Int256 a, Int256 b, Int256* out) {
+    b.sign = !b.sign;
+    return add_int256_checked(a, b, out);
+}
+
+Int256 sub_int256_wrapping(Int256 a, Int256 b) {
+    return sub_int256(a, b);
+}
+
+Int256 sub_int256_saturating(Int256 a, Int256 b) {
+    b.sign = !b.sign;
+    return add_int256_saturating(a, b);
+}
+
+Int256Status mul_int256_checked(Int256 a, Int256 b, Int256* out) {
+    int overflow;
+    *out = mul_int256_core(a, b, &overflow);
+    return overflow ? INT256_ERR_OVERFLOW : INT256_OK;
+}
+
+Int256 mul_int256_wrapping(Int256 a, Int256 b) {
+    return mul_int256(a, b);
+}
+
+Int256 mul_int256_saturating(Int256 a, Int256 b) {
+    Int256 r;
+    return mul_int256_checked(a, b, &r) == INT256_OK ? r : saturate_int256(a.sign ^ b.sign);
+}
+
+// Division cannot overflow; the only error is a zero divisor
+Int256Status divmod_int256_checked(Int256 a, Int256 b, Int256* quotient, Int256* remainder) {
+    Int256 q = divmod_int256(a, b, remainder);
+    if (quotient) *quotient = q;
+    return is_zero_int256(b) ? INT256_ERR_DIV_BY_ZERO : INT256_OK;
+}
+
+Int256Status div_int256_checked(Int256 a, Int256 b, Int256* out) {
+    return divmod_int256_checked(a, b, out, NULL);
+}
+
+Int256 div_int256_wrapping(Int256 a, Int256 b) {
+    return div_int256(a, b);
+}
+
+// x / 0 saturates towards the sign of x; 0 / 0 is 0
+Int256 div_int256_saturating(Int256 a, Int256 b) {
+    if (is_zero_int256(b)) {
+        return is_zero_int256(a) ? b : saturate_int256(a.sign);
+    }
+    return div_int256(a, b);
+}
+
+Int256Status mod_int256_checked(Int256 a, Int256 b, Int256* out) {
+    return divmod_int256_checked(a, b, NULL, out);
+}
+
+Int256 mod_int256_wrapping(Int256 a, Int256 b) {
+    return mod_int256(a, b);
+}
+
+// x % 0 has no meaningful bound; it is 0 like the wrapping variant
+Int256 mod_int256_saturating(Int256 a, Int256 b) {
+    return mod_int256(a, b);
+}
+
+Int256Status pow_int256_checked(Int256 base, unsigned int exp, Int256* out) {
+    uint64_t x[4], r[4];
+    int256_to_limbs(&base, x);
+    int overflow = pow_limbs(r, x, exp);
+    *out = limbs_to_int256(r, base.sign & exp & 1);
+    return overflow ? INT256_ERR_OVERFLOW : INT256_OK;
+}
+
+Int256 pow_int256_wrapping(Int256 base, unsigned int exp) {
+    return pow_int256(base, exp);
+}
+
+Int256 pow_int256_saturating(Int256 base, unsigned int exp) {
+    Int256 r;
+    return pow_int256_checked(base, exp, &r) == INT256_OK ? r : saturate_int256(base.sign & exp & 1);
+}
+
+Int256Status factorial_int256_checked(unsigned int n, Int256* out) {
+    *out = factorial_int256(n);
+    return n < FACTORIAL_TABLE_SIZE ? INT256_OK : INT256_ERR_OVERFLOW;
+}
+
+Int256 factorial_int256_wrapping(unsigned int n) {
+    return factorial_int256(n);
+}
+
+Int256 factorial_int256_saturating(unsigned int n) {
+    Int256 r;
+    return factorial_int256_checked(n, &r) == INT256_OK ? r : INT256_MAX_MAGNITUDE;
+}
+
+Int256 str_to_int256_wrapping(const char* str) {
+    return str_to_int256(str);
+}
+
+Int256 str_to_int256_saturating(const char* str) {
+    Int256 r;
+    if (parse_int256(str, strlen(str), &r, NULL) != INT256_ERR_OVERFLOW) return r;
+    while (isspace((unsigned char)*str)) str++;
+    return saturate_int256(*str == '-');
+}
+
+// ==================== TWO'S COMPLEMENT CONVERSIONS ====================
+
+UInt256 mul_uint256(UInt256 a, UInt256 b) {
+    uint64_t x[4] = {a.part[3], a.part[2], a.part[1], a.part[0]};
+    uint64_t y[4] = {b.part[3], b.part[2], b.part[1], b.part[0]};
+    uint64_t r[4];
+    mullo_limbs_4x4(r, x, y);
+    UInt256 out = {{r[3], r[2], r[1], r[0]}};
+    return out;
+}
+
+// Magnitude of a (sign dropped)
+UInt256 int256_to_uint256(Int256 a) {
+    UInt256 r;
+    memcpy(r.part, a.part, sizeof(r.part));
+    return r;
+}
+
+Int256 uint256_to_int256(UInt256 a) {
+    Int256 r;
+    memcpy(r.part, a.part, sizeof(r.part));
+    r.sign = 0;
+    return r;
+}
+
+// Two's complement of a. Returns 1 (and the value modulo 2^256) when a is
+// outside [-2^255, 2^255 - 1], otherwise 0.
+int int256_to_sint256(Int256 a, SInt256* out) {
+    UInt256 mag = int256_to_uint256(a);
+    int top = (int)(mag.part[0] >> 63);
+    *out = bits_sint256(mag);
+    if (a.sign) {
+        *out = neg_sint256(*out);
+        // -2^255 is the only negative value with the top bit set in |a|
+        return top && !(mag.part[0] == 0x8000000000000000ULL &&
+                        mag.part[1] == 0 && mag.part[2] == 0 && mag.part[3] == 0);
+    }
+    return top;
+}
+
+Int256 sint256_to_int256(SInt256 a) {
+    int negative = is_negative_sint256(a);
+    Int256 r = uint256_to_int256(sint256_bits(negative ? neg_sint256(a) : a));
+    r.sign = negative;
+    return r;
+}
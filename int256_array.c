@@ -0,0 +1,309 @@
+// libcalc256: element-wise array operations with AVX2 / AVX-512 kernels.
+
+#include "calc256_internal.h"
+
+// ==================== ARRAY OPERATIONS ====================
+//
+// Element-wise operations over arrays of Int256 with the same results as
+// the scalar functions, but without any printing: the _n functions return
+// how many elements overflowed (those results wrap like the scalar ones).
+// Add, subtract and compare work on blocks transposed into limb planes
+// (structure of arrays) and use AVX2 or AVX-512 kernels when the CPU has
+// them; the kernel is chosen once at load time by a constructor.
+
+#define VEC_BLOCK 64
+
+typedef struct {
+    uint64_t limb[4][VEC_BLOCK];   // limb[0] = least significant plane
+    uint64_t sign[VEC_BLOCK];      // 0 or 1
+} Int256Soa;
+
+typedef struct {
+    uint64_t limb[4][VEC_BLOCK];
+    uint64_t sign[VEC_BLOCK];
+    uint64_t flag[VEC_BLOCK];      // overflow (add/sub) or ordering (cmp)
+} Int256SoaResult;
+
+typedef void (*AddSubKernel)(Int256SoaResult* r, const Int256Soa* a, const Int256Soa* b, size_t n);
+typedef void (*CmpKernel)(Int256SoaResult* r, const Int256Soa* a, const Int256Soa* b, size_t n);
+
+// Fills lanes [0, count) and zero-pads up to `padded`
+static void soa_gather(Int256Soa* s, const Int256* v, size_t count, size_t padded, int flip_sign) {
+    for (size_t i = 0; i < count; i++) {
+        s->limb[0][i] = v[i].part[3];
+        s->limb[1][i] = v[i].part[2];
+        s->limb[2][i] = v[i].part[1];
+        s->limb[3][i] = v[i].part[0];
+        s->sign[i] = (uint64_t)(v[i].sign ^ flip_sign) & 1;
+    }
+    for (size_t i = count; i < padded; i++) {
+        s->limb[0][i] = s->limb[1][i] = s->limb[2][i] = s->limb[3][i] = 0;
+        s->sign[i] = 0;
+    }
+}
+
+static size_t soa_scatter(Int256* v, const Int256SoaResult* r, size_t count) {
+    size_t flagged = 0;
+    for (size_t i = 0; i < count; i++) {
+        v[i].part[3] = r->limb[0][i];
+        v[i].part[2] = r->limb[1][i];
+        v[i].part[1] = r->limb[2][i];
+        v[i].part[0] = r->limb[3][i];
+        v[i].sign = (int)r->sign[i];
+        flagged += r->flag[i] != 0;
+    }
+    return flagged;
+}
+
+// Sign-magnitude add without branches: both |a|+|b| and |a|-|b| are
+// computed and the right one selected. Returns 1 on overflow.
+static inline int addsub_one(Int256* r, const Int256* a, const Int256* b, int subtract) {
+    uint64_t x[4], y[4], sum[4], diff[4], carry = 0, borrow = 0;
+    int256_to_limbs(a, x);
+    int256_to_limbs(b, y);
+    for (int j = 0; j < 4; j++) {
+        sum[j] = add_with_carry(x[j], y[j], &carry);
+        diff[j] = sub_with_borrow(x[j], y[j], &borrow);
+    }
+    // |b| > |a|: negate the difference
+    int sign_b = b->sign ^ subtract;
+    uint64_t same = 0 - (uint64_t)(a->sign == sign_b);
+    uint64_t flip = (0 - borrow) & ~same;
+    uint64_t neg_borrow = 0, v[4];
+    for (int j = 0; j < 4; j++) {
+        uint64_t neg = sub_with_borrow(0, diff[j], &neg_borrow);
+        v[j] = (same & sum[j]) | (~same & ((flip & neg) | (~flip & diff[j])));
+    }
+    *r = limbs_to_int256(v, flip ? sign_b : a->sign);
+    return (int)(same & carry);
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+// Unsigned 64-bit x < y, as an all-ones lane mask
+static inline AVX2_TARGET __m256i avx2_ltu(__m256i x, __m256i y) {
+    const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(y, bias), _mm256_xor_si256(x, bias));
+}
+
+static AVX2_TARGET void addsub_kernel_avx2(Int256SoaResult* r, const Int256Soa* a,
+                                           const Int256Soa* b, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 4) {
+        __m256i sum[4], diff[4];
+        __m256i carry = zero, borrow = zero;   // all-ones lanes where set
+        for (int j = 0; j < 4; j++) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)&a->limb[j][i]);
+            __m256i y = _mm256_loadu_si256((const __m256i*)&b->limb[j][i]);
+            
+            __m256i s = _mm256_add_epi64(x, y);
+            __m256i c1 = avx2_ltu(s, x);
+            __m256i s2 = _mm256_sub_epi64(s, carry);
+            carry = _mm256_or_si256(c1, _mm256_and_si256(carry, _mm256_cmpeq_epi64(s2, zero)));
+            sum[j] = s2;
+            
+            __m256i d = _mm256_sub_epi64(x, y);
+            __m256i b1 = avx2_ltu(x, y);
+            __m256i d2 = _mm256_add_epi64(d, borrow);
+            borrow = _mm256_or_si256(b1, _mm256_and_si256(borrow, _mm256_cmpeq_epi64(d, zero)));
+            diff[j] = d2;
+        }
+        
+        __m256i sa = _mm256_loadu_si256((const __m256i*)&a->sign[i]);
+        __m256i sb = _mm256_loadu_si256((const __m256i*)&b->sign[i]);
+        __m256i same = _mm256_cmpeq_epi64(sa, sb);
+        __m256i flip = _mm256_andnot_si256(same, borrow);
+        __m256i nb = zero, nz = zero;
+        for (int j = 0; j < 4; j++) {
+            __m256i neg = _mm256_add_epi64(_mm256_sub_epi64(zero, diff[j]), nb);
+            nb = _mm256_or_si256(nb, _mm256_xor_si256(_mm256_cmpeq_epi64(diff[j], zero), _mm256_set1_epi64x(-1)));
+            __m256i v = _mm256_blendv_epi8(_mm256_blendv_epi8(diff[j], neg, flip), sum[j], same);
+            _mm256_storeu_si256((__m256i*)&r->limb[j][i], v);
+            nz = _mm256_or_si256(nz, v);
+        }
+        __m256i sign = _mm256_blendv_epi8(sa, sb, flip);
+        sign = _mm256_andnot_si256(_mm256_cmpeq_epi64(nz, zero), sign);
+        _mm256_storeu_si256((__m256i*)&r->sign[i], sign);
+        _mm256_storeu_si256((__m256i*)&r->flag[i], _mm256_and_si256(same, carry));
+    }
+}
+
+static AVX2_TARGET void cmp_kernel_avx2(Int256SoaResult* r, const Int256Soa* a,
+                                        const Int256Soa* b, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    for (size_t i = 0; i < n; i += 4) {
+        __m256i gt = zero, lt = zero;
+        for (int j = 3; j >= 0; j--) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)&a->limb[j][i]);
+            __m256i y = _mm256_loadu_si256((const __m256i*)&b->limb[j][i]);
+            __m256i undecided = _mm256_xor_si256(_mm256_or_si256(gt, lt), _mm256_set1_epi64x(-1));
+            gt = _mm256_or_si256(gt, _mm256_and_si256(undecided, avx2_ltu(y, x)));
+            lt = _mm256_or_si256(lt, _mm256_and_si256(undecided, avx2_ltu(x, y)));
+        }
+        // Magnitude order as -1/0/1, then apply the signs
+        __m256i c = _mm256_sub_epi64(lt, gt);
+        __m256i sa = _mm256_loadu_si256((const __m256i*)&a->sign[i]);
+        __m256i sb = _mm256_loadu_si256((const __m256i*)&b->sign[i]);
+        __m256i neg_a = _mm256_cmpeq_epi64(sa, _mm256_set1_epi64x(1));
+        c = _mm256_blendv_epi8(c, _mm256_sub_epi64(zero, c), neg_a);
+        __m256i by_sign = _mm256_blendv_epi8(_mm256_set1_epi64x(1), _mm256_set1_epi64x(-1), neg_a);
+        c = _mm256_blendv_epi8(by_sign, c, _mm256_cmpeq_epi64(sa, sb));
+        _mm256_storeu_si256((__m256i*)&r->flag[i], c);
+    }
+}
+
+static AVX512_TARGET void addsub_kernel_avx512(Int256SoaResult* r, const Int256Soa* a,
+                                               const Int256Soa* b, size_t n) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+    for (size_t i = 0; i < n; i += 8) {
+        __m512i sum[4], diff[4];
+        __mmask8 carry = 0, borrow = 0;
+        for (int j = 0; j < 4; j++) {
+            __m512i x = _mm512_loadu_si512(&a->limb[j][i]);
+            __m512i y = _mm512_loadu_si512(&b->limb[j][i]);
+            
+            __m512i s = _mm512_add_epi64(x, y);
+            __mmask8 c1 = _mm512_cmplt_epu64_mask(s, x);
+            sum[j] = _mm512_mask_add_epi64(s, carry, s, one);
+            carry = c1 | (carry & _mm512_cmpeq_epu64_mask(sum[j], zero));
+            
+            __m512i d = _mm512_sub_epi64(x, y);
+            __mmask8 b1 = _mm512_cmplt_epu64_mask(x, y);
+            diff[j] = _mm512_mask_sub_epi64(d, borrow, d, one);
+            borrow = b1 | (borrow & _mm512_cmpeq_epu64_mask(d, zero));
+        }
+        
+        __m512i sa = _mm512_loadu_si512(&a->sign[i]);
+        __m512i sb = _mm512_loadu_si512(&b->sign[i]);
+        __mmask8 same = _mm512_cmpeq_epu64_mask(sa, sb);
+        __mmask8 flip = (__mmask8)(~same & borrow);
+        __mmask8 nb = 0, nz = 0;
+        for (int j = 0; j < 4; j++) {
+            __m512i neg = _mm512_mask_sub_epi64(_mm512_sub_epi64(zero, diff[j]), nb,
+                                                _mm512_sub_epi64(zero, diff[j]), one);
+            nb |= _mm512_cmpneq_epu64_mask(diff[j], zero);
+            __m512i v = _mm512_mask_blend_epi64(same, _mm512_mask_blend_epi64(flip, diff[j], neg), sum[j]);
+            _mm512_storeu_si512(&r->limb[j][i], v);
+            nz |= _mm512_cmpneq_epu64_mask(v, zero);
+        }
+        __m512i sign = _mm512_maskz_mov_epi64(nz, _mm512_mask_blend_epi64(flip, sa, sb));
+        _mm512_storeu_si512(&r->sign[i], sign);
+        _mm512_storeu_si512(&r->flag[i], _mm512_maskz_mov_epi64(same & carry, one));
+    }
+}
+
+static AVX512_TARGET void cmp_kernel_avx512(Int256SoaResult* r, const Int256Soa* a,
+                                            const Int256Soa* b, size_t n) {
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i minus_one = _mm512_set1_epi64(-1);
+    for (size_t i = 0; i < n; i += 8) {
+        __mmask8 gt = 0, lt = 0;
+        for (int j = 3; j >= 0; j--) {
+            __m512i x = _mm512_loadu_si512(&a->limb[j][i]);
+            __m512i y = _mm512_loadu_si512(&b->limb[j][i]);
+            __mmask8 undecided = (__mmask8)~(gt | lt);
+            gt |= undecided & _mm512_cmpgt_epu64_mask(x, y);
+            lt |= undecided & _mm512_cmplt_epu64_mask(x, y);
+        }
+        __m512i sa = _mm512_loadu_si512(&a->sign[i]);
+        __m512i sb = _mm512_loadu_si512(&b->sign[i]);
+        __mmask8 neg_a = _mm512_cmpeq_epu64_mask(sa, one);
+        __mmask8 same = _mm512_cmpeq_epu64_mask(sa, sb);
+        // Within equal signs a negative pair reverses the magnitude order
+        __mmask8 pos = (__mmask8)((gt & ~neg_a) | (lt & neg_a));
+        __mmask8 negv = (__mmask8)((lt & ~neg_a) | (gt & neg_a));
+        pos = (__mmask8)((pos & same) | (~same & ~neg_a));
+        negv = (__mmask8)((negv & same) | (~same & neg_a));
+        __m512i c = _mm512_maskz_mov_epi64(pos, one);
+        c = _mm512_mask_mov_epi64(c, negv, minus_one);
+        _mm512_storeu_si512(&r->flag[i], c);
+    }
+}
+#endif
+
+static AddSubKernel addsub_kernel;
+static CmpKernel cmp_kernel;
+static size_t kernel_lanes = 1;
+
+// Chosen once at load time, before any thread can call in. Leaves the
+// kernels NULL (plain per-element loops) without AVX2.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+__attribute__((constructor)) static void select_array_kernels(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        addsub_kernel = addsub_kernel_avx512;
+        cmp_kernel = cmp_kernel_avx512;
+        kernel_lanes = 8;
+    } else if (__builtin_cpu_supports("avx2")) {
+        addsub_kernel = addsub_kernel_avx2;
+        cmp_kernel = cmp_kernel_avx2;
+        kernel_lanes = 4;
+    }
+}
+#endif
+
+static size_t addsub_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n, int subtract) {
+    Int256Soa sa, sb;
+    Int256SoaResult sr;
+    size_t overflowed = 0;
+    
+    if (addsub_kernel == NULL) {
+        for (size_t i = 0; i < n; i++) overflowed += (size_t)addsub_one(&dst[i], &a[i], &b[i], subtract);
+        return overflowed;
+    }
+    for (size_t i = 0; i < n; i += VEC_BLOCK) {
+        size_t count = n - i < VEC_BLOCK ? n - i : VEC_BLOCK;
+        size_t padded = (count + kernel_lanes - 1) / kernel_lanes * kernel_lanes;
+        soa_gather(&sa, a + i, count, padded, 0);
+        soa_gather(&sb, b + i, count, padded, subtract);
+        addsub_kernel(&sr, &sa, &sb, padded);
+        overflowed += soa_scatter(dst + i, &sr, count);
+    }
+    return overflowed;
+}
+
+// dst[i] = a[i] + b[i]; dst may alias a or b
+size_t add_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n) {
+    return addsub_int256_n(dst, a, b, n, 0);
+}
+
+size_t sub_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n) {
+    return addsub_int256_n(dst, a, b, n, 1);
+}
+
+// dst[i] = cmp_int256(a[i], b[i])
+void cmp_int256_n(int* dst, const Int256* a, const Int256* b, size_t n) {
+    Int256Soa sa, sb;
+    Int256SoaResult sr;
+    
+    if (cmp_kernel == NULL) {
+        for (size_t i = 0; i < n; i++) dst[i] = cmp_int256(a[i], b[i]);
+        return;
+    }
+    for (size_t i = 0; i < n; i += VEC_BLOCK) {
+        size_t count = n - i < VEC_BLOCK ? n - i : VEC_BLOCK;
+        size_t padded = (count + kernel_lanes - 1) / kernel_lanes * kernel_lanes;
+        soa_gather(&sa, a + i, count, padded, 0);
+        soa_gather(&sb, b + i, count, padded, 0);
+        cmp_kernel(&sr, &sa, &sb, padded);
+        for (size_t k = 0; k < count; k++) dst[i + k] = (int)(int64_t)sr.flag[k];
+    }
+}
+
+// dst[i] = a[i] * b[i]. There is no 64x64->128 vector multiply in AVX2 or
+// AVX-512F, so this runs the scalar kernel per element, without printing.
+size_t mul_int256_n(Int256* dst, const Int256* a, const Int256* b, size_t n) {
+    size_t overflowed = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x[4], y[4], t[8];
+        int256_to_limbs(&a[i], x);
+        int256_to_limbs(&b[i], y);
+        mul_limbs_4x4(t, x, y);
+        overflowed += (t[4] | t[5] | t[6] | t[7]) != 0;
+        dst[i] = limbs_to_int256(t, a[i].sign ^ b[i].sign);
+    }
+    return overflowed;
+}
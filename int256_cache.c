@@ -0,0 +1,212 @@
+// libcalc256: bounded memo table for division, powers and decimal output.
+
+#include <stdlib.h>
+
+#include "calc256_internal.h"
+
+// ==================== RESULT CACHE ====================
+//
+// Linear probing over a power-of-two slot array kept at most half full.
+// Every entry carries a CLOCK reference bit that hits set; once the table
+// holds capacity entries, the hand sweeps the slots clearing set bits and
+// evicts the first entry whose bit was already clear. Removal shifts the
+// rest of the probe run back, so lookups never meet tombstones.
+
+#define CACHE_MIN_CAPACITY 16                  // smallest slot array is twice this
+#define CACHE_MAX_CAPACITY ((size_t)1 << 28)   // slot index must fit the 32-bit hash
+
+enum { CACHE_EMPTY, CACHE_DIV, CACHE_MOD, CACHE_POW, CACHE_DECIMAL };
+
+typedef struct {
+    uint64_t a[4];          // operands, most significant limb first
+    uint64_t b[4];
+    union {
+        Int256 value;
+        char text[80];      // decimal string, NUL-terminated
+    } result;
+    uint32_t hash;
+    uint8_t op;             // CACHE_EMPTY marks a free slot
+    uint8_t signs;          // bit 0: sign of a, bit 1: sign of b
+    uint8_t status;         // Int256Status of the cached call, or the text length
+    uint8_t referenced;     // CLOCK bit
+} CacheEntry;
+
+struct Int256Cache {
+    CacheEntry* slots;
+    size_t mask;            // slot count - 1
+    size_t capacity;        // entries kept before evicting
+    size_t entries;
+    size_t hand;            // CLOCK position
+    uint64_t hits, misses, evictions;
+};
+
+Int256Cache* cache_create_int256(size_t capacity) {
+    if (capacity < 1) capacity = 1;
+    if (capacity > CACHE_MAX_CAPACITY) capacity = CACHE_MAX_CAPACITY;
+    // The slot array is the next power of two, twice over
+    size_t cap = CACHE_MIN_CAPACITY;
+    while (cap < capacity) cap *= 2;
+    Int256Cache* cache = calloc(1, sizeof(*cache));
+    if (cache == NULL) return NULL;
+    cache->slots = calloc(2 * cap, sizeof(CacheEntry));
+    if (cache->slots == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->mask = 2 * cap - 1;
+    cache->capacity = capacity;
+    return cache;
+}
+
+void cache_free_int256(Int256Cache* cache) {
+    if (cache == NULL) return;
+    free(cache->slots);
+    free(cache);
+}
+
+void cache_clear_int256(Int256Cache* cache) {
+    memset(cache->slots, 0, (cache->mask + 1) * sizeof(CacheEntry));
+    cache->entries = 0;
+    cache->hand = 0;
+    cache->hits = cache->misses = cache->evictions = 0;
+}
+
+void cache_stats_int256(const Int256Cache* cache, Int256CacheStats* stats) {
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->entries = cache->entries;
+    stats->capacity = cache->capacity;
+}
+
+static uint32_t cache_hash(int op, const Int256* a, const Int256* b) {
+    uint64_t h = (uint64_t)op * 0x9e3779b97f4a7c15ULL ^ (uint64_t)(a->sign | b->sign << 1);
+    for (int i = 0; i < 4; i++) {
+        h = (h ^ a->part[i]) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 29;
+        h = (h ^ b->part[i]) * 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 32;
+    }
+    return (uint32_t)h;
+}
+
+static inline int cache_key_equal(const CacheEntry* e, int op, const Int256* a, const Int256* b) {
+    return e->op == op && e->signs == (a->sign | b->sign << 1) &&
+           memcmp(e->a, a->part, sizeof(e->a)) == 0 && memcmp(e->b, b->part, sizeof(e->b)) == 0;
+}
+
+static CacheEntry* cache_find(Int256Cache* cache, int op, const Int256* a, const Int256* b,
+                              uint32_t hash) {
+    for (size_t i = hash & cache->mask;; i = (i + 1) & cache->mask) {
+        CacheEntry* e = &cache->slots[i];
+        if (e->op == CACHE_EMPTY) return NULL;
+        if (e->hash == hash && cache_key_equal(e, op, a, b)) {
+            cache->hits++;
+            e->referenced = 1;
+            return e;
+        }
+    }
+}
+
+// Empties slot i, moving later entries of its probe run back into the gap
+static void cache_remove(Int256Cache* cache, size_t i) {
+    for (size_t j = (i + 1) & cache->mask;; j = (j + 1) & cache->mask) {
+        CacheEntry* e = &cache->slots[j];
+        if (e->op == CACHE_EMPTY) break;
+        // e can fill the gap unless its home slot lies in (i, j]
+        size_t home = e->hash & cache->mask;
+        if (((j - home) & cache->mask) >= ((j - i) & cache->mask)) {
+            cache->slots[i] = *e;
+            i = j;
+        }
+    }
+    cache->slots[i].op = CACHE_EMPTY;
+    cache->entries--;
+}
+
+static void cache_evict(Int256Cache* cache) {
+    for (;;) {
+        CacheEntry* e = &cache->slots[cache->hand];
+        if (e->op != CACHE_EMPTY) {
+            if (!e->referenced) {
+                cache_remove(cache, cache->hand);
+                cache->evictions++;
+                return;
+            }
+            e->referenced = 0;
+        }
+        cache->hand = (cache->hand + 1) & cache->mask;
+    }
+}
+
+// Claims a slot for a key that cache_find just missed. New entries start
+// unreferenced, so values seen only once are the first to go.
+static CacheEntry* cache_insert(Int256Cache* cache, int op, const Int256* a, const Int256* b,
+                                uint32_t hash) {
+    if (cache->entries == cache->capacity) cache_evict(cache);
+    size_t i = hash & cache->mask;
+    while (cache->slots[i].op != CACHE_EMPTY) i = (i + 1) & cache->mask;
+    CacheEntry* e = &cache->slots[i];
+    memcpy(e->a, a->part, sizeof(e->a));
+    memcpy(e->b, b->part, sizeof(e->b));
+    e->hash = hash;
+    e->op = (uint8_t)op;
+    e->signs = (uint8_t)(a->sign | b->sign << 1);
+    e->referenced = 0;
+    cache->entries++;
+    return e;
+}
+
+static Int256Status cache_binary(Int256Cache* cache, int op, Int256 a, Int256 b, Int256* out) {
+    uint32_t hash = cache_hash(op, &a, &b);
+    CacheEntry* e = cache_find(cache, op, &a, &b, hash);
+    if (e) {
+        *out = e->result.value;
+        return (Int256Status)e->status;
+    }
+    cache->misses++;
+
+    Int256Status status;
+    if (op == CACHE_DIV) {
+        status = div_int256_checked(a, b, out);
+    } else if (op == CACHE_MOD) {
+        status = mod_int256_checked(a, b, out);
+    } else {
+        status = pow_int256_checked(a, (unsigned int)b.part[3], out);
+    }
+    e = cache_insert(cache, op, &a, &b, hash);
+    e->result.value = *out;
+    e->status = (uint8_t)status;
+    return status;
+}
+
+Int256Status cache_div_int256(Int256Cache* cache, Int256 a, Int256 b, Int256* out) {
+    return cache_binary(cache, CACHE_DIV, a, b, out);
+}
+
+Int256Status cache_mod_int256(Int256Cache* cache, Int256 a, Int256 b, Int256* out) {
+    return cache_binary(cache, CACHE_MOD, a, b, out);
+}
+
+Int256Status cache_pow_int256(Int256Cache* cache, Int256 base, unsigned int exp, Int256* out) {
+    Int256 e = {{0, 0, 0, exp}, 0};
+    return cache_binary(cache, CACHE_POW, base, e, out);
+}
+
+size_t cache_to_decimal_int256(Int256Cache* cache, Int256 n, char* buffer, size_t buffer_size) {
+    Int256 none = {{0, 0, 0, 0}, 0};
+    uint32_t hash = cache_hash(CACHE_DECIMAL, &n, &none);
+    CacheEntry* e = cache_find(cache, CACHE_DECIMAL, &n, &none, hash);
+    if (e == NULL) {
+        cache->misses++;
+        e = cache_insert(cache, CACHE_DECIMAL, &n, &none, hash);
+        e->status = (uint8_t)int256_to_decimal(n, e->result.text, sizeof(e->result.text));
+    }
+    size_t len = e->status;
+    if (len + 1 > buffer_size) {
+        if (buffer_size > 0) buffer[0] = '\0';
+        return 0;
+    }
+    memcpy(buffer, e->result.text, len + 1);
+    return len;
+}
@@ -0,0 +1,366 @@
+// libcalc256: division (Knuth algorithm D) and division by a prepared
+// invariant divisor.
+
+#include "calc256_internal.h"
+
+// ==================== DIVISION (KNUTH ALGORITHM D) ====================
+
+// Divides u[0..m) by v[0..n) where v[n-1] != 0, m >= n, n <= 4 and m <= 8.
+// Writes m-n+1 quotient limbs to q and n remainder limbs to r (either may be
+// NULL). One 128/64 hardware division plus an n-limb multiply-subtract per
+// quotient limb, instead of one compare-and-subtract per quotient bit.
+void divmod_limbs(uint64_t* q, uint64_t* r,
+                  const uint64_t* u, int m, const uint64_t* v, int n) {
+    if (n == 1) {
+        uint64_t rem = 0;
+        for (int i = m - 1; i >= 0; i--) {
+            uint64_t digit = udiv128_64(rem, u[i], v[0], &rem);
+            if (q) q[i] = digit;
+        }
+        if (r) r[0] = rem;
+        return;
+    }
+    
+    // Normalize so the top divisor limb has its high bit set
+    int s = __builtin_clzll(v[n - 1]);
+    uint64_t vn[4], un[9];
+    for (int i = n - 1; i > 0; i--) {
+        vn[i] = s ? (v[i] << s) | (v[i - 1] >> (64 - s)) : v[i];
+    }
+    vn[0] = v[0] << s;
+    un[m] = s ? u[m - 1] >> (64 - s) : 0;
+    for (int i = m - 1; i > 0; i--) {
+        un[i] = s ? (u[i] << s) | (u[i - 1] >> (64 - s)) : u[i];
+    }
+    un[0] = u[0] << s;
+    
+    for (int j = m - n; j >= 0; j--) {
+        // Estimate the quotient limb from the top two dividend limbs
+        uint64_t qhat, rhat;
+        int rhat_overflow = 0;
+        if (un[j + n] >= vn[n - 1]) {
+            qhat = UINT64_MAX;
+            rhat = un[j + n - 1] + vn[n - 1];
+            rhat_overflow = rhat < vn[n - 1];
+        } else {
+            qhat = udiv128_64(un[j + n], un[j + n - 1], vn[n - 1], &rhat);
+        }
+        while (!rhat_overflow &&
+               (__uint128_t)qhat * vn[n - 2] > (((__uint128_t)rhat << 64) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            rhat_overflow = rhat < vn[n - 1];
+        }
+        
+        // Multiply and subtract qhat * vn from un[j..j+n]
+        uint64_t carry = 0, borrow = 0;
+        for (int i = 0; i < n; i++) {
+            __uint128_t p = (__uint128_t)qhat * vn[i] + carry;
+            carry = (uint64_t)(p >> 64);
+            uint64_t lo = (uint64_t)p;
+            uint64_t t = un[i + j] - lo;
+            uint64_t b1 = un[i + j] < lo;
+            un[i + j] = t - borrow;
+            borrow = b1 | (t < borrow);
+        }
+        uint64_t top = un[j + n];
+        un[j + n] = top - carry - borrow;
+        
+        if (top < carry + borrow) {
+            // qhat was one too large: add the divisor back
+            qhat--;
+            uint64_t c = 0;
+            for (int i = 0; i < n; i++) {
+                un[i + j] = add_with_carry(un[i + j], vn[i], &c);
+            }
+            un[j + n] += c;
+        }
+        if (q) q[j] = qhat;
+    }
+    
+    if (r) {
+        for (int i = 0; i < n - 1; i++) {
+            r[i] = s ? (un[i] >> s) | (un[i + 1] << (64 - s)) : un[i];
+        }
+        r[n - 1] = un[n - 1] >> s;
+    }
+}
+
+// Computes quotient (truncated toward zero) and remainder (sign of the
+// dividend) in one pass. remainder may be NULL. Division by zero gives
+// zero for both; see divmod_int256_checked.
+Int256 divmod_int256(Int256 a, Int256 b, Int256* remainder) {
+    Int256 zero = {{0, 0, 0, 0}, 0};
+    
+    if (is_zero_int256(b)) {
+        if (remainder) *remainder = zero;
+        return zero;
+    }
+    
+    if (cmp_abs_int256(a, b) < 0) {
+        if (remainder) *remainder = a;
+        return zero;
+    }
+    
+    uint64_t u[4], v[4], q[4] = {0, 0, 0, 0}, r[4] = {0, 0, 0, 0};
+    int256_to_limbs(&a, u);
+    int256_to_limbs(&b, v);
+    int m = limbs_len(u, 4);
+    int n = limbs_len(v, 4);
+    
+    if (m == 1) {
+        // Both operands fit in one limb
+        q[0] = u[0] / v[0];
+        r[0] = u[0] % v[0];
+    } else {
+        divmod_limbs(q, r, u, m, v, n);
+    }
+    
+    if (remainder) *remainder = limbs_to_int256(r, a.sign);
+    return limbs_to_int256(q, a.sign ^ b.sign);
+}
+
+Int256 div_int256(Int256 a, Int256 b) {
+    return divmod_int256(a, b, NULL);
+}
+
+Int256 mod_int256(Int256 a, Int256 b) {
+    Int256 remainder;
+    divmod_int256(a, b, &remainder);
+    return remainder;
+}
+
+// ==================== DIVISION BY AN INVARIANT DIVISOR ====================
+//
+// Precomputes a reciprocal of the (normalized) divisor once so that every
+// later division costs multiplications only (Moller & Granlund, "Improved
+// division by invariant integers", 2011). Powers of two become shifts.
+
+// Reciprocal of the normalized two-limb divisor d1:d0
+static uint64_t reciprocal_3by2(uint64_t d1, uint64_t d0) {
+    uint64_t v = reciprocal_word(d1);
+    uint64_t p = d1 * v + d0;
+    if (p < d0) {
+        v--;
+        if (p >= d1) {
+            v--;
+            p -= d1;
+        }
+        p -= d1;
+    }
+    __uint128_t t = (__uint128_t)v * d0;
+    uint64_t t1 = (uint64_t)(t >> 64), t0 = (uint64_t)t;
+    p += t1;
+    if (p < t1) {
+        v--;
+        if (p >= d1 && (p > d1 || t0 >= d0)) v--;
+    }
+    return v;
+}
+
+// (u2:u1:u0) / (d1:d0) for normalized d1 and (u2:u1) < (d1:d0)
+static inline uint64_t div_3by2_preinv(uint64_t u2, uint64_t u1, uint64_t u0,
+                                       uint64_t d1, uint64_t d0, uint64_t v) {
+    __uint128_t q = (__uint128_t)v * u2 + ((((__uint128_t)u2) << 64) | u1);
+    uint64_t q1 = (uint64_t)(q >> 64);
+    uint64_t q0 = (uint64_t)q;
+    uint64_t r1 = u1 - q1 * d1;
+    __uint128_t d = ((__uint128_t)d1 << 64) | d0;
+    __uint128_t r = (((__uint128_t)r1 << 64) | u0) - (__uint128_t)d0 * q1 - d;
+    q1++;
+    if ((uint64_t)(r >> 64) >= q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) q1++;
+    return q1;
+}
+
+// Returns 0 on success, -1 if the divisor is zero
+int divider_init_int256(Int256Divider* dv, Int256 divisor) {
+    uint64_t l[4];
+    int256_to_limbs(&divisor, l);
+    
+    int n = limbs_len(l, 4);
+    if (n == 0) return -1;
+    
+    memset(dv, 0, sizeof(*dv));
+    dv->sign = divisor.sign;
+    dv->n = n;
+    
+    int top_zeros = __builtin_clzll(l[n - 1]);
+    int single_bit = (l[n - 1] & (l[n - 1] - 1)) == 0;
+    for (int i = 0; i < n - 1; i++) {
+        if (l[i] != 0) single_bit = 0;
+    }
+    
+    if (single_bit) {
+        dv->kind = DIVIDER_POW2;
+        dv->shift = 64 * (n - 1) + (63 - top_zeros);
+        return 0;
+    }
+    
+    dv->shift = top_zeros;
+    for (int i = n - 1; i > 0; i--) {
+        dv->d[i] = top_zeros ? (l[i] << top_zeros) | (l[i - 1] >> (64 - top_zeros)) : l[i];
+    }
+    dv->d[0] = l[0] << top_zeros;
+    
+    if (n == 1) {
+        dv->kind = DIVIDER_WORD;
+        dv->v = reciprocal_word(dv->d[0]);
+    } else {
+        dv->kind = DIVIDER_GENERAL;
+        dv->v = reciprocal_3by2(dv->d[n - 1], dv->d[n - 2]);
+    }
+    return 0;
+}
+
+// Divides the len (4 or 8) little-endian limbs u by the prepared divisor
+// into len quotient limbs and 4 remainder limbs
+void divider_divmod_limbs(const Int256Divider* dv, const uint64_t* u, int len,
+                          uint64_t* q, uint64_t r[4]) {
+    int m = limbs_len(u, len);
+    memset(q, 0, len * sizeof(uint64_t));
+    memset(r, 0, 4 * sizeof(uint64_t));
+    
+    if (dv->kind == DIVIDER_POW2) {
+        int ws = dv->shift / 64, bs = dv->shift % 64;
+        for (int i = 0; i < ws; i++) r[i] = u[i];
+        r[ws] = u[ws] & ((1ULL << bs) - 1);
+        for (int i = 0; i + ws < len; i++) {
+            uint64_t hi = (i + ws + 1 < len && bs) ? u[i + ws + 1] << (64 - bs) : 0;
+            q[i] = (u[i + ws] >> bs) | hi;
+        }
+    } else if (m < dv->n) {
+        memcpy(r, u, m * sizeof(uint64_t));
+    } else {
+        // Normalize the dividend into m + 1 limbs
+        int s = dv->shift;
+        uint64_t un[9];
+        un[m] = s ? u[m - 1] >> (64 - s) : 0;
+        for (int i = m - 1; i > 0; i--) {
+            un[i] = s ? (u[i] << s) | (u[i - 1] >> (64 - s)) : u[i];
+        }
+        un[0] = u[0] << s;
+        
+        if (dv->kind == DIVIDER_WORD) {
+            uint64_t rem = un[m];
+            for (int i = m - 1; i >= 0; i--) {
+                q[i] = div_2by1_preinv(rem, un[i], dv->d[0], dv->v, &rem);
+            }
+            r[0] = rem >> s;
+        } else {
+            int n = dv->n;
+            const uint64_t* d = dv->d;
+            uint64_t d1 = d[n - 1], d0 = d[n - 2];
+            
+            for (int j = m - n; j >= 0; j--) {
+                uint64_t n2 = un[j + n], n1 = un[j + n - 1], n0 = un[j + n - 2];
+                uint64_t qhat = (n2 == d1 && n1 == d0)
+                              ? UINT64_MAX
+                              : div_3by2_preinv(n2, n1, n0, d1, d0, dv->v);
+                
+                // qhat is exact or one too large: multiply-subtract, then fix up
+                uint64_t carry = 0, borrow = 0;
+                for (int i = 0; i < n; i++) {
+                    __uint128_t p = (__uint128_t)qhat * d[i] + carry;
+                    carry = (uint64_t)(p >> 64);
+                    uint64_t lo = (uint64_t)p;
+                    uint64_t t = un[i + j] - lo;
+                    uint64_t b1 = un[i + j] < lo;
+                    un[i + j] = t - borrow;
+                    borrow = b1 | (t < borrow);
+                }
+                uint64_t top = un[j + n];
+                un[j + n] = top - carry - borrow;
+                if (top < carry + borrow) {
+                    qhat--;
+                    uint64_t c = 0;
+                    for (int i = 0; i < n; i++) {
+                        un[i + j] = add_with_carry(un[i + j], d[i], &c);
+                    }
+                    un[j + n] += c;
+                }
+                q[j] = qhat;
+            }
+            
+            for (int i = 0; i < n - 1; i++) {
+                r[i] = s ? (un[i] >> s) | (un[i + 1] << (64 - s)) : un[i];
+            }
+            r[n - 1] = un[n - 1] >> s;
+        }
+    }
+    
+}
+
+// Same result as divmod_int256(a, divisor, remainder); remainder may be NULL
+Int256 divider_divmod_int256(const Int256Divider* dv, Int256 a, Int256* remainder) {
+    uint64_t u[4], q[4], r[4];
+    int256_to_limbs(&a, u);
+    divider_divmod_limbs(dv, u, 4, q, r);
+    if (remainder) *remainder = limbs_to_int256(r, a.sign);
+    return limbs_to_int256(q, a.sign ^ dv->sign);
+}
+
+Int256 divider_div_int256(const Int256Divider* dv, Int256 a) {
+    return divider_divmod_int256(dv, a, NULL);
+}
+
+Int256 divider_mod_int256(const Int256Divider* dv, Int256 a) {
+    Int256 remainder;
+    divider_divmod_int256(dv, a, &remainder);
+    return remainder;
+}
+
+// ==================== MULTIPLY THEN DIVIDE ====================
+//
+// The 512-bit product goes straight through the prepared-divisor kernel,
+// so a fixed denominator (a fixed-point unit, a price scale) pays for its
+// reciprocal once.
+
+// |d| as little-endian limbs
+static void divider_magnitude(const Int256Divider* dv, uint64_t d[4]) {
+    memset(d, 0, 4 * sizeof(uint64_t));
+    if (dv->kind == DIVIDER_POW2) {
+        d[dv->shift / 64] = 1ULL << (dv->shift % 64);
+        return;
+    }
+    int s = dv->shift;
+    for (int i = 0; i < dv->n; i++) {
+        uint64_t hi = (s && i + 1 < dv->n) ? dv->d[i + 1] << (64 - s) : 0;
+        d[i] = (dv->d[i] >> s) | hi;
+    }
+}
+
+Int256Status divider_muldiv_int256(const Int256Divider* dv, Int256 a, Int256 b,
+                                   Int256Rounding rounding, Int256* out) {
+    uint64_t x[4], y[4], p[8], q[8], r[4];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    mul_limbs_4x4(p, x, y);
+    divider_divmod_limbs(dv, p, 8, q, r);
+    
+    int neg = a.sign ^ b.sign ^ dv->sign;
+    if ((r[0] | r[1] | r[2] | r[3]) != 0 && rounding != INT256_ROUND_TRUNC) {
+        // Compare r with the distance d - r to the next multiple
+        uint64_t d[4], t[4], borrow = 0;
+        divider_magnitude(dv, d);
+        for (int i = 0; i < 4; i++) t[i] = sub_with_borrow(d[i], r[i], &borrow);
+        if (round_up_magnitude(rounding, neg, 1, cmp_limbs_4(r, t), (int)(q[0] & 1))) {
+            for (int i = 0; i < 8 && ++q[i] == 0; i++) {}
+        }
+    }
+    
+    *out = limbs_to_int256(q, neg);
+    return (q[4] | q[5] | q[6] | q[7]) ? INT256_ERR_OVERFLOW : INT256_OK;
+}
+
+Int256Status muldiv_int256(Int256 a, Int256 b, Int256 c, Int256Rounding rounding, Int256* out) {
+    Int256Divider dv;
+    if (divider_init_int256(&dv, c) != 0) {
+        *out = (Int256){{0, 0, 0, 0}, 0};
+        return INT256_ERR_DIV_BY_ZERO;
+    }
+    return divider_muldiv_int256(&dv, a, b, rounding, out);
+}
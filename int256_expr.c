@@ -0,0 +1,435 @@
+// libcalc256: infix expressions compiled to a register program.
+//
+// An expression is parsed once into a small tree, constant subtrees are
+// folded, and the tree is flattened into three-address instructions over a
+// register file laid out as [constants | variables | temporaries]. Each
+// evaluation copies the constants and variable values in and runs the
+// instructions; nothing is parsed again.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "calc256_internal.h"
+
+#define EXPR_MAX_REGS 256
+#define EXPR_MAX_NODES 65536
+#define EXPR_MAX_DEPTH 200     // nesting of parentheses, signs and ** exponents
+#define EXPR_NAME_MAX 32
+
+typedef enum {
+    EOP_ADD, EOP_SUB, EOP_MUL, EOP_DIV, EOP_MOD,
+    EOP_AND, EOP_OR, EOP_XOR, EOP_SHL, EOP_SHR,
+    EOP_POW, EOP_NEG
+} ExprOp;
+
+typedef struct {
+    uint8_t op;
+    uint8_t dst, a, b;         // register indices (b unused for EOP_NEG)
+} ExprInsn;
+
+struct Int256Expr {
+    ExprInsn* code;
+    int code_len;
+    Int256* consts;            // registers [0, const_count)
+    int const_count;
+    int var_count;             // registers [const_count, const_count + var_count)
+    int reg_count;
+    int result;                // register holding the value of the expression
+    char var_names[INT256_EXPR_MAX_VARS][EXPR_NAME_MAX];
+};
+
+// ==================== OPERATORS ====================
+
+// Shift counts are taken from an Int256; negative counts shift the other way
+static Int256 expr_shift(Int256 a, Int256 count, int left) {
+    int bits = 256;
+    if (count.part[0] == 0 && count.part[1] == 0 && count.part[2] == 0 && count.part[3] < 256) {
+        bits = (int)count.part[3];
+    }
+    if (count.sign) left = !left;
+    return left ? shift_left_int256(a, bits) : shift_right_int256(a, bits);
+}
+
+// Integer power; a negative exponent truncates 1 / a^|e| toward zero
+static Int256Status expr_pow(Int256 base, Int256 exp, Int256* out) {
+    Int256 one = {{0, 0, 0, 1}, 0};
+    int odd = (int)(exp.part[3] & 1);
+    int unit = base.part[0] == 0 && base.part[1] == 0 && base.part[2] == 0 && base.part[3] == 1;
+
+    if (unit) {
+        *out = one;
+        out->sign = base.sign & odd;
+        return INT256_OK;
+    }
+    if (exp.sign && !is_zero_int256(exp)) {
+        *out = (Int256){{0, 0, 0, 0}, 0};
+        return is_zero_int256(base) ? INT256_ERR_DIV_BY_ZERO : INT256_OK;
+    }
+    if (exp.part[0] || exp.part[1] || exp.part[2] || exp.part[3] > UINT32_MAX) {
+        // |base| >= 2 here unless it is zero; the wrapped value is not computed
+        *out = (Int256){{0, 0, 0, 0}, 0};
+        return is_zero_int256(base) ? INT256_OK : INT256_ERR_OVERFLOW;
+    }
+    return pow_int256_checked(base, (unsigned int)exp.part[3], out);
+}
+
+static Int256Status expr_apply(ExprOp op, Int256 a, Int256 b, Int256* out) {
+    switch (op) {
+        case EOP_ADD: return add_int256_checked(a, b, out);
+        case EOP_SUB: return sub_int256_checked(a, b, out);
+        case EOP_MUL: return mul_int256_checked(a, b, out);
+        case EOP_DIV: return div_int256_checked(a, b, out);
+        case EOP_MOD: return mod_int256_checked(a, b, out);
+        case EOP_AND: *out = and_int256(a, b); return INT256_OK;
+        case EOP_OR:  *out = or_int256(a, b); return INT256_OK;
+        case EOP_XOR: *out = xor_int256(a, b); return INT256_OK;
+        case EOP_SHL: *out = expr_shift(a, b, 1); return INT256_OK;
+        case EOP_SHR: *out = expr_shift(a, b, 0); return INT256_OK;
+        case EOP_POW: return expr_pow(a, b, out);
+        case EOP_NEG: *out = neg_int256(a); return INT256_OK;
+    }
+    return INT256_ERR_INVALID;
+}
+
+// ==================== PARSER ====================
+
+typedef enum { NODE_CONST, NODE_VAR, NODE_UNARY, NODE_BINARY } NodeKind;
+
+typedef struct {
+    NodeKind kind;
+    ExprOp op;
+    int left, right;           // child node indices
+    int index;                 // variable number, or register once assigned
+    Int256 value;
+} ExprNode;
+
+typedef struct {
+    const char* text;
+    size_t pos, len;
+    ExprNode* nodes;
+    int node_count, node_cap;
+    int depth;
+    Int256Expr* expr;          // collects variable names
+    char* err;
+    size_t err_size;
+    int failed;
+} ExprParser;
+
+static int expr_error(ExprParser* p, const char* message) {
+    if (!p->failed && p->err && p->err_size) {
+        snprintf(p->err, p->err_size, "%s at column %zu", message, p->pos + 1);
+    }
+    p->failed = 1;
+    return -1;
+}
+
+static void skip_space(ExprParser* p) {
+    while (p->pos < p->len && isspace((unsigned char)p->text[p->pos])) p->pos++;
+}
+
+// Consumes the operator if it is next (and not the start of a longer one)
+static int accept(ExprParser* p, const char* op) {
+    size_t n = strlen(op);
+    skip_space(p);
+    if (p->pos + n > p->len || memcmp(p->text + p->pos, op, n) != 0) return 0;
+    if (n == 1 && p->pos + 1 < p->len && p->text[p->pos + 1] == op[0] &&
+        (op[0] == '*' || op[0] == '<' || op[0] == '>')) {
+        return 0;
+    }
+    p->pos += n;
+    return 1;
+}
+
+static int new_node(ExprParser* p, NodeKind kind) {
+    if (p->node_count == EXPR_MAX_NODES) return expr_error(p, "expression too large");
+    if (p->node_count == p->node_cap) {
+        int cap = p->node_cap ? 2 * p->node_cap : 32;
+        ExprNode* grown = realloc(p->nodes, (size_t)cap * sizeof(ExprNode));
+        if (grown == NULL) return expr_error(p, "out of memory");
+        p->nodes = grown;
+        p->node_cap = cap;
+    }
+    ExprNode* n = &p->nodes[p->node_count];
+    memset(n, 0, sizeof(*n));
+    n->kind = kind;
+    return p->node_count++;
+}
+
+// Builds op(left, right), folding it when both sides are constants and the
+// operation succeeds (errors are left for evaluation time to report)
+static int make_op(ExprParser* p, ExprOp op, int left, int right) {
+    if (left < 0 || right < 0) return -1;
+    ExprNode* l = &p->nodes[left];
+    if (l->kind == NODE_CONST && (op == EOP_NEG || p->nodes[right].kind == NODE_CONST)) {
+        Int256 folded;
+        if (expr_apply(op, l->value, p->nodes[right].value, &folded) == INT256_OK) {
+            int n = new_node(p, NODE_CONST);
+            if (n >= 0) p->nodes[n].value = folded;
+            return n;
+        }
+    }
+    int n = new_node(p, op == EOP_NEG ? NODE_UNARY : NODE_BINARY);
+    if (n < 0) return -1;
+    p->nodes[n].op = op;
+    p->nodes[n].left = left;
+    p->nodes[n].right = right;
+    return n;
+}
+
+static int parse_bitor(ExprParser* p);
+static int parse_unary(ExprParser* p);
+
+static int parse_primary(ExprParser* p) {
+    skip_space(p);
+    if (p->pos >= p->len) return expr_error(p, "expected operand");
+
+    char c = p->text[p->pos];
+    if (c == '(') {
+        p->pos++;
+        int n = parse_bitor(p);
+        if (n < 0) return -1;
+        if (!accept(p, ")")) return expr_error(p, "expected ')'");
+        return n;
+    }
+
+    size_t start = p->pos;
+    while (p->pos < p->len && (isalnum((unsigned char)p->text[p->pos]) || p->text[p->pos] == '_')) {
+        p->pos++;
+    }
+    size_t tok_len = p->pos - start;
+    if (tok_len == 0) {
+        p->pos = start;
+        return expr_error(p, "expected operand");
+    }
+
+    if (isdigit((unsigned char)c)) {
+        int n = new_node(p, NODE_CONST);
+        if (n < 0) return -1;
+        Int256Status status = parse_int256(p->text + start, tok_len, &p->nodes[n].value, NULL);
+        if (status != INT256_OK) {
+            p->pos = start;
+            return expr_error(p, status == INT256_ERR_OVERFLOW ? "number exceeds 256 bits"
+                                                               : "invalid number");
+        }
+        return n;
+    }
+
+    if (tok_len >= EXPR_NAME_MAX) {
+        p->pos = start;
+        return expr_error(p, "variable name too long");
+    }
+    Int256Expr* e = p->expr;
+    int var = 0;
+    while (var < e->var_count &&
+           !(strlen(e->var_names[var]) == tok_len &&
+             memcmp(e->var_names[var], p->text + start, tok_len) == 0)) {
+        var++;
+    }
+    if (var == e->var_count) {
+        if (var == INT256_EXPR_MAX_VARS) return expr_error(p, "too many variables");
+        memcpy(e->var_names[var], p->text + start, tok_len);
+        e->var_names[var][tok_len] = '\0';
+        e->var_count++;
+    }
+    int n = new_node(p, NODE_VAR);
+    if (n >= 0) p->nodes[n].index = var;
+    return n;
+}
+
+// primary ['**' unary]: right associative, binds tighter than unary minus
+static int parse_power(ExprParser* p) {
+    int base = parse_primary(p);
+    if (base < 0 || !accept(p, "**")) return base;
+    return make_op(p, EOP_POW, base, parse_unary(p));
+}
+
+// Every nesting step (a parenthesis, a sign or a ** exponent) comes back
+// through here, so this is the one place depth is counted
+static int parse_unary(ExprParser* p) {
+    if (++p->depth > EXPR_MAX_DEPTH) return expr_error(p, "expression nested too deeply");
+    int n;
+    if (accept(p, "-")) {
+        int operand = parse_unary(p);
+        n = make_op(p, EOP_NEG, operand, operand);
+    } else if (accept(p, "+")) {
+        n = parse_unary(p);
+    } else {
+        n = parse_power(p);
+    }
+    p->depth--;
+    return n;
+}
+
+static int parse_mul(ExprParser* p) {
+    int n = parse_unary(p);
+    while (n >= 0) {
+        if (accept(p, "*")) n = make_op(p, EOP_MUL, n, parse_unary(p));
+        else if (accept(p, "/")) n = make_op(p, EOP_DIV, n, parse_unary(p));
+        else if (accept(p, "%")) n = make_op(p, EOP_MOD, n, parse_unary(p));
+        else break;
+    }
+    return n;
+}
+
+static int parse_add(ExprParser* p) {
+    int n = parse_mul(p);
+    while (n >= 0) {
+        if (accept(p, "+")) n = make_op(p, EOP_ADD, n, parse_mul(p));
+        else if (accept(p, "-")) n = make_op(p, EOP_SUB, n, parse_mul(p));
+        else break;
+    }
+    return n;
+}
+
+static int parse_shift(ExprParser* p) {
+    int n = parse_add(p);
+    while (n >= 0) {
+        if (accept(p, "<<")) n = make_op(p, EOP_SHL, n, parse_add(p));
+        else if (accept(p, ">>")) n = make_op(p, EOP_SHR, n, parse_add(p));
+        else break;
+    }
+    return n;
+}
+
+static int parse_bitand(ExprParser* p) {
+    int n = parse_shift(p);
+    while (n >= 0 && accept(p, "&")) n = make_op(p, EOP_AND, n, parse_shift(p));
+    return n;
+}
+
+static int parse_bitxor(ExprParser* p) {
+    int n = parse_bitand(p);
+    while (n >= 0 && accept(p, "^")) n = make_op(p, EOP_XOR, n, parse_bitand(p));
+    return n;
+}
+
+static int parse_bitor(ExprParser* p) {
+    int n = parse_bitxor(p);
+    while (n >= 0 && accept(p, "|")) n = make_op(p, EOP_OR, n, parse_bitxor(p));
+    return n;
+}
+
+// ==================== CODE GENERATION ====================
+
+// Gives every constant reachable from the root its own register, leaving
+// room for the variables after them
+static int assign_constants(ExprParser* p, int node, Int256* consts, int* count) {
+    ExprNode* n = &p->nodes[node];
+    if (n->kind == NODE_CONST) {
+        if (*count + p->expr->var_count >= EXPR_MAX_REGS) return -1;
+        consts[*count] = n->value;
+        n->index = (*count)++;
+        return 0;
+    }
+    if (n->kind == NODE_VAR) return 0;
+    if (assign_constants(p, n->left, consts, count) < 0) return -1;
+    return n->kind == NODE_BINARY ? assign_constants(p, n->right, consts, count) : 0;
+}
+
+// Emits code for node and returns its register. Temporaries are handed out
+// as a stack starting at *next, so each subtree's scratch is reused.
+static int emit(Int256Expr* e, ExprParser* p, int node, int* next) {
+    ExprNode* n = &p->nodes[node];
+    if (n->kind == NODE_CONST) return n->index;
+    if (n->kind == NODE_VAR) return e->const_count + n->index;
+
+    int base = *next;
+    int a = emit(e, p, n->left, next);
+    int b = n->kind == NODE_BINARY ? emit(e, p, n->right, next) : a;
+    if (a < 0 || b < 0 || base >= EXPR_MAX_REGS) return -1;
+
+    ExprInsn* insn = &e->code[e->code_len++];
+    insn->op = (uint8_t)n->op;
+    insn->dst = (uint8_t)base;
+    insn->a = (uint8_t)a;
+    insn->b = (uint8_t)b;
+    *next = base + 1;
+    if (*next > e->reg_count) e->reg_count = *next;
+    return base;
+}
+
+Int256Expr* expr_compile_int256(const char* text, size_t len, char* err, size_t err_size) {
+    ExprParser p;
+    memset(&p, 0, sizeof(p));
+    p.text = text;
+    p.len = len;
+    p.err = err;
+    p.err_size = err_size;
+    if (err && err_size) err[0] = '\0';
+
+    Int256Expr* e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        expr_error(&p, "out of memory");
+        return NULL;
+    }
+    p.expr = e;
+
+    int root = parse_bitor(&p);
+    skip_space(&p);
+    if (root >= 0 && p.pos < p.len) {
+        root = expr_error(&p, p.text[p.pos] == ')' ? "unbalanced ')'" : "unexpected character");
+    }
+
+    Int256 consts[EXPR_MAX_REGS];
+    if (root >= 0 && assign_constants(&p, root, consts, &e->const_count) < 0) {
+        root = expr_error(&p, "expression too large");
+    }
+    if (root >= 0) {
+        e->consts = malloc((size_t)(e->const_count ? e->const_count : 1) * sizeof(Int256));
+        e->code = malloc((size_t)(p.node_count ? p.node_count : 1) * sizeof(ExprInsn));
+        if (e->consts == NULL || e->code == NULL) root = expr_error(&p, "out of memory");
+    }
+    if (root >= 0) {
+        memcpy(e->consts, consts, (size_t)e->const_count * sizeof(Int256));
+        int next = e->const_count + e->var_count;
+        e->reg_count = next;
+        e->result = emit(e, &p, root, &next);
+        if (e->result < 0) root = expr_error(&p, "expression too large");
+    }
+
+    free(p.nodes);
+    if (root < 0) {
+        expr_free_int256(e);
+        return NULL;
+    }
+    return e;
+}
+
+void expr_free_int256(Int256Expr* expr) {
+    if (expr == NULL) return;
+    free(expr->code);
+    free(expr->consts);
+    free(expr);
+}
+
+int expr_var_count_int256(const Int256Expr* expr) {
+    return expr->var_count;
+}
+
+const char* expr_var_name_int256(const Int256Expr* expr, int index) {
+    return index >= 0 && index < expr->var_count ? expr->var_names[index] : NULL;
+}
+
+// ==================== EVALUATION ====================
+
+Int256Status expr_eval_int256(const Int256Expr* expr, const Int256* vars, Int256* out) {
+    Int256 reg[EXPR_MAX_REGS];
+    Int256Status result = INT256_OK;
+
+    memcpy(reg, expr->consts, (size_t)expr->const_count * sizeof(Int256));
+    memcpy(reg + expr->const_count, vars, (size_t)expr->var_count * sizeof(Int256));
+
+    for (int i = 0; i < expr->code_len; i++) {
+        const ExprInsn* insn = &expr->code[i];
+        Int256Status status = expr_apply((ExprOp)insn->op, reg[insn->a], reg[insn->b], &reg[insn->dst]);
+        if (status == INT256_ERR_DIV_BY_ZERO) {
+            *out = (Int256){{0, 0, 0, 0}, 0};
+            return status;
+        }
+        if (status != INT256_OK) result = status;
+    }
+
+    *out = reg[expr->result];
+    return result;
+}
@@ -0,0 +1,72 @@
+// Generated by tools/gen_factorial_table.c; do not edit.
+
+#ifndef INT256_FACTORIAL_TABLE_H
+#define INT256_FACTORIAL_TABLE_H
+
+#include "calc256.h"
+
+// n! for 0 <= n < FACTORIAL_TABLE_SIZE; 58! and up exceed 256 bits
+#define FACTORIAL_TABLE_SIZE 58
+
+static const Int256 factorial_table[FACTORIAL_TABLE_SIZE] = {
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL}, 0},   // 0!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL}, 0},   // 1!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000002ULL}, 0},   // 2!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000006ULL}, 0},   // 3!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000018ULL}, 0},   // 4!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000078ULL}, 0},   // 5!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000002d0ULL}, 0},   // 6!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000013b0ULL}, 0},   // 7!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000009d80ULL}, 0},   // 8!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000058980ULL}, 0},   // 9!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000375f00ULL}, 0},   // 10!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000002611500ULL}, 0},   // 11!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000001c8cfc00ULL}, 0},   // 12!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000017328cc00ULL}, 0},   // 13!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000144c3b2800ULL}, 0},   // 14!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000013077775800ULL}, 0},   // 15!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000130777758000ULL}, 0},   // 16!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0001437eeecd8000ULL}, 0},   // 17!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0016beecca730000ULL}, 0},   // 18!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x01b02b9306890000ULL}, 0},   // 19!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x21c3677c82b40000ULL}, 0},   // 20!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000002ULL, 0xc5077d36b8c40000ULL}, 0},   // 21!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000000003cULL, 0xeea4c2b3e0d80000ULL}, 0},   // 22!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000579ULL, 0x70cd7e2933680000ULL}, 0},   // 23!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000008362ULL, 0x9343d3dcd1c00000ULL}, 0},   // 24!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000cd4a0ULL, 0x619fb0907bc00000ULL}, 0},   // 25!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000014d9849ULL, 0xea37eeac91800000ULL}, 0},   // 26!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000232f0fcbULL, 0xb3e62c3358800000ULL}, 0},   // 27!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000003d925ba47ULL, 0xad2cd59dae000000ULL}, 0},   // 28!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000006f99461a1eULL, 0x9e1432dcb6000000ULL}, 0},   // 29!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000d13f6370f96ULL, 0x865df5dd54000000ULL}, 0},   // 30!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0001956ad0aae33aULL, 0x4560c5cd2c000000ULL}, 0},   // 31!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0032ad5a155c6748ULL, 0xac18b9a580000000ULL}, 0},   // 32!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0688589cc0e9505eULL, 0x2f2fee5580000000ULL}, 0},   // 33!
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0xde1bc4d19efcac82ULL, 0x445da75b00000000ULL}, 0},   // 34!
+    {{0x0000000000000000ULL, 0x000000000000001eULL, 0x5dcbe8a8bc8b95cfULL, 0x58cde17100000000ULL}, 0},   // 35!
+    {{0x0000000000000000ULL, 0x0000000000000445ULL, 0x30acb7ba83a11128ULL, 0x7cf3b3e400000000ULL}, 0},   // 36!
+    {{0x0000000000000000ULL, 0x0000000000009e00ULL, 0x08f68df506477adaULL, 0x0f38fff400000000ULL}, 0},   // 37!
+    {{0x0000000000000000ULL, 0x0000000000177401ULL, 0x5499125eee9c3c5eULL, 0x4275fe3800000000ULL}, 0},   // 38!
+    {{0x0000000000000000ULL, 0x000000000392ac33ULL, 0xe351cc7659cd325cULL, 0x1ff9ba8800000000ULL}, 0},   // 39!
+    {{0x0000000000000000ULL, 0x000000008eeae81bULL, 0x84c7f27e080fde64ULL, 0xff05254000000000ULL}, 0},   // 40!
+    {{0x0000000000000000ULL, 0x00000016e39f2c68ULL, 0x4405d62f4a8a9e2cULL, 0xd7d2f74000000000ULL}, 0},   // 41!
+    {{0x0000000000000000ULL, 0x000003c1581d491bULL, 0x28f523c23abdf35bULL, 0x689c908000000000ULL}, 0},   // 42!
+    {{0x0000000000000000ULL, 0x0000a179cceb478fULL, 0xe12d019fdde7e05aULL, 0x924c458000000000ULL}, 0},   // 43!
+    {{0x0000000000000000ULL, 0x001bc0ef38704cbaULL, 0xb3bc477a23da8f91ULL, 0x251bf20000000000ULL}, 0},   // 44!
+    {{0x0000000000000000ULL, 0x04e0ea0cebbd7cd1ULL, 0x981890784d6b3c83ULL, 0x85e98a0000000000ULL}, 0},   // 45!
+    {{0x0000000000000000ULL, 0xe06a0e525c0c6da9ULL, 0x5469f59de944dfa2ULL, 0x0ff6cc0000000000ULL}, 0},   // 46!
+    {{0x0000000000000029ULL, 0x3378a11ee6482216ULL, 0x7f7417fdd3a50ec0ULL, 0xee4f740000000000ULL}, 0},   // 47!
+    {{0x00000000000007b9ULL, 0xa69e35cb2d866437ULL, 0xe5c47f97aef2c42cULL, 0xaee5c00000000000ULL}, 0},   // 48!
+    {{0x0000000000017a88ULL, 0xe4484be3b6b92eb2ULL, 0xfa9c6c087c778c8dULL, 0x79f9c00000000000ULL}, 0},   // 49!
+    {{0x000000000049eebcULL, 0x961ed279b02b1ef4ULL, 0xf28d19a84f5973a1ULL, 0xd2c7800000000000ULL}, 0},   // 50!
+    {{0x000000000eba8f91ULL, 0xe823ee3e18972accULL, 0x521c1c87ced2093cULL, 0xfdbe800000000000ULL}, 0},   // 51!
+    {{0x00000002fde529a3ULL, 0x274c649cfeb4b180ULL, 0xadb5cb9602a9e063ULL, 0x8ab2000000000000ULL}, 0},   // 52!
+    {{0x0000009e90719ec7ULL, 0x22d0d480bb68bfa3ULL, 0xf6a3260e8d2b749bULL, 0xb6da000000000000ULL}, 0},   // 53!
+    {{0x0000217277f77e01ULL, 0x580cd32788186c96ULL, 0x066a0711c72a98d8ULL, 0x91fc000000000000ULL}, 0},   // 54!
+    {{0x00072f97c62c1249ULL, 0xeac15d7e3d3f543bULL, 0x60c784d1ca26d687ULL, 0x5d24000000000000ULL}, 0},   // 55!
+    {{0x0192693359a4002bULL, 0x5a4c739d65da6cfdULL, 0x2ba50de4387eed9cULL, 0x5fe0000000000000ULL}, 0},   // 56!
+    {{0x59996c6ef58409a7ULL, 0x1b05be0bada2445eULL, 0xb7c017d09442e7d1ULL, 0x58e0000000000000ULL}, 0},   // 57!
+};
+
+#endif // INT256_FACTORIAL_TABLE_H
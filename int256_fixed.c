@@ -0,0 +1,130 @@
+// libcalc256: fixed-point decimal arithmetic.
+
+#include <ctype.h>
+
+#include "calc256_internal.h"
+#include "int256_pow10_table.h"
+
+// ==================== FIXED POINT ====================
+//
+// A value with scale s is the integer x * 10^s, so the digits of the
+// integer are the decimal digits of x and parsing and formatting only move
+// the point. Products and quotients take the 512-bit path of muldiv, with
+// the division by 10^s prepared once in the context.
+
+// Returns 0 on success, -1 if scale > INT256_MAX_SCALE
+int fixed_init_int256(Int256Fixed* fx, unsigned int scale, Int256Rounding rounding) {
+    if (scale > INT256_MAX_SCALE) return -1;
+    fx->scale = scale;
+    fx->rounding = rounding;
+    fx->one = pow10_table[scale];
+    divider_init_int256(&fx->unit, fx->one);
+    return 0;
+}
+
+static inline int is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Parses [whitespace][sign]digits[.digits]; "1.", ".5" and "-0.25" are all
+// accepted. The number must be followed by whitespace or the end of input,
+// otherwise INT256_ERR_INVALID is returned.
+Int256Status parse_fixed_int256(const Int256Fixed* fx, const char* str, size_t len,
+                                Int256* out, size_t* consumed) {
+    size_t i = 0;
+    int sign = 0;
+
+    while (i < len && isspace((unsigned char)str[i])) i++;
+    if (i < len && (str[i] == '-' || str[i] == '+')) {
+        sign = str[i] == '-';
+        i++;
+    }
+
+    size_t int_start = i;
+    while (i < len && is_digit(str[i])) i++;
+    size_t int_end = i, frac_start = i;
+    if (i < len && str[i] == '.') {
+        frac_start = ++i;
+        while (i < len && is_digit(str[i])) i++;
+    }
+    size_t frac_end = i;
+
+    if (consumed) *consumed = i;
+
+    Int256Status status = INT256_OK;
+    if (i < len && !isspace((unsigned char)str[i])) {
+        status = INT256_ERR_INVALID;
+    } else if (int_end == int_start && frac_end == frac_start) {
+        status = INT256_ERR_EMPTY;
+    }
+
+    // The digit runs are plain decimal integers for parse_int256
+    Int256 whole = {{0, 0, 0, 0}, 0}, frac = {{0, 0, 0, 0}, 0}, value;
+    int overflow = int_end > int_start
+                && parse_int256(str + int_start, int_end - int_start, &whole, NULL) == INT256_ERR_OVERFLOW;
+    size_t places = frac_end - frac_start;
+    size_t kept = places < fx->scale ? places : fx->scale;
+    if (kept > 0) {
+        parse_int256(str + frac_start, kept, &frac, NULL);
+        frac = mul_int256(frac, pow10_table[fx->scale - kept]);
+    }
+    if (mul_int256_checked(whole, fx->one, &value) != INT256_OK) overflow = 1;
+    if (add_int256_checked(value, frac, &value) != INT256_OK) overflow = 1;
+
+    // Round on the dropped places: the first decides against half a unit,
+    // the rest only break a tie
+    if (places > kept) {
+        const char* p = str + frac_start + kept;
+        int first = p[0] - '0', rest = 0;
+        for (size_t k = 1; k < places - kept && !rest; k++) rest = p[k] != '0';
+        int half = first != 5 ? (first > 5 ? 1 : -1) : rest;
+        if (round_up_magnitude(fx->rounding, sign, first | rest, half, (int)(value.part[3] & 1))) {
+            Int256 unit = {{0, 0, 0, 1}, 0};
+            if (add_int256_checked(value, unit, &value) != INT256_OK) overflow = 1;
+        }
+    }
+
+    if (overflow && status == INT256_OK) status = INT256_ERR_OVERFLOW;
+    value.sign = sign && !is_zero_int256(value);
+    *out = value;
+    return status;
+}
+
+// Formats n with exactly fx->scale places into buffer and returns the
+// number of characters written, or 0 with an empty string if it does not fit
+size_t fixed_to_decimal_int256(const Int256Fixed* fx, Int256 n, char* buffer, size_t buffer_size) {
+    char digits[80];
+    int neg = n.sign && !is_zero_int256(n);
+    n.sign = 0;
+    size_t count = int256_to_decimal(n, digits, sizeof(digits));
+
+    // At least one digit before the point
+    size_t scale = fx->scale;
+    size_t lead = count > scale ? count - scale : 1;
+    size_t pad = count > scale ? 0 : scale - count + 1;
+    size_t total = (size_t)neg + lead + (scale ? 1 + scale : 0);
+    if (total + 1 > buffer_size) {
+        if (buffer_size) buffer[0] = '\0';
+        return 0;
+    }
+
+    char* p = buffer;
+    if (neg) *p++ = '-';
+    memset(p, '0', pad);
+    memcpy(p + pad, digits, count);
+    if (scale) {
+        // Shift the places right by one to open a slot for the point
+        memmove(p + lead + 1, p + lead, scale);
+        p[lead] = '.';
+    }
+    buffer[total] = '\0';
+    return total;
+}
+
+Int256Status mul_fixed_int256(const Int256Fixed* fx, Int256 a, Int256 b, Int256* out) {
+    return divider_muldiv_int256(&fx->unit, a, b, fx->rounding, out);
+}
+
+Int256Status div_fixed_int256(const Int256Fixed* fx, Int256 a, Int256 b, Int256* out) {
+    return muldiv_int256(a, fx->one, b, fx->rounding, out);
+}
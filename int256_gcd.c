@@ -0,0 +1,305 @@
+// libcalc256: greatest common divisor, extended GCD and modular inverse.
+
+#include "calc256_internal.h"
+
+// ==================== BINARY GCD ====================
+//
+// Binary GCD keeps b odd and repeats: halve a if it is even, otherwise
+// replace the larger of the two by (a - b) / 2. Every step only looks at the
+// low bit of a and at which of a, b is larger, so 31 steps at a time are run
+// on 64-bit stand-ins that hold the low 31 bits and the top 33 bits of each
+// value (Pornin's optimized binary GCD). The steps are recorded as factors
+// with a' = (f0 a + g0 b) / 2^31 and b' = (f1 a + g1 b) / 2^31, which are
+// then applied to the full 256-bit values once per batch. Runs of zero bits
+// are skipped with a count-trailing-zeros instead of one step per bit.
+
+#define GCD_BATCH 31
+
+typedef struct {
+    int64_t f0, g0, f1, g1;
+} GcdFactors;
+
+static inline void shl_limbs_4(uint64_t a[4], int s) {
+    int w = s / 64, b = s % 64;
+    for (int i = 3; i >= 0; i--) {
+        uint64_t hi = i - w >= 0 ? a[i - w] : 0;
+        uint64_t lo = i - w - 1 >= 0 ? a[i - w - 1] : 0;
+        a[i] = b ? (hi << b) | (lo >> (64 - b)) : hi;
+    }
+}
+
+// Low 31 bits of a, with bits [n-33, n) above them
+static inline uint64_t gcd_approx(const uint64_t a[4], int n) {
+    int s = n - 33, w = s / 64, b = s % 64;
+    uint64_t top = a[w] >> b;
+    if (b > 31 && w < 3) top |= a[w + 1] << (64 - b);
+    return ((top & 0x1ffffffffULL) << GCD_BATCH) | (a[0] & 0x7fffffffULL);
+}
+
+// GCD_BATCH binary GCD steps on the stand-ins for a and b (b odd)
+static GcdFactors gcd_batch(uint64_t a, uint64_t b) {
+    GcdFactors m = {1, 0, 0, 1};
+    int steps = GCD_BATCH;
+    while (steps > 0) {
+        if (a & 1) {
+            if (a < b) {
+                uint64_t t = a;
+                a = b;
+                b = t;
+                int64_t f = m.f0, g = m.g0;
+                m.f0 = m.f1;
+                m.g0 = m.g1;
+                m.f1 = f;
+                m.g1 = g;
+            }
+            a -= b;
+            m.f0 -= m.f1;
+            m.g0 -= m.g1;
+        }
+        // a is even here: skip its run of zero bits
+        int z = a ? __builtin_ctzll(a) : steps;
+        if (z > steps) z = steps;
+        a >>= z;
+        m.f1 *= (int64_t)1 << z;
+        m.g1 *= (int64_t)1 << z;
+        steps -= z;
+    }
+    return m;
+}
+
+// r = f x + g y as a 320-bit two's complement value
+static void lincomb_limbs(uint64_t r[5], const uint64_t x[4], int64_t f,
+                          const uint64_t y[4], int64_t g) {
+    __int128 carry = 0;
+    for (int i = 0; i < 4; i++) {
+        __int128 t = (__int128)f * (__int128)x[i] + (__int128)g * (__int128)y[i] + carry;
+        r[i] = (uint64_t)t;
+        carry = t >> 64;
+    }
+    r[4] = (uint64_t)carry;
+}
+
+// r = |t| / 2^GCD_BATCH for a 320-bit t divisible by 2^GCD_BATCH; returns
+// nonzero if t was negative
+static int lincomb_shift(uint64_t r[5], uint64_t t[5]) {
+    int neg = (int64_t)t[4] < 0;
+    if (neg) {
+        uint64_t borrow = 0;
+        for (int i = 0; i < 5; i++) t[i] = sub_with_borrow(0, t[i], &borrow);
+    }
+    for (int i = 0; i < 4; i++) r[i] = (t[i] >> GCD_BATCH) | (t[i + 1] << (64 - GCD_BATCH));
+    r[4] = t[4] >> GCD_BATCH;
+    return neg;
+}
+
+// r = (f u + g v) / 2^GCD_BATCH mod m for u, v in [0, m), m odd; the
+// division adds the multiple of m that clears the low bits
+static void gcd_update_mod(uint64_t r[4], const uint64_t u[4], const uint64_t v[4],
+                           int64_t f, int64_t g, const uint64_t m[4], uint64_t m_neg_inv) {
+    uint64_t t[5], s[5], q[5];
+    lincomb_limbs(t, u, f, v, g);
+    int64_t k = (int64_t)((t[0] * m_neg_inv) & 0x7fffffffULL);
+    uint64_t zero[4] = {0, 0, 0, 0};
+    lincomb_limbs(s, m, k, zero, 0);
+    uint64_t carry = 0;
+    for (int i = 0; i < 5; i++) t[i] = add_with_carry(t[i], s[i], &carry);
+
+    // |f| + |g| <= 2^31 puts the quotient in (-m, 2m), which may take a
+    // fifth limb
+    int neg = lincomb_shift(q, t);
+    if (neg) {
+        if (limbs_len(q, 4) == 0) {
+            memset(r, 0, 4 * sizeof(uint64_t));
+            return;
+        }
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; i++) r[i] = sub_with_borrow(m[i], q[i], &borrow);
+        return;
+    }
+    if (q[4] || cmp_limbs_4(q, m) >= 0) {
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; i++) q[i] = sub_with_borrow(q[i], m[i], &borrow);
+    }
+    memcpy(r, q, 4 * sizeof(uint64_t));
+}
+
+// Runs binary GCD on a and odd b until a is zero, leaving the odd GCD in b.
+// With m set (b = m on entry), u and v track a = u y, b = v y (mod m).
+static void gcd_core(uint64_t a[4], uint64_t b[4], uint64_t u[4], uint64_t v[4],
+                     const uint64_t m[4]) {
+    uint64_t m_neg_inv = m ? -inverse_word(m[0]) : 0;
+    while (limbs_len(a, 4) != 0) {
+        int n = limbs_bits(a, 4);
+        int nb = limbs_bits(b, 4);
+        if (nb > n) n = nb;
+        if (n < 64) n = 64;
+        GcdFactors f = gcd_batch(gcd_approx(a, n), gcd_approx(b, n));
+
+        // Both results are at most max(a, b), so the fifth limb is zero
+        uint64_t ta[5], tb[5], na[5], nbv[5];
+        lincomb_limbs(ta, a, f.f0, b, f.g0);
+        lincomb_limbs(tb, a, f.f1, b, f.g1);
+        if (lincomb_shift(na, ta)) {
+            f.f0 = -f.f0;
+            f.g0 = -f.g0;
+        }
+        if (lincomb_shift(nbv, tb)) {
+            f.f1 = -f.f1;
+            f.g1 = -f.g1;
+        }
+        memcpy(a, na, 4 * sizeof(uint64_t));
+        memcpy(b, nbv, 4 * sizeof(uint64_t));
+        if (m) {
+            uint64_t nu[4], nv[4];
+            gcd_update_mod(nu, u, v, f.f0, f.g0, m, m_neg_inv);
+            gcd_update_mod(nv, u, v, f.f1, f.g1, m, m_neg_inv);
+            memcpy(u, nu, sizeof(nu));
+            memcpy(v, nv, sizeof(nv));
+        }
+    }
+}
+
+// y^-1 mod m for odd m >= 3 and y in [0, m); returns -1 if not coprime
+static int inverse_odd_limbs(uint64_t r[4], const uint64_t y[4], const uint64_t m[4]) {
+    uint64_t a[4], b[4], u[4] = {1, 0, 0, 0}, v[4] = {0, 0, 0, 0};
+    memcpy(a, y, sizeof(a));
+    memcpy(b, m, sizeof(b));
+    gcd_core(a, b, u, v, m);
+    if (!(b[0] == 1 && limbs_len(b, 4) == 1)) return -1;
+    memcpy(r, v, sizeof(v));
+    return 0;
+}
+
+// y^-1 mod m for m >= 2 and y in [0, m); returns -1 if not coprime. Even
+// moduli go through the inverse of m modulo the (then odd) y.
+static int inverse_limbs(uint64_t r[4], const uint64_t y[4], const uint64_t m[4]) {
+    if (m[0] & 1) return inverse_odd_limbs(r, y, m);
+    if (!(y[0] & 1)) return -1;
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (y[0] == 1 && limbs_len(y, 4) == 1) {
+        r[0] = 1;
+        return 0;
+    }
+
+    // t = m^-1 mod y, then y * -((m t - 1) / y) = 1 - m t = 1 (mod m)
+    uint64_t mr[4], t[4], p[8], q[8];
+    int ylen = limbs_len(y, 4);
+    divmod_limbs(NULL, mr, m, limbs_len(m, 4) < ylen ? ylen : limbs_len(m, 4), y, ylen);
+    memset(mr + ylen, 0, (4 - (size_t)ylen) * sizeof(uint64_t));
+    if (inverse_odd_limbs(t, mr, y) != 0) return -1;
+
+    mul_limbs_4x4(p, m, t);
+    uint64_t borrow = 1;
+    for (int i = 0; i < 8; i++) p[i] = sub_with_borrow(p[i], 0, &borrow);
+    int plen = limbs_len(p, 8);
+    memset(q, 0, sizeof(q));
+    if (plen >= ylen) divmod_limbs(q, NULL, p, plen, y, ylen);
+
+    // q < m since t < y
+    borrow = 0;
+    for (int i = 0; i < 4; i++) r[i] = sub_with_borrow(m[i], q[i], &borrow);
+    return 0;
+}
+
+void gcd_limbs(uint64_t r[4], const uint64_t x[4], const uint64_t y[4]) {
+    if (limbs_len(x, 4) == 0 || limbs_len(y, 4) == 0) {
+        for (int i = 0; i < 4; i++) r[i] = x[i] | y[i];
+        return;
+    }
+    int za = ctz_limbs_4(x), zb = ctz_limbs_4(y);
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (limbs_len(x, 4) == 1 && limbs_len(y, 4) == 1) {
+        r[0] = gcd_word(x[0], y[0]);
+        return;
+    }
+    uint64_t a[4], b[4];
+    memcpy(a, x, sizeof(a));
+    memcpy(b, y, sizeof(b));
+    shr_limbs_4(a, za);
+    shr_limbs_4(b, zb);
+    gcd_core(a, b, NULL, NULL, NULL);
+    shl_limbs_4(b, za < zb ? za : zb);
+    memcpy(r, b, sizeof(b));
+}
+
+// ==================== GCD, LCM AND MODULAR INVERSE ====================
+
+Int256 gcd_int256(Int256 a, Int256 b) {
+    uint64_t x[4], y[4], r[4];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    gcd_limbs(r, x, y);
+    return limbs_to_int256(r, 0);
+}
+
+Int256Status lcm_int256(Int256 a, Int256 b, Int256* out) {
+    Int256 g = gcd_int256(a, b);
+    if (is_zero_int256(g)) {
+        *out = g;
+        return INT256_OK;
+    }
+    a.sign = 0;
+    b.sign = 0;
+    return mul_int256_checked(div_int256(a, g), b, out);
+}
+
+// a x + b y = gcd(a, b). With a' = |a| / g and b' = |b| / g coprime,
+// x = a'^-1 mod b' and y = (1 - a' x) / b', so |x| < b' and |y| <= a'.
+Int256 xgcd_int256(Int256 a, Int256 b, Int256* x, Int256* y) {
+    Int256 zero = {{0, 0, 0, 0}, 0}, one = {{0, 0, 0, 1}, 0};
+    Int256 g = gcd_int256(a, b);
+    *x = zero;
+    *y = zero;
+    if (is_zero_int256(b)) {
+        if (!is_zero_int256(a)) {
+            *x = one;
+            x->sign = a.sign;
+        }
+        return g;
+    }
+
+    Int256 ma = abs_int256(a), mb = abs_int256(b);
+    uint64_t pa[4], pb[4], px[4], t[8], q[8];
+    Int256 ra = div_int256(ma, g), rb = div_int256(mb, g);
+    if (rb.part[0] == 0 && rb.part[1] == 0 && rb.part[2] == 0 && rb.part[3] == 1) {
+        *y = one;
+        y->sign = b.sign;
+        return g;
+    }
+    Int256 rr = mod_int256(ra, rb);
+    int256_to_limbs(&rr, pa);
+    int256_to_limbs(&rb, pb);
+    inverse_limbs(px, pa, pb);
+
+    // y = -(a' x - 1) / b', exact since a' x = 1 (mod b')
+    int256_to_limbs(&ra, pa);
+    mul_limbs_4x4(t, pa, px);
+    uint64_t borrow = 1;
+    for (int i = 0; i < 8; i++) t[i] = sub_with_borrow(t[i], 0, &borrow);
+    memset(q, 0, sizeof(q));
+    int tlen = limbs_len(t, 8), blen = limbs_len(pb, 4);
+    if (tlen >= blen) divmod_limbs(q, NULL, t, tlen, pb, blen);
+
+    *x = limbs_to_int256(px, a.sign);
+    *y = limbs_to_int256(q, !b.sign);
+    return g;
+}
+
+Int256Status modinv_int256(Int256 a, Int256 m, Int256* out) {
+    Int256 zero = {{0, 0, 0, 0}, 0};
+    *out = zero;
+    if (is_zero_int256(m)) return INT256_ERR_DIV_BY_ZERO;
+    m.sign = 0;
+    if (m.part[0] == 0 && m.part[1] == 0 && m.part[2] == 0 && m.part[3] == 1) return INT256_OK;
+
+    // a mod m in [0, m)
+    Int256 r = mod_int256(a, m);
+    if (r.sign) r = add_int256(r, m);
+
+    uint64_t y[4], n[4], inv[4];
+    int256_to_limbs(&r, y);
+    int256_to_limbs(&m, n);
+    if (inverse_limbs(inv, y, n) != 0) return INT256_ERR_DOMAIN;
+    *out = limbs_to_int256(inv, 0);
+    return INT256_OK;
+}
@@ -0,0 +1,254 @@
+// libcalc256: modular arithmetic with Montgomery reduction.
+
+#include "calc256_internal.h"
+
+// ==================== MODULAR ARITHMETIC (MONTGOMERY) ====================
+//
+// Residues are kept as little-endian limbs in [0, m). Odd moduli use
+// Montgomery form (x * 2^256 mod m) so reduction needs no division; even
+// moduli fall back to a 512-bit product reduced with divmod_limbs.
+
+// r = t mod n where t < 2^512 (plain reduction)
+static void mod_limbs_512(uint64_t r[4], const uint64_t t[8], const Int256Mont* ctx) {
+    int m = limbs_len(t, 8);
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (m < ctx->len) {
+        memcpy(r, t, (size_t)m * sizeof(uint64_t));
+        return;
+    }
+    divmod_limbs(NULL, r, t, m, ctx->n, ctx->len);
+}
+
+// r = t * R^-1 mod n for t < n * R (Montgomery reduction)
+static void redc_limbs(uint64_t r[4], uint64_t t[9], const Int256Mont* ctx) {
+    t[8] = 0;
+    for (int i = 0; i < 4; i++) {
+        uint64_t m = t[i] * ctx->n0inv;
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; j++) {
+            __uint128_t p = (__uint128_t)m * ctx->n[j] + t[i + j] + carry;
+            t[i + j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        for (int k = i + 4; carry && k < 9; k++) {
+            t[k] += carry;
+            carry = t[k] < carry;
+        }
+    }
+    // Result is t[4..8] < 2n: one conditional subtraction
+    uint64_t diff[4], borrow = 0;
+    for (int j = 0; j < 4; j++) diff[j] = sub_with_borrow(t[4 + j], ctx->n[j], &borrow);
+    int keep = t[8] == 0 && borrow;
+    for (int j = 0; j < 4; j++) r[j] = keep ? t[4 + j] : diff[j];
+}
+
+// Montgomery multiplication (CIOS): r = a * b * R^-1 mod n
+void mont_mul_limbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                    const Int256Mont* ctx) {
+    uint64_t t[6] = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 4; j++) {
+            __uint128_t p = (__uint128_t)a[j] * b[i] + t[j] + carry;
+            t[j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        __uint128_t s = (__uint128_t)t[4] + carry;
+        t[4] = (uint64_t)s;
+        t[5] = (uint64_t)(s >> 64);
+        
+        uint64_t m = t[0] * ctx->n0inv;
+        __uint128_t p = (__uint128_t)m * ctx->n[0] + t[0];
+        carry = (uint64_t)(p >> 64);
+        for (int j = 1; j < 4; j++) {
+            p = (__uint128_t)m * ctx->n[j] + t[j] + carry;
+            t[j - 1] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        s = (__uint128_t)t[4] + carry;
+        t[3] = (uint64_t)s;
+        t[4] = t[5] + (uint64_t)(s >> 64);
+    }
+    uint64_t diff[4], borrow = 0;
+    for (int j = 0; j < 4; j++) diff[j] = sub_with_borrow(t[j], ctx->n[j], &borrow);
+    int keep = t[4] == 0 && borrow;
+    for (int j = 0; j < 4; j++) r[j] = keep ? t[j] : diff[j];
+}
+
+// Modular multiply in the context's representation
+static void ctx_mul_limbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4],
+                          const Int256Mont* ctx) {
+    if (ctx->odd) {
+        mont_mul_limbs(r, a, b, ctx);
+    } else {
+        uint64_t t[8];
+        mul_limbs_4x4(t, a, b);
+        mod_limbs_512(r, t, ctx);
+    }
+}
+
+void mont_sqr_limbs(uint64_t r[4], const uint64_t a[4], const Int256Mont* ctx) {
+    uint64_t t[9];
+    sqr_limbs_4(t, a);
+    redc_limbs(r, t, ctx);
+}
+
+static void ctx_sqr_limbs(uint64_t r[4], const uint64_t a[4], const Int256Mont* ctx) {
+    if (ctx->odd) {
+        mont_sqr_limbs(r, a, ctx);
+    } else {
+        uint64_t t[8];
+        sqr_limbs_4(t, a);
+        mod_limbs_512(r, t, ctx);
+    }
+}
+
+// Maps any Int256 to its residue in [0, m)
+static void reduce_limbs(uint64_t r[4], Int256 a, const Int256Mont* ctx) {
+    uint64_t l[4];
+    int256_to_limbs(&a, l);
+    int m = limbs_len(l, 4);
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (m >= ctx->len) {
+        divmod_limbs(NULL, r, l, m, ctx->n, ctx->len);
+    } else {
+        memcpy(r, l, sizeof(l));
+    }
+    if (a.sign && limbs_len(r, 4) != 0) {
+        uint64_t borrow = 0;
+        for (int j = 0; j < 4; j++) r[j] = sub_with_borrow(ctx->n[j], r[j], &borrow);
+    }
+}
+
+// Returns 0 on success, -1 if the modulus is zero. The modulus sign is ignored.
+int mont_init_int256(Int256Mont* ctx, Int256 modulus) {
+    memset(ctx, 0, sizeof(*ctx));
+    int256_to_limbs(&modulus, ctx->n);
+    ctx->len = limbs_len(ctx->n, 4);
+    if (ctx->len == 0) return -1;
+    
+    ctx->odd = (ctx->n[0] & 1) && !(ctx->len == 1 && ctx->n[0] == 1);
+    if (!ctx->odd) {
+        ctx->one[0] = ctx->len == 1 && ctx->n[0] == 1 ? 0 : 1;
+        return 0;
+    }
+    
+    ctx->n0inv = -inverse_word(ctx->n[0]);
+    
+    // R mod n, then R^2 mod n = (R mod n)^2 mod n
+    uint64_t r[5] = {0, 0, 0, 0, 1}, t[8];
+    divmod_limbs(NULL, ctx->one, r, 5, ctx->n, ctx->len);
+    mul_limbs_4x4(t, ctx->one, ctx->one);
+    mod_limbs_512(ctx->r2, t, ctx);
+    return 0;
+}
+
+// Converts a value into the context's representation (Montgomery form for
+// odd moduli), reducing it modulo m first.
+Int256 mont_to_int256(const Int256Mont* ctx, Int256 a) {
+    uint64_t x[4], r[4];
+    reduce_limbs(x, a, ctx);
+    if (ctx->odd) {
+        mont_mul_limbs(r, x, ctx->r2, ctx);
+    } else {
+        memcpy(r, x, sizeof(x));
+    }
+    return limbs_to_int256(r, 0);
+}
+
+Int256 mont_from_int256(const Int256Mont* ctx, Int256 a) {
+    if (!ctx->odd) return a;
+    uint64_t x[4], one[4] = {1, 0, 0, 0}, r[4];
+    int256_to_limbs(&a, x);
+    mont_mul_limbs(r, x, one, ctx);
+    return limbs_to_int256(r, 0);
+}
+
+// Product of two values already in the context's representation
+Int256 mont_mul_int256(const Int256Mont* ctx, Int256 a, Int256 b) {
+    uint64_t x[4], y[4], r[4];
+    int256_to_limbs(&a, x);
+    int256_to_limbs(&b, y);
+    ctx_mul_limbs(r, x, y, ctx);
+    return limbs_to_int256(r, 0);
+}
+
+Int256 mont_sqr_int256(const Int256Mont* ctx, Int256 a) {
+    uint64_t x[4], r[4];
+    int256_to_limbs(&a, x);
+    ctx_sqr_limbs(r, x, ctx);
+    return limbs_to_int256(r, 0);
+}
+
+// (a * b) mod m on ordinary values; result in [0, m)
+Int256 mulmod_int256(const Int256Mont* ctx, Int256 a, Int256 b) {
+    uint64_t x[4], y[4], t[8], r[4];
+    reduce_limbs(x, a, ctx);
+    reduce_limbs(y, b, ctx);
+    mul_limbs_4x4(t, x, y);
+    mod_limbs_512(r, t, ctx);
+    return limbs_to_int256(r, 0);
+}
+
+Int256 sqrmod_int256(const Int256Mont* ctx, Int256 a) {
+    uint64_t x[4], t[8], r[4];
+    reduce_limbs(x, a, ctx);
+    sqr_limbs_4(t, x);
+    mod_limbs_512(r, t, ctx);
+    return limbs_to_int256(r, 0);
+}
+
+// x^e in the context's representation using left-to-right sliding windows
+// over the exponent
+void mont_pow_limbs(uint64_t r[4], const uint64_t x[4], const uint64_t e[4],
+                    const Int256Mont* ctx) {
+    uint64_t acc[4];
+    int elen = limbs_len(e, 4);
+    memcpy(acc, ctx->one, sizeof(acc));
+    if (elen == 0) {
+        memcpy(r, acc, sizeof(acc));
+        return;
+    }
+    
+    int bits = 64 * elen - __builtin_clzll(e[elen - 1]);
+    int window = bits > 160 ? 5 : bits > 48 ? 4 : bits > 16 ? 3 : bits > 4 ? 2 : 1;
+    
+    // Odd powers x, x^3, ..., x^(2^window - 1)
+    uint64_t table[16][4], x2[4];
+    memcpy(table[0], x, sizeof(table[0]));
+    ctx_sqr_limbs(x2, x, ctx);
+    for (int i = 1; i < (1 << (window - 1)); i++) {
+        ctx_mul_limbs(table[i], table[i - 1], x2, ctx);
+    }
+    
+    int i = bits - 1;
+    while (i >= 0) {
+        if (((e[i / 64] >> (i % 64)) & 1) == 0) {
+            ctx_sqr_limbs(acc, acc, ctx);
+            i--;
+            continue;
+        }
+        // Longest window ending in a set bit
+        int lo = i - window + 1 < 0 ? 0 : i - window + 1;
+        while (((e[lo / 64] >> (lo % 64)) & 1) == 0) lo++;
+        unsigned int value = 0;
+        for (int k = i; k >= lo; k--) {
+            value = (value << 1) | ((e[k / 64] >> (k % 64)) & 1);
+            ctx_sqr_limbs(acc, acc, ctx);
+        }
+        ctx_mul_limbs(acc, acc, table[value >> 1], ctx);
+        i = lo - 1;
+    }
+    memcpy(r, acc, sizeof(acc));
+}
+
+// base^exp mod m in [0, m). exp must be non-negative: its sign is ignored,
+// so callers invert the base with modinv_int256 for a negative exponent.
+Int256 powmod_int256(const Int256Mont* ctx, Int256 base, Int256 exp) {
+    uint64_t e[4], x[4], acc[4];
+    int256_to_limbs(&exp, e);
+    reduce_limbs(x, base, ctx);
+    if (ctx->odd) mont_mul_limbs(x, x, ctx->r2, ctx);
+    mont_pow_limbs(acc, x, e, ctx);
+    return mont_from_int256(ctx, limbs_to_int256(acc, 0));
+}
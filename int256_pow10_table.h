@@ -0,0 +1,92 @@
+// Generated by tools/gen_pow10_table.c; do not edit.
+
+#ifndef INT256_POW10_TABLE_H
+#define INT256_POW10_TABLE_H
+
+#include "calc256.h"
+
+// 10^k for 0 <= k < POW10_TABLE_SIZE; 10^78 and up exceed 256 bits
+#define POW10_TABLE_SIZE 78
+
+static const Int256 pow10_table[POW10_TABLE_SIZE] = {
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000001ULL}, 0},   // 10^0
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000000000aULL}, 0},   // 10^1
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000064ULL}, 0},   // 10^2
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000003e8ULL}, 0},   // 10^3
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000002710ULL}, 0},   // 10^4
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000186a0ULL}, 0},   // 10^5
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000000f4240ULL}, 0},   // 10^6
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000989680ULL}, 0},   // 10^7
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000005f5e100ULL}, 0},   // 10^8
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000003b9aca00ULL}, 0},   // 10^9
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000002540be400ULL}, 0},   // 10^10
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000174876e800ULL}, 0},   // 10^11
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000e8d4a51000ULL}, 0},   // 10^12
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000009184e72a000ULL}, 0},   // 10^13
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00005af3107a4000ULL}, 0},   // 10^14
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00038d7ea4c68000ULL}, 0},   // 10^15
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x002386f26fc10000ULL}, 0},   // 10^16
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x016345785d8a0000ULL}, 0},   // 10^17
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0de0b6b3a7640000ULL}, 0},   // 10^18
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL}, 0},   // 10^19
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000005ULL, 0x6bc75e2d63100000ULL}, 0},   // 10^20
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000036ULL, 0x35c9adc5dea00000ULL}, 0},   // 10^21
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000000021eULL, 0x19e0c9bab2400000ULL}, 0},   // 10^22
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000000152dULL, 0x02c7e14af6800000ULL}, 0},   // 10^23
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000000d3c2ULL, 0x1bcecceda1000000ULL}, 0},   // 10^24
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000084595ULL, 0x161401484a000000ULL}, 0},   // 10^25
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000000000052b7d2ULL, 0xdcc80cd2e4000000ULL}, 0},   // 10^26
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000033b2e3cULL, 0x9fd0803ce8000000ULL}, 0},   // 10^27
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000000204fce5eULL, 0x3e25026110000000ULL}, 0},   // 10^28
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00000001431e0faeULL, 0x6d7217caa0000000ULL}, 0},   // 10^29
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000c9f2c9cd0ULL, 0x4674edea40000000ULL}, 0},   // 10^30
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000007e37be2022ULL, 0xc0914b2680000000ULL}, 0},   // 10^31
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x000004ee2d6d415bULL, 0x85acef8100000000ULL}, 0},   // 10^32
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000314dc6448d93ULL, 0x38c15b0a00000000ULL}, 0},   // 10^33
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0001ed09bead87c0ULL, 0x378d8e6400000000ULL}, 0},   // 10^34
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0013426172c74d82ULL, 0x2b878fe800000000ULL}, 0},   // 10^35
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x00c097ce7bc90715ULL, 0xb34b9f1000000000ULL}, 0},   // 10^36
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x0785ee10d5da46d9ULL, 0x00f436a000000000ULL}, 0},   // 10^37
+    {{0x0000000000000000ULL, 0x0000000000000000ULL, 0x4b3b4ca85a86c47aULL, 0x098a224000000000ULL}, 0},   // 10^38
+    {{0x0000000000000000ULL, 0x0000000000000002ULL, 0xf050fe938943acc4ULL, 0x5f65568000000000ULL}, 0},   // 10^39
+    {{0x0000000000000000ULL, 0x000000000000001dULL, 0x6329f1c35ca4bfabULL, 0xb9f5610000000000ULL}, 0},   // 10^40
+    {{0x0000000000000000ULL, 0x0000000000000125ULL, 0xdfa371a19e6f7cb5ULL, 0x4395ca0000000000ULL}, 0},   // 10^41
+    {{0x0000000000000000ULL, 0x0000000000000b7aULL, 0xbc627050305adf14ULL, 0xa3d9e40000000000ULL}, 0},   // 10^42
+    {{0x0000000000000000ULL, 0x00000000000072cbULL, 0x5bd86321e38cb6ceULL, 0x6682e80000000000ULL}, 0},   // 10^43
+    {{0x0000000000000000ULL, 0x0000000000047bf1ULL, 0x9673df52e37f2410ULL, 0x011d100000000000ULL}, 0},   // 10^44
+    {{0x0000000000000000ULL, 0x00000000002cd76fULL, 0xe086b93ce2f768a0ULL, 0x0b22a00000000000ULL}, 0},   // 10^45
+    {{0x0000000000000000ULL, 0x0000000001c06a5eULL, 0xc5433c60ddaa1640ULL, 0x6f5a400000000000ULL}, 0},   // 10^46
+    {{0x0000000000000000ULL, 0x00000000118427b3ULL, 0xb4a05bc8a8a4de84ULL, 0x5986800000000000ULL}, 0},   // 10^47
+    {{0x0000000000000000ULL, 0x00000000af298d05ULL, 0x0e4395d69670b12bULL, 0x7f41000000000000ULL}, 0},   // 10^48
+    {{0x0000000000000000ULL, 0x00000006d79f8232ULL, 0x8ea3da61e066ebb2ULL, 0xf88a000000000000ULL}, 0},   // 10^49
+    {{0x0000000000000000ULL, 0x000000446c3b15f9ULL, 0x926687d2c40534fdULL, 0xb564000000000000ULL}, 0},   // 10^50
+    {{0x0000000000000000ULL, 0x000002ac3a4edbbfULL, 0xb8014e3ba83411e9ULL, 0x15e8000000000000ULL}, 0},   // 10^51
+    {{0x0000000000000000ULL, 0x00001aba4714957dULL, 0x300d0e549208b31aULL, 0xdb10000000000000ULL}, 0},   // 10^52
+    {{0x0000000000000000ULL, 0x00010b46c6cdd6e3ULL, 0xe0828f4db456ff0cULL, 0x8ea0000000000000ULL}, 0},   // 10^53
+    {{0x0000000000000000ULL, 0x000a70c3c40a64e6ULL, 0xc51999090b65f67dULL, 0x9240000000000000ULL}, 0},   // 10^54
+    {{0x0000000000000000ULL, 0x006867a5a867f103ULL, 0xb2fffa5a71fba0e7ULL, 0xb680000000000000ULL}, 0},   // 10^55
+    {{0x0000000000000000ULL, 0x04140c78940f6a24ULL, 0xfdffc78873d4490dULL, 0x2100000000000000ULL}, 0},   // 10^56
+    {{0x0000000000000000ULL, 0x28c87cb5c89a2571ULL, 0xebfdcb54864ada83ULL, 0x4a00000000000000ULL}, 0},   // 10^57
+    {{0x0000000000000001ULL, 0x97d4df19d6057673ULL, 0x37e9f14d3eec8920ULL, 0xe400000000000000ULL}, 0},   // 10^58
+    {{0x000000000000000fULL, 0xee50b7025c36a080ULL, 0x2f236d04753d5b48ULL, 0xe800000000000000ULL}, 0},   // 10^59
+    {{0x000000000000009fULL, 0x4f2726179a224501ULL, 0xd762422c946590d9ULL, 0x1000000000000000ULL}, 0},   // 10^60
+    {{0x0000000000000639ULL, 0x17877cec0556b212ULL, 0x69d695bdcbf7a87aULL, 0xa000000000000000ULL}, 0},   // 10^61
+    {{0x0000000000003e3aULL, 0xeb4ae1383562f4b8ULL, 0x2261d969f7ac94caULL, 0x4000000000000000ULL}, 0},   // 10^62
+    {{0x0000000000026e4dULL, 0x30eccc3215dd8f31ULL, 0x57d27e23acbdcfe6ULL, 0x8000000000000000ULL}, 0},   // 10^63
+    {{0x0000000000184f03ULL, 0xe93ff9f4daa797edULL, 0x6e38ed64bf6a1f01ULL, 0x0000000000000000ULL}, 0},   // 10^64
+    {{0x0000000000f31627ULL, 0x1c7fc3908a8bef46ULL, 0x4e3945ef7a25360aULL, 0x0000000000000000ULL}, 0},   // 10^65
+    {{0x00000000097edd87ULL, 0x1cfda3a5697758bfULL, 0x0e3cbb5ac5741c64ULL, 0x0000000000000000ULL}, 0},   // 10^66
+    {{0x000000005ef4a747ULL, 0x21e864761ea97776ULL, 0x8e5f518bb6891be8ULL, 0x0000000000000000ULL}, 0},   // 10^67
+    {{0x00000003b58e88c7ULL, 0x5313ec9d329eaaa1ULL, 0x8fb92f75215b1710ULL, 0x0000000000000000ULL}, 0},   // 10^68
+    {{0x00000025179157c9ULL, 0x3ec73e23fa32aa4fULL, 0x9d3bda934d8ee6a0ULL, 0x0000000000000000ULL}, 0},   // 10^69
+    {{0x00000172ebad6ddcULL, 0x73c86d67c5faa71cULL, 0x245689c107950240ULL, 0x0000000000000000ULL}, 0},   // 10^70
+    {{0x00000e7d34c64a9cULL, 0x85d4460dbbca8719ULL, 0x6b61618a4bd21680ULL, 0x0000000000000000ULL}, 0},   // 10^71
+    {{0x000090e40fbeea1dULL, 0x3a4abc8955e946feULL, 0x31cdcf66f634e100ULL, 0x0000000000000000ULL}, 0},   // 10^72
+    {{0x0005a8e89d752524ULL, 0x46eb5d5d5b1cc5edULL, 0xf20a1a059e10ca00ULL, 0x0000000000000000ULL}, 0},   // 10^73
+    {{0x003899162693736aULL, 0xc531a5a58f1fbb4bULL, 0x746504382ca7e400ULL, 0x0000000000000000ULL}, 0},   // 10^74
+    {{0x0235fadd81c2822bULL, 0xb3f07877973d50f2ULL, 0x8bf22a31be8ee800ULL, 0x0000000000000000ULL}, 0},   // 10^75
+    {{0x161bcca7119915b5ULL, 0x0764b4abe8652979ULL, 0x7775a5f171951000ULL, 0x0000000000000000ULL}, 0},   // 10^76
+    {{0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL, 0xaa987b6e6fd2a000ULL, 0x0000000000000000ULL}, 0},   // 10^77
+};
+
+#endif // INT256_POW10_TABLE_H
@@ -0,0 +1,446 @@
+// libcalc256: primality testing and factorization.
+
+#include "calc256_internal.h"
+#include "int256_prime_table.h"
+
+#define PRIME_TEST_ROUNDS 24        // Miller-Rabin bases above the exact range
+#define PRIME_TEST_TRIAL_GROUPS 8   // small_prime_groups tried before Miller-Rabin
+#define RHO_BATCH 128               // |x - y| products per gcd
+#define RHO_ITERATIONS (1u << 20)   // cycle length searched before giving up
+#define RHO_ATTEMPTS 3              // polynomials x^2 + c tried when gcd = n
+
+// n < 3317044064679887385961981 is prime exactly when it passes
+// Miller-Rabin to the 13 prime bases 2..41
+static const uint64_t exact_limit[4] = {0x51adc5b22410a5fdULL, 0x000000000002be69ULL, 0, 0};
+static const uint64_t exact_bases[13] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+
+// Below 2^64 these seven bases are enough (Sinclair)
+static const uint64_t word_bases[7] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+// Further Miller-Rabin bases: a splitmix64 stream seeded from n
+static inline uint64_t next_base(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// ==================== TRIAL DIVISION ====================
+
+// x mod d for little-endian limbs
+static uint64_t mod_limbs_word(const uint64_t* x, int n, uint64_t d) {
+    uint64_t r = 0;
+    for (int i = n - 1; i >= 0; i--) udiv128_64(r, x[i], d, &r);
+    return r;
+}
+
+// x /= d, for d dividing x
+static void div_limbs_word(uint64_t x[4], uint64_t d) {
+    uint64_t r = 0;
+    for (int i = 3; i >= 0; i--) x[i] = udiv128_64(r, x[i], d, &r);
+}
+
+static inline int small_prime_divides(uint64_t r, int i) {
+    return r * small_primes[i].inv <= small_primes[i].lim;
+}
+
+// Smallest prime of the first groups of small_primes dividing x, or 0.
+// One remainder per group, then a multiply and compare per prime.
+static uint64_t small_prime_factor(const uint64_t x[4], int groups) {
+    int len = limbs_len(x, 4), start = 0;
+    for (int g = 0; g < groups; g++) {
+        uint64_t r = mod_limbs_word(x, len, small_prime_groups[g].product);
+        for (int i = start; i < small_prime_groups[g].end; i++) {
+            if (small_prime_divides(r, i)) return small_primes[i].p;
+        }
+        start = small_prime_groups[g].end;
+    }
+    return 0;
+}
+
+// ==================== 64-BIT MILLER-RABIN ====================
+
+typedef struct {
+    uint64_t n;
+    uint64_t inv;   // n^-1 mod 2^64
+    uint64_t one;   // 2^64 mod n
+    uint64_t r2;    // 2^128 mod n
+} Mont64;
+
+static void mont64_init(Mont64* m, uint64_t n) {
+    m->n = n;
+    m->inv = inverse_word(n);
+    m->one = (0 - n) % n;
+    m->r2 = (uint64_t)(((__uint128_t)m->one * m->one) % n);
+}
+
+// a * b * 2^-64 mod n; the high halves are subtracted so nothing overflows
+static inline uint64_t mont64_mul(uint64_t a, uint64_t b, const Mont64* m) {
+    __uint128_t t = (__uint128_t)a * b;
+    uint64_t q = (uint64_t)t * m->inv;
+    uint64_t h = (uint64_t)(((__uint128_t)q * m->n) >> 64);
+    uint64_t hi = (uint64_t)(t >> 64);
+    return hi >= h ? hi - h : hi - h + m->n;
+}
+
+static inline uint64_t mont64_add(uint64_t a, uint64_t b, const Mont64* m) {
+    uint64_t s = a + b;
+    return (s < a || s >= m->n) ? s - m->n : s;
+}
+
+// One round to base a for odd n with n - 1 = d 2^s
+static int miller_rabin_word(const Mont64* m, uint64_t a, uint64_t d, int s) {
+    a %= m->n;
+    if (a == 0) return 1;
+    uint64_t base = mont64_mul(a, m->r2, m), x = m->one;
+    for (; d; d >>= 1) {
+        if (d & 1) x = mont64_mul(x, base, m);
+        base = mont64_mul(base, base, m);
+    }
+    uint64_t minus_one = m->n - m->one;
+    if (x == m->one || x == minus_one) return 1;
+    for (int i = 1; i < s; i++) {
+        x = mont64_mul(x, x, m);
+        if (x == minus_one) return 1;
+        if (x == m->one) return 0;
+    }
+    return 0;
+}
+
+// Exact primality for one word: trial division while it can settle the
+// answer cheaply, then the seven-base Miller-Rabin test
+static int isprime_word(uint64_t n) {
+    if (n < 2) return 0;
+    if (!(n & 1)) return n == 2;
+    for (int i = 0; i < SMALL_PRIME_COUNT && i < 64; i++) {
+        uint64_t p = small_primes[i].p;
+        if (p * p > n) return 1;
+        if (small_prime_divides(n, i)) return 0;
+    }
+    Mont64 m;
+    mont64_init(&m, n);
+    int s = __builtin_ctzll(n - 1);
+    for (int i = 0; i < 7; i++) {
+        if (!miller_rabin_word(&m, word_bases[i], (n - 1) >> s, s)) return 0;
+    }
+    return 1;
+}
+
+// ==================== MILLER-RABIN ====================
+
+// Miller-Rabin state for an odd n > 2^64
+typedef struct {
+    Int256Mont ctx;
+    uint64_t n[4];
+    uint64_t d[4];           // n - 1 = d 2^s
+    int s;
+    uint64_t minus_one[4];   // n - 1 in Montgomery form
+} MillerRabin;
+
+static void miller_rabin_init(MillerRabin* mr, const uint64_t n[4]) {
+    mont_init_int256(&mr->ctx, limbs_to_int256(n, 0));
+    memcpy(mr->n, n, sizeof(mr->n));
+    memcpy(mr->d, n, sizeof(mr->d));
+    mr->d[0]--;   // n is odd: no borrow
+    mr->s = ctz_limbs_4(mr->d);
+    shr_limbs_4(mr->d, mr->s);
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; i++) mr->minus_one[i] = sub_with_borrow(n[i], mr->ctx.one[i], &borrow);
+}
+
+// One round to a single-word base a < n
+static int miller_rabin_round(const MillerRabin* mr, uint64_t a) {
+    uint64_t x[4] = {a, 0, 0, 0};
+    mont_mul_limbs(x, x, mr->ctx.r2, &mr->ctx);
+    mont_pow_limbs(x, x, mr->d, &mr->ctx);
+    if (cmp_limbs_4(x, mr->ctx.one) == 0 || cmp_limbs_4(x, mr->minus_one) == 0) return 1;
+    for (int i = 1; i < mr->s; i++) {
+        mont_sqr_limbs(x, x, &mr->ctx);
+        if (cmp_limbs_4(x, mr->minus_one) == 0) return 1;
+        if (cmp_limbs_4(x, mr->ctx.one) == 0) return 0;
+    }
+    return 0;
+}
+
+// Base 2, then rounds - 1 bases below 2^63 derived from n (odd, > 2^64)
+static int miller_rabin_limbs(const uint64_t n[4], int rounds) {
+    MillerRabin mr;
+    miller_rabin_init(&mr, n);
+    if (!miller_rabin_round(&mr, 2)) return 0;
+    uint64_t state = n[0] ^ n[1] ^ n[2] ^ n[3];
+    for (int i = 1; i < rounds; i++) {
+        if (!miller_rabin_round(&mr, 2 + (next_base(&state) >> 1))) return 0;
+    }
+    return 1;
+}
+
+// Primality of x > 2^64 with no factor among the first trial groups
+static int prime_test_limbs(const uint64_t x[4]) {
+    if (cmp_limbs_4(x, exact_limit) < 0) {
+        MillerRabin mr;
+        miller_rabin_init(&mr, x);
+        for (int i = 0; i < 13; i++) {
+            if (!miller_rabin_round(&mr, exact_bases[i])) return 0;
+        }
+        return 1;
+    }
+    return miller_rabin_limbs(x, PRIME_TEST_ROUNDS);
+}
+
+int isprime_int256(Int256 n) {
+    uint64_t x[4];
+    int256_to_limbs(&n, x);
+    int len = limbs_len(x, 4);
+    if (n.sign) return 0;
+    if (len <= 1) return isprime_word(x[0]);
+    if (!(x[0] & 1) || small_prime_factor(x, PRIME_TEST_TRIAL_GROUPS) != 0) return 0;
+    return prime_test_limbs(x);
+}
+
+int miller_rabin_int256(Int256 n, int rounds) {
+    uint64_t x[4];
+    int256_to_limbs(&n, x);
+    int len = limbs_len(x, 4);
+    if (n.sign || (len <= 1 && x[0] < 2)) return 0;
+    if (!(x[0] & 1)) return len == 1 && x[0] == 2;
+    if (len <= 1) {
+        if (x[0] < 5) return 1;
+        Mont64 m;
+        mont64_init(&m, x[0]);
+        int s = __builtin_ctzll(x[0] - 1);
+        uint64_t state = x[0];
+        if (!miller_rabin_word(&m, 2, (x[0] - 1) >> s, s)) return 0;
+        for (int i = 1; i < rounds; i++) {
+            uint64_t a = 2 + next_base(&state) % (x[0] - 3);
+            if (!miller_rabin_word(&m, a, (x[0] - 1) >> s, s)) return 0;
+        }
+        return 1;
+    }
+    return miller_rabin_limbs(x, rounds);
+}
+
+// ==================== POLLARD-BRENT RHO ====================
+//
+// Brent's cycle finding on x -> x^2 + c, in Montgomery form. The
+// differences |x - y| are multiplied together and one gcd is taken per
+// RHO_BATCH of them; if that gcd is n, the batch is replayed one step at a
+// time. A collapsed cycle (gcd = n) moves on to the next c; running out of
+// iterations gives up.
+
+// Nontrivial factor of an odd composite n < 2^64, or 0
+static uint64_t rho_word(uint64_t n) {
+    Mont64 m;
+    mont64_init(&m, n);
+    for (uint64_t c = 1; c <= RHO_ATTEMPTS; c++) {
+        uint64_t cm = mont64_mul(c, m.r2, &m);
+        uint64_t y = m.one, x = y, ys = y, q = m.one, g = 1;
+        for (uint32_t r = 1; g == 1 && r <= RHO_ITERATIONS; r *= 2) {
+            x = y;
+            for (uint32_t i = 0; i < r; i++) y = mont64_add(mont64_mul(y, y, &m), cm, &m);
+            for (uint32_t k = 0; k < r && g == 1; k += RHO_BATCH) {
+                ys = y;
+                for (uint32_t i = 0; i < RHO_BATCH && i < r - k; i++) {
+                    y = mont64_add(mont64_mul(y, y, &m), cm, &m);
+                    q = mont64_mul(q, x > y ? x - y : y - x, &m);
+                }
+                g = q ? gcd_word(q, n) : n;
+            }
+        }
+        if (g == 1) return 0;
+        if (g == n) {
+            do {
+                ys = mont64_add(mont64_mul(ys, ys, &m), cm, &m);
+                g = x != ys ? gcd_word(x > ys ? x - ys : ys - x, n) : n;
+            } while (g == 1);
+        }
+        if (g != 1 && g != n) return g;
+    }
+    return 0;
+}
+
+static inline void rho_step(uint64_t y[4], const uint64_t c[4], const Int256Mont* ctx) {
+    uint64_t t[4], carry = 0, borrow = 0;
+    mont_sqr_limbs(t, y, ctx);
+    for (int i = 0; i < 4; i++) y[i] = add_with_carry(t[i], c[i], &carry);
+    if (carry || cmp_limbs_4(y, ctx->n) >= 0) {
+        for (int i = 0; i < 4; i++) y[i] = sub_with_borrow(y[i], ctx->n[i], &borrow);
+    }
+}
+
+static inline void sub_abs_limbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t borrow = 0;
+    if (cmp_limbs_4(a, b) < 0) {
+        const uint64_t* t = a;
+        a = b;
+        b = t;
+    }
+    for (int i = 0; i < 4; i++) r[i] = sub_with_borrow(a[i], b[i], &borrow);
+}
+
+// Nontrivial factor of an odd composite n >= 2^64 into d; returns 0 on
+// success, -1 if the budget ran out
+static int rho_limbs(uint64_t d[4], const uint64_t n[4]) {
+    Int256Mont ctx;
+    mont_init_int256(&ctx, limbs_to_int256(n, 0));
+    for (uint64_t c = 1; c <= RHO_ATTEMPTS; c++) {
+        uint64_t cm[4] = {c, 0, 0, 0}, y[4], x[4], ys[4], q[4], diff[4];
+        mont_mul_limbs(cm, cm, ctx.r2, &ctx);
+        memcpy(y, ctx.one, sizeof(y));
+        memcpy(x, y, sizeof(x));
+        memcpy(ys, y, sizeof(ys));
+        memcpy(q, ctx.one, sizeof(q));
+        int found = 0;
+        for (uint32_t r = 1; !found && r <= RHO_ITERATIONS; r *= 2) {
+            memcpy(x, y, sizeof(x));
+            for (uint32_t i = 0; i < r; i++) rho_step(y, cm, &ctx);
+            for (uint32_t k = 0; k < r && !found; k += RHO_BATCH) {
+                memcpy(ys, y, sizeof(ys));
+                for (uint32_t i = 0; i < RHO_BATCH && i < r - k; i++) {
+                    rho_step(y, cm, &ctx);
+                    sub_abs_limbs(diff, x, y);
+                    mont_mul_limbs(q, q, diff, &ctx);
+                }
+                gcd_limbs(d, q, n);
+                found = !(d[0] == 1 && limbs_len(d, 4) == 1);
+            }
+        }
+        if (!found) return -1;
+        if (cmp_limbs_4(d, n) == 0) {
+            do {
+                rho_step(ys, cm, &ctx);
+                sub_abs_limbs(diff, x, ys);
+                gcd_limbs(d, diff, n);
+            } while (d[0] == 1 && limbs_len(d, 4) == 1);
+        }
+        if (cmp_limbs_4(d, n) != 0) return 0;
+    }
+    return -1;
+}
+
+// ==================== FACTORIZATION ====================
+
+// Adds p^e to the prime part of out (kept sorted) or to the composite tail
+static void factors_add(Int256Factors* out, const uint64_t p[4], unsigned int e, int prime) {
+    Int256 v = limbs_to_int256(p, 0);
+    int lo = prime ? 0 : out->count - out->composite;
+    int hi = prime ? out->count - out->composite : out->count;
+    int i = lo;
+    while (i < hi && cmp_int256(out->factor[i], v) < 0) i++;
+    if (i < hi && cmp_int256(out->factor[i], v) == 0) {
+        out->exponent[i] += e;
+        return;
+    }
+    if (out->count == INT256_MAX_FACTORS) return;
+    memmove(&out->factor[i + 1], &out->factor[i], (size_t)(out->count - i) * sizeof(Int256));
+    memmove(&out->exponent[i + 1], &out->exponent[i],
+            (size_t)(out->count - i) * sizeof(unsigned int));
+    out->factor[i] = v;
+    out->exponent[i] = e;
+    out->count++;
+    if (!prime) out->composite++;
+}
+
+// Divides every prime of small_primes out of odd x
+static void trial_divide(uint64_t x[4], Int256Factors* out) {
+    int start = 0;
+    for (int g = 0; g < SMALL_PRIME_GROUPS; g++) {
+        int len = limbs_len(x, 4);
+        uint64_t p0 = small_primes[start].p;
+        if (len == 1 && x[0] < p0 * p0) return;
+        uint64_t r = mod_limbs_word(x, len, small_prime_groups[g].product);
+        for (int i = start; i < small_prime_groups[g].end; i++) {
+            if (!small_prime_divides(r, i)) continue;
+            uint64_t p = small_primes[i].p, pl[4] = {p, 0, 0, 0};
+            unsigned int e = 0;
+            do {
+                div_limbs_word(x, p);
+                e++;
+            } while (mod_limbs_word(x, limbs_len(x, 4), p) == 0);
+            factors_add(out, pl, e, 1);
+        }
+        start = small_prime_groups[g].end;
+    }
+}
+
+// If x = r^k for some k > 1, stores the largest such k with its root
+static unsigned int perfect_power(uint64_t r[4], const uint64_t x[4]) {
+    Int256 v = limbs_to_int256(x, 0), root;
+    // No prime factor of x is below SMALL_PRIME_LIMIT (2^12)
+    unsigned int max_k = (unsigned int)limbs_bits(x, 4) / 12;
+    for (unsigned int k = max_k; k >= 2; k--) {
+        Int256 back;
+        iroot_int256(v, k, &root);
+        if (pow_int256_checked(root, k, &back) == INT256_OK && cmp_int256(back, v) == 0) {
+            int256_to_limbs(&root, r);
+            return k;
+        }
+    }
+    return 1;
+}
+
+int factor_int256(Int256 n, Int256Factors* out) {
+    uint64_t x[4];
+    memset(out, 0, sizeof(*out));
+    int256_to_limbs(&n, x);
+    int len = limbs_len(x, 4);
+    if (len == 0 || (len == 1 && x[0] == 1)) return 0;
+
+    int z = ctz_limbs_4(x);
+    if (z) {
+        uint64_t two[4] = {2, 0, 0, 0};
+        factors_add(out, two, (unsigned int)z, 1);
+        shr_limbs_4(x, z);
+    }
+    trial_divide(x, out);
+
+    // Cofactors still to split, with their multiplicity
+    uint64_t stack[INT256_MAX_FACTORS][4];
+    unsigned int stack_exp[INT256_MAX_FACTORS];
+    int top = 0;
+    memcpy(stack[top], x, sizeof(x));
+    stack_exp[top++] = 1;
+
+    while (top > 0) {
+        uint64_t c[4], d[4];
+        top--;
+        memcpy(c, stack[top], sizeof(c));
+        unsigned int e = stack_exp[top];
+        len = limbs_len(c, 4);
+        if (len == 1 && c[0] == 1) continue;
+
+        // Every prime factor is at least SMALL_PRIME_LIMIT now
+        int prime = len == 1 ? (c[0] < (uint64_t)SMALL_PRIME_LIMIT * SMALL_PRIME_LIMIT ||
+                                isprime_word(c[0]))
+                             : prime_test_limbs(c);
+        if (prime) {
+            factors_add(out, c, e, 1);
+            continue;
+        }
+        unsigned int k = perfect_power(d, c);
+        if (k > 1) {
+            memcpy(stack[top], d, sizeof(d));
+            stack_exp[top++] = e * k;
+            continue;
+        }
+
+        int split;
+        if (len == 1) {
+            memset(d, 0, sizeof(d));
+            d[0] = rho_word(c[0]);
+            split = d[0] != 0;
+        } else {
+            split = rho_limbs(d, c) == 0;
+        }
+        if (!split || top + 2 > INT256_MAX_FACTORS) {
+            factors_add(out, c, e, 0);
+            continue;
+        }
+        uint64_t q[4] = {0, 0, 0, 0};
+        divmod_limbs(q, NULL, c, len, d, limbs_len(d, 4));
+        memcpy(stack[top], d, sizeof(d));
+        stack_exp[top++] = e;
+        memcpy(stack[top], q, sizeof(q));
+        stack_exp[top++] = e;
+    }
+    return out->count;
+}
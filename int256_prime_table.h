@@ -0,0 +1,696 @@
+// Generated by tools/gen_prime_table.c; do not edit.
+
+#ifndef INT256_PRIME_TABLE_H
+#define INT256_PRIME_TABLE_H
+
+#include <stdint.h>
+
+// Odd primes below SMALL_PRIME_LIMIT. x is divisible by p exactly when
+// x * inv <= lim modulo 2^64 (inv = p^-1 mod 2^64, lim = (2^64 - 1) / p).
+#define SMALL_PRIME_LIMIT 4096
+#define SMALL_PRIME_COUNT 563
+
+typedef struct {
+    uint64_t inv;
+    uint64_t lim;
+    uint64_t p;
+} SmallPrime;
+
+static const SmallPrime small_primes[SMALL_PRIME_COUNT] = {
+    {0xaaaaaaaaaaaaaaabULL, 0x5555555555555555ULL, 3},
+    {0xcccccccccccccccdULL, 0x3333333333333333ULL, 5},
+    {0x6db6db6db6db6db7ULL, 0x2492492492492492ULL, 7},
+    {0x2e8ba2e8ba2e8ba3ULL, 0x1745d1745d1745d1ULL, 11},
+    {0x4ec4ec4ec4ec4ec5ULL, 0x13b13b13b13b13b1ULL, 13},
+    {0xf0f0f0f0f0f0f0f1ULL, 0x0f0f0f0f0f0f0f0fULL, 17},
+    {0x86bca1af286bca1bULL, 0x0d79435e50d79435ULL, 19},
+    {0xd37a6f4de9bd37a7ULL, 0x0b21642c8590b216ULL, 23},
+    {0x34f72c234f72c235ULL, 0x08d3dcb08d3dcb08ULL, 29},
+    {0xef7bdef7bdef7bdfULL, 0x0842108421084210ULL, 31},
+    {0x14c1bacf914c1badULL, 0x06eb3e45306eb3e4ULL, 37},
+    {0x8f9c18f9c18f9c19ULL, 0x063e7063e7063e70ULL, 41},
+    {0x82fa0be82fa0be83ULL, 0x05f417d05f417d05ULL, 43},
+    {0x51b3bea3677d46cfULL, 0x0572620ae4c415c9ULL, 47},
+    {0x21cfb2b78c13521dULL, 0x04d4873ecade304dULL, 53},
+    {0xcbeea4e1a08ad8f3ULL, 0x0456c797dd49c341ULL, 59},
+    {0x4fbcda3ac10c9715ULL, 0x04325c53ef368eb0ULL, 61},
+    {0xf0b7672a07a44c6bULL, 0x03d226357e16ece5ULL, 67},
+    {0x193d4bb7e327a977ULL, 0x039b0ad12073615aULL, 71},
+    {0x7e3f1f8fc7e3f1f9ULL, 0x0381c0e070381c0eULL, 73},
+    {0x9b8b577e613716afULL, 0x033d91d2a2067b23ULL, 79},
+    {0xa3784a062b2e43dbULL, 0x03159721ed7e7534ULL, 83},
+    {0xf47e8fd1fa3f47e9ULL, 0x02e05c0b81702e05ULL, 89},
+    {0xa3a0fd5c5f02a3a1ULL, 0x02a3a0fd5c5f02a3ULL, 97},
+    {0x3a4c0a237c32b16dULL, 0x0288df0cac5b3f5dULL, 101},
+    {0xdab7ec1dd3431b57ULL, 0x027c45979c95204fULL, 103},
+    {0x77a04c8f8d28ac43ULL, 0x02647c69456217ecULL, 107},
+    {0xa6c0964fda6c0965ULL, 0x02593f69b02593f6ULL, 109},
+    {0x90fdbc090fdbc091ULL, 0x0243f6f0243f6f02ULL, 113},
+    {0x7efdfbf7efdfbf7fULL, 0x0204081020408102ULL, 127},
+    {0x03e88cb3c9484e2bULL, 0x01f44659e4a42715ULL, 131},
+    {0xe21a291c077975b9ULL, 0x01de5d6e3f8868a4ULL, 137},
+    {0x3aef6ca970586723ULL, 0x01d77b654b82c339ULL, 139},
+    {0xdf5b0f768ce2cabdULL, 0x01b7d6c3dda338b2ULL, 149},
+    {0x6fe4dfc9bf937f27ULL, 0x01b2036406c80d90ULL, 151},
+    {0x5b4fe5e92c0685b5ULL, 0x01a16d3f97a4b01aULL, 157},
+    {0x1f693a1c451ab30bULL, 0x01920fb49d0e228dULL, 163},
+    {0x8d07aa27db35a717ULL, 0x01886e5f0abb0499ULL, 167},
+    {0x882383b30d516325ULL, 0x017ad2208e0ecc35ULL, 173},
+    {0xed6866f8d962ae7bULL, 0x016e1f76b4337c6cULL, 179},
+    {0x3454dca410f8ed9dULL, 0x016a13cd15372904ULL, 181},
+    {0x1d7ca632ee936f3fULL, 0x01571ed3c506b39aULL, 191},
+    {0x70bf015390948f41ULL, 0x015390948f40feacULL, 193},
+    {0xc96bdb9d3d137e0dULL, 0x014cab88725af6e7ULL, 197},
+    {0x2697cc8aef46c0f7ULL, 0x0149539e3b2d066eULL, 199},
+    {0xc0e8f2a76e68575bULL, 0x013698df3de07479ULL, 211},
+    {0x687763dfdb43bb1fULL, 0x0125e22708092f11ULL, 223},
+    {0x1b10ea929ba144cbULL, 0x0120b470c67c0d88ULL, 227},
+    {0x1d10c4c0478bbcedULL, 0x011e2ef3b3fb8744ULL, 229},
+    {0x63fb9aeb1fdcd759ULL, 0x0119453808ca29c0ULL, 233},
+    {0x64afaa4f437b2e0fULL, 0x0112358e75d30336ULL, 239},
+    {0xf010fef010fef011ULL, 0x010fef010fef010fULL, 241},
+    {0x28cbfbeb9a020a33ULL, 0x0105197f7d734041ULL, 251},
+    {0xff00ff00ff00ff01ULL, 0x00ff00ff00ff00ffULL, 257},
+    {0xd624fd1470e99cb7ULL, 0x00f92fb2211855a8ULL, 263},
+    {0x8fb3ddbd6205b5c5ULL, 0x00f3a0d52cba8723ULL, 269},
+    {0xd57da36ca27acdefULL, 0x00f1d48bcee0d399ULL, 271},
+    {0xee70c03b25e4463dULL, 0x00ec979118f3fc4dULL, 277},
+    {0xc5b1a6b80749cb29ULL, 0x00e939651fe2d8d3ULL, 281},
+    {0x47768073c9b97113ULL, 0x00e79372e225fe30ULL, 283},
+    {0x2591e94884ce32adULL, 0x00dfac1f74346c57ULL, 293},
+    {0xf02806abc74be1fbULL, 0x00d578e97c3f5fe5ULL, 307},
+    {0x7ec3e8f3a7198487ULL, 0x00d2ba083b445250ULL, 311},
+    {0x58550f8a39409d09ULL, 0x00d161543e28e502ULL, 313},
+    {0xec9e48ae6f71de15ULL, 0x00cebcf8bb5b4169ULL, 317},
+    {0x2ff3a018bfce8063ULL, 0x00c5fe740317f9d0ULL, 331},
+    {0x7f9ec3fcf61fe7b1ULL, 0x00c2780613c0309eULL, 337},
+    {0x89f5abe570e046d3ULL, 0x00bcdd535db1cc5bULL, 347},
+    {0xda971b23f1545af5ULL, 0x00bbc8408cd63069ULL, 349},
+    {0x79d5f00b9a7862a1ULL, 0x00b9a7862a0ff465ULL, 353},
+    {0x4dba1df32a128a57ULL, 0x00b68d31340e4307ULL, 359},
+    {0x87530217b7747d8fULL, 0x00b2927c29da5519ULL, 367},
+    {0x30baae53bb5e06ddULL, 0x00afb321a1496fdfULL, 373},
+    {0xee70206c12e9b5b3ULL, 0x00aceb0f891e6551ULL, 379},
+    {0xcdde9462ec9dbe7fULL, 0x00ab1cbdd3e2970fULL, 383},
+    {0xafb64b05ec41cf4dULL, 0x00a87917088e262bULL, 389},
+    {0x02944ff5aec02945ULL, 0x00a513fd6bb00a51ULL, 397},
+    {0x2cb033128382df71ULL, 0x00a36e71a2cb0331ULL, 401},
+    {0x1ccacc0c84b1c2a9ULL, 0x00a03c1688732b30ULL, 409},
+    {0x19a93db575eb3a0bULL, 0x009c69169b30446dULL, 419},
+    {0xcebeef94fa86fe2dULL, 0x009baade8e4a2f6eULL, 421},
+    {0x6faa77fb3f8df54fULL, 0x00980e4156201301ULL, 431},
+    {0x68a58af00975a751ULL, 0x00975a750ff68a58ULL, 433},
+    {0xd56e36d0c3efac07ULL, 0x009548e4979e0829ULL, 439},
+    {0xd8b44c47a8299b73ULL, 0x0093efd1c50e726bULL, 443},
+    {0x02d9ccaf9ba70e41ULL, 0x0091f5bcb8bb02d9ULL, 449},
+    {0x0985e1c023d9e879ULL, 0x008f67a1e3fdc261ULL, 457},
+    {0x2a343316c494d305ULL, 0x008e2917e0e702c6ULL, 461},
+    {0x70cb7916ab67652fULL, 0x008d8be33f95d715ULL, 463},
+    {0xd398f132fb10fe5bULL, 0x008c55841c815ed5ULL, 467},
+    {0x6f2a38a6bf54fa1fULL, 0x0088d180cd3a4133ULL, 479},
+    {0x211df689b98f81d7ULL, 0x00869222b1acf1ceULL, 487},
+    {0x0e994983e90f1ec3ULL, 0x0085797b917765abULL, 491},
+    {0xad671e44bed87f3bULL, 0x008355ace3c897dbULL, 499},
+    {0xf9623a0516e70fc7ULL, 0x00824a4e60b3262bULL, 503},
+    {0x4b7129be9dece355ULL, 0x0080c121b28bd1baULL, 509},
+    {0x190f3b7473f62c39ULL, 0x007dc9f3397d4c29ULL, 521},
+    {0x63dacc9aad46f9a3ULL, 0x007d4ece8fe88139ULL, 523},
+    {0xc1108fda24e8d035ULL, 0x0079237d65bcce50ULL, 541},
+    {0xb77578472319bd8bULL, 0x0077cf53c5f7936cULL, 547},
+    {0x473d20a1c7ed9da5ULL, 0x0075a8accfbdd11eULL, 557},
+    {0xfbe85af0fea2c8fbULL, 0x007467ac557c228eULL, 563},
+    {0x58a1f7e6ce0f4c09ULL, 0x00732d70ed8db8e9ULL, 569},
+    {0x1a00e58c544986f3ULL, 0x0072c62a24c3797fULL, 571},
+    {0x7194a17f55a10dc1ULL, 0x007194a17f55a10dULL, 577},
+    {0x7084944785e33763ULL, 0x006fa549b41da7e7ULL, 587},
+    {0xba10679bd84886b1ULL, 0x006e8419e6f61221ULL, 593},
+    {0xebe9c6bb31260967ULL, 0x006d68b5356c207bULL, 599},
+    {0x97a3fe4bd1ff25e9ULL, 0x006d0b803685c01bULL, 601},
+    {0x6c6388395b84d99fULL, 0x006bf790a8b2d207ULL, 607},
+    {0x8c51da6a1335df6dULL, 0x006ae907ef4b96c2ULL, 613},
+    {0x46f3234475d5add9ULL, 0x006a37991a23aeadULL, 617},
+    {0x905605ca3c619a43ULL, 0x0069dfbdd4295b66ULL, 619},
+    {0xcee8dff304767747ULL, 0x0067dc4c45c8033eULL, 631},
+    {0xff99c27f00663d81ULL, 0x00663d80ff99c27fULL, 641},
+    {0xacca407f671ddc2bULL, 0x0065ec17e3559948ULL, 643},
+    {0xe71298bac1e12337ULL, 0x00654ac835cfba5cULL, 647},
+    {0xfa1e94309cd09045ULL, 0x00645c854ae10772ULL, 653},
+    {0xbebccb8e91496b9bULL, 0x006372990e5f901fULL, 659},
+    {0x312fa30cc7d7b8bdULL, 0x006325913c07beefULL, 661},
+    {0x6160ff9e9f006161ULL, 0x006160ff9e9f0061ULL, 673},
+    {0x6b03673b5e28152dULL, 0x0060cdb520e5e88eULL, 677},
+    {0xfe802ffa00bfe803ULL, 0x005ff4017fd005ffULL, 683},
+    {0xe66fe25c9e907c7bULL, 0x005ed79e31a4dccdULL, 691},
+    {0x3f8b236c76528895ULL, 0x005d7d42d48ac5efULL, 701},
+    {0xf6f923bf01ce2c0dULL, 0x005c6f35ccba5028ULL, 709},
+    {0x6c3d3d98bed7c42fULL, 0x005b2618ec6ad0a5ULL, 719},
+    {0x30981efcd4b010e7ULL, 0x005a2553748e42e7ULL, 727},
+    {0x6f691fc81ebbe575ULL, 0x0059686cf744cd5bULL, 733},
+    {0xb10480ddb47b52cbULL, 0x0058ae97bab79976ULL, 739},
+    {0x74cd59ed64f3f0d7ULL, 0x0058345f1876865fULL, 743},
+    {0x0105cb81316d6c0fULL, 0x005743d5bb24795aULL, 751},
+    {0x9be64c6d91c1195dULL, 0x005692c4d1ab74abULL, 757},
+    {0x71b3f945a27b1f49ULL, 0x00561e46a4d5f337ULL, 761},
+    {0x77d80d50e508fd01ULL, 0x005538ed06533997ULL, 769},
+    {0xa5eb778e133551cdULL, 0x0054c807f2c0bec2ULL, 773},
+    {0x18657d3c2d8a3f1bULL, 0x005345efbc572d36ULL, 787},
+    {0x2e40e220c34ad735ULL, 0x00523a758f941345ULL, 797},
+    {0xa76593c70a714919ULL, 0x005102370f816c89ULL, 809},
+    {0x1eef452124eea383ULL, 0x0050cf129fb94acfULL, 811},
+    {0x38206dc242ba771dULL, 0x004fd31941cafdd1ULL, 821},
+    {0x4cd4c35807772287ULL, 0x004fa1704aa75945ULL, 823},
+    {0x83de917d5e69ddf3ULL, 0x004f3ed6d45a63adULL, 827},
+    {0x882ef0403b4a6c15ULL, 0x004f0de57154ebedULL, 829},
+    {0xf8fb6c51c606b677ULL, 0x004e1cae8815f811ULL, 839},
+    {0xb4abaac446d3e1fdULL, 0x004cd47ba5f6ff19ULL, 853},
+    {0xa9f83bbe484a14e9ULL, 0x004c78ae734df709ULL, 857},
+    {0x0bebbc0d1ce874d3ULL, 0x004c4b19ed85cfb8ULL, 859},
+    {0xbd418eaf0473189fULL, 0x004bf093221d1218ULL, 863},
+    {0x44e3af6f372b7e65ULL, 0x004aba3c21dc633fULL, 877},
+    {0xc87fdace4f9e5d91ULL, 0x004a6360c344de00ULL, 881},
+    {0xec93479c446bd9bbULL, 0x004a383e9f74d68aULL, 883},
+    {0xdac4d592e777c647ULL, 0x0049e28fbabb9940ULL, 887},
+    {0xa63ea8c8f61f0c23ULL, 0x0048417b57c78cd7ULL, 907},
+    {0xe476062ea5cbbb6fULL, 0x0047f043713f3a2bULL, 911},
+    {0xdf68761c69daac27ULL, 0x00474ff2a10281cfULL, 919},
+    {0xb813d737637aa061ULL, 0x00468b6f9a978f91ULL, 929},
+    {0xa3a77aac1fb15099ULL, 0x0045f13f1caff2e2ULL, 937},
+    {0x17f0c3e0712c5825ULL, 0x0045a5228cec23e9ULL, 941},
+    {0xfd912a70ff30637bULL, 0x0045342c556c66b9ULL, 947},
+    {0xfbb3b5dc01131289ULL, 0x0044c4a23feeced7ULL, 953},
+    {0x856d560a0f5acdf7ULL, 0x0043c5c20d3c9fe6ULL, 967},
+    {0x96472f314d3f89e3ULL, 0x00437e494b239798ULL, 971},
+    {0xa76f5c7ed2253531ULL, 0x0043142d118e47cbULL, 977},
+    {0x816eae7c7bf69fe7ULL, 0x0042ab5c73a13458ULL, 983},
+    {0xb6a2bea4cfb1781fULL, 0x004221950db0f3dbULL, 991},
+    {0xa3900c53318e81edULL, 0x0041bbb2f80a4553ULL, 997},
+    {0x60aa7f5d9f148d11ULL, 0x0040f391612c6680ULL, 1009},
+    {0x6be8c0102c7a505dULL, 0x0040b1e94173fefdULL, 1013},
+    {0x8ff3f0ed28728f33ULL, 0x004050647d9d0445ULL, 1019},
+    {0x680e0a87e5ec7155ULL, 0x004030241b144f3bULL, 1021},
+    {0xbbf70fa49fe829b7ULL, 0x003f90c2ab542cb1ULL, 1031},
+    {0xd69d1e7b6a50ca39ULL, 0x003f71412d59f597ULL, 1033},
+    {0x1a1e0f46b6d26aefULL, 0x003f137701b98841ULL, 1039},
+    {0x7429f9a7a8251829ULL, 0x003e79886b60e278ULL, 1049},
+    {0xd9c2219d1b863613ULL, 0x003e5b1916a7181dULL, 1051},
+    {0x91406c1820d077adULL, 0x003dc4a50968f524ULL, 1061},
+    {0x521f4ec02e3d2b97ULL, 0x003da6e4c9550321ULL, 1063},
+    {0xbb8283b63dc8eba5ULL, 0x003d4e4f06f1def3ULL, 1069},
+    {0x431eda153229ebbfULL, 0x003c4a6bdd24f9a4ULL, 1087},
+    {0xaf0bf78d7e01686bULL, 0x003c11d54b525c73ULL, 1091},
+    {0xa9ced0742c086e8dULL, 0x003bf5b1c5721065ULL, 1093},
+    {0xc26458ad9f632df9ULL, 0x003bbdb9862f23b4ULL, 1097},
+    {0xbbff1255dff892afULL, 0x003b6a8801db5440ULL, 1103},
+    {0xcbd49a333f04d8fdULL, 0x003b183cf0fed886ULL, 1109},
+    {0xec84ed6f9cfdeff5ULL, 0x003aabe394bdc3f4ULL, 1117},
+    {0x97980cc40bda9d4bULL, 0x003a5ba3e76156daULL, 1123},
+    {0x777f34d524f5cbd9ULL, 0x003a0c3e953378dbULL, 1129},
+    {0x2797051d94cbbb7fULL, 0x0038f03561320b1eULL, 1151},
+    {0xea769051b4f43b81ULL, 0x0038d6ecaef5908aULL, 1153},
+    {0xce7910f3034d4323ULL, 0x003859cf221e6069ULL, 1163},
+    {0x92791d1374f5b99bULL, 0x0037f7415dc9588aULL, 1171},
+    {0x89a5645cc68ea1b5ULL, 0x00377df0d3902626ULL, 1181},
+    {0x5f8aacf796c0cf0bULL, 0x00373622136907faULL, 1187},
+    {0xf2e90a15e33edf99ULL, 0x0036ef0c3b39b92fULL, 1193},
+    {0x8e99e5feb897c451ULL, 0x0036915f47d55e6dULL, 1201},
+    {0xaca2eda38fb91695ULL, 0x0036072cf3f866fdULL, 1213},
+    {0x5d9b737be5ea8b41ULL, 0x0035d9b737be5ea8ULL, 1217},
+    {0x4aefe1db93fd7cf7ULL, 0x0035961559cc81c7ULL, 1223},
+    {0xa0994ef20b3f8805ULL, 0x0035531c897a4592ULL, 1229},
+    {0x103890bda912822fULL, 0x00353ceebd3e98a4ULL, 1231},
+    {0xb441659d13a9147dULL, 0x0034fad381585e5eULL, 1237},
+    {0x1e2134440c4c3f21ULL, 0x00347884d1103130ULL, 1249},
+    {0x263a27727a6883c3ULL, 0x00340dd3ac39bf56ULL, 1259},
+    {0x78e221472ab33855ULL, 0x003351fdfecc140cULL, 1277},
+    {0x95eac88e82e6faffULL, 0x00333d72b089b524ULL, 1279},
+    {0xf66c258317be8dabULL, 0x0033148d44d6b261ULL, 1283},
+    {0x09ee202c7cb91939ULL, 0x0032d7aef8412458ULL, 1289},
+    {0x8d2fca1042a09ea3ULL, 0x0032c3850e79c0f1ULL, 1291},
+    {0x82779c856d8b8bf1ULL, 0x00328766d59048a2ULL, 1297},
+    {0x3879361cba8a223dULL, 0x00325fa18cb11833ULL, 1301},
+    {0xf23f43639c3182a7ULL, 0x00324bd659327e22ULL, 1303},
+    {0xa03868fc474bcd13ULL, 0x0032246e784360f4ULL, 1307},
+    {0x651e78b8c5311a97ULL, 0x0031afa5f1a33a08ULL, 1319},
+    {0x8ffce639c00c6719ULL, 0x00319c63ff398e70ULL, 1321},
+    {0xf7b460754b0b61cfULL, 0x003162f7519a86a7ULL, 1327},
+    {0x7b03f3359b8e63b1ULL, 0x0030271fc9d3fc3cULL, 1361},
+    {0xa55c5326041eb667ULL, 0x002ff104ae89750bULL, 1367},
+    {0x647f88ab896a76f5ULL, 0x002fbb62a236d133ULL, 1373},
+    {0x8fd971434a55a46dULL, 0x002f74997d2070b4ULL, 1381},
+    {0x9fbf969958046447ULL, 0x002ed84aa8b6fce3ULL, 1399},
+    {0x9986feba69be3a81ULL, 0x002e832df7a46dbdULL, 1409},
+    {0xa668b3e6d053796fULL, 0x002e0e0846857cabULL, 1423},
+    {0x97694e6589f4e09bULL, 0x002decfbdfb55ee6ULL, 1427},
+    {0x37890c00b7721dbdULL, 0x002ddc876f3ff488ULL, 1429},
+    {0x5ac094a235f37ea9ULL, 0x002dbbc1d4c482c4ULL, 1433},
+    {0x31cff775f2d5d65fULL, 0x002d8af0e0de0556ULL, 1439},
+    {0xddad8e6b36505217ULL, 0x002d4a7b7d14b30aULL, 1447},
+    {0x5a27df897062cd03ULL, 0x002d2a85073bcf4eULL, 1451},
+    {0xe2396fe0fdb5a625ULL, 0x002d1a9ab13e8be4ULL, 1453},
+    {0xb352a4957e82317bULL, 0x002ceb1eb4b9fd8bULL, 1459},
+    {0xd8ab3f2c60c2ea3fULL, 0x002c8d503a79794cULL, 1471},
+    {0x6893f702f0452479ULL, 0x002c404d708784edULL, 1481},
+    {0x9686fdc182acf7e3ULL, 0x002c31066315ec52ULL, 1483},
+    {0x6854037173dce12fULL, 0x002c1297d80f2664ULL, 1487},
+    {0x7f0ded1685c27331ULL, 0x002c037044c55f6bULL, 1489},
+    {0xeeda72e1fe490b7dULL, 0x002be5404cd13086ULL, 1493},
+    {0x9e7bfc959a8e6e53ULL, 0x002bb845adaf0cceULL, 1499},
+    {0x49b314d6d4753dd7ULL, 0x002b5f62c639f16dULL, 1511},
+    {0x2e8f8c5ac4aa1b3bULL, 0x002b07e6734f2b88ULL, 1523},
+    {0xb8ef723481163d33ULL, 0x002ace569d8342b7ULL, 1531},
+    {0x6a2ec96a594287b7ULL, 0x002a791d5dbd4dcfULL, 1543},
+    {0xdba41c6d13aab8c5ULL, 0x002a4eff8113017cULL, 1549},
+    {0xc2adbe648dc3aaf1ULL, 0x002a3319e156df32ULL, 1553},
+    {0x87a2bade565f91a7ULL, 0x002a0986286526eaULL, 1559},
+    {0x4d6fe8798c01f5dfULL, 0x0029d29551d91e39ULL, 1567},
+    {0x3791310c8c23d98bULL, 0x0029b7529e109f0aULL, 1571},
+    {0xf80e446b01228883ULL, 0x00298137491ea465ULL, 1579},
+    {0x9aed1436fbf500cfULL, 0x0029665e1eb9f9daULL, 1583},
+    {0x7839b54cc8b24115ULL, 0x002909752e019a5eULL, 1597},
+    {0xc128c646ad0309c1ULL, 0x0028ef35e2e5efb0ULL, 1601},
+    {0x14de631624a3c377ULL, 0x0028c815aa4b8278ULL, 1607},
+    {0x3f7b9fe68b0ecbf9ULL, 0x0028bb1b867199daULL, 1609},
+    {0x284ffd75ec00a285ULL, 0x0028a13ff5d7b002ULL, 1613},
+    {0x37803cb80dea2ddbULL, 0x00287ab3f173e755ULL, 1619},
+    {0x86b63f7c9ac4c6fdULL, 0x00286dead67713bdULL, 1621},
+    {0x8b6851d1bd99b9d3ULL, 0x002847bfcda6503eULL, 1627},
+    {0xb62fda77ca343b6dULL, 0x002808c1ea6b4777ULL, 1637},
+    {0x1f0dc009e34383c9ULL, 0x00278d0e0f23ff61ULL, 1657},
+    {0x496dc21ddd35b97fULL, 0x002768863c093c7fULL, 1663},
+    {0xb0e96ce17090f82bULL, 0x0027505115a73ca8ULL, 1667},
+    {0xaadf05acdd7d024dULL, 0x00274441a61dc1b9ULL, 1669},
+    {0xcb138196746eafb5ULL, 0x0026b5c166113cf0ULL, 1693},
+    {0x347f523736755d61ULL, 0x00269e65ad07b18eULL, 1697},
+    {0xd14a48a051f7dd0bULL, 0x002692c25f877560ULL, 1699},
+    {0x474d71b1ce914d25ULL, 0x002658fa7523cd11ULL, 1709},
+    {0x386063f5e28c1f89ULL, 0x0026148710cf0f9eULL, 1721},
+    {0x1db7325e32d04e73ULL, 0x002609363b22524fULL, 1723},
+    {0xfef748d3893b880dULL, 0x0025d1065a1c1122ULL, 1733},
+    {0x2f3351506e935605ULL, 0x0025a48a382b863fULL, 1741},
+    {0x7a3637fa2376415bULL, 0x0025837190eccdbcULL, 1747},
+    {0x4ac525d2baa21969ULL, 0x00256292e95d510cULL, 1753},
+    {0x3a11c16b42cd351fULL, 0x002541eda98d068cULL, 1759},
+    {0x6c7abde0049c2a11ULL, 0x0024e15087fed8f5ULL, 1777},
+    {0x54dad0303e069ac7ULL, 0x0024c18b20979e5dULL, 1783},
+    {0xebf1ac9fdfe91433ULL, 0x0024ac7b336de0c5ULL, 1787},
+    {0xfafdda8237cec655ULL, 0x0024a1fc478c60bbULL, 1789},
+    {0xdce3ff6e71ffb739ULL, 0x002463801231c009ULL, 1801},
+    {0xbed5737d6286db1bULL, 0x0024300fd506ed33ULL, 1811},
+    {0xe479e431fe08b4dfULL, 0x0023f314a494da81ULL, 1823},
+    {0x9dd9b0dd7742f897ULL, 0x0023cadedd2fad3aULL, 1831},
+    {0x8f09d7402c5a5e87ULL, 0x00237b7ed2664a03ULL, 1847},
+    {0x9216d5c4d958738dULL, 0x0023372967dbaf1dULL, 1861},
+    {0xb3139ba11d34ca63ULL, 0x00231a308a371f20ULL, 1867},
+    {0x47d54f7ed644afafULL, 0x002306fa63e1e600ULL, 1871},
+    {0x92a81d85cf11a1b1ULL, 0x0022fd6731575684ULL, 1873},
+    {0x754b26533253bdfdULL, 0x0022ea507805749cULL, 1877},
+    {0xbbe0efc980bfd467ULL, 0x0022e0cce8b3d720ULL, 1879},
+    {0xc0d8d594f024dca1ULL, 0x0022b1887857d161ULL, 1889},
+    {0x8238d43bcaac1a65ULL, 0x00227977fcc49cc0ULL, 1901},
+    {0x27779c1fae6175bbULL, 0x00225db37b5e5f4fULL, 1907},
+    {0xa746ca9af708b2c9ULL, 0x0022421b91322ed6ULL, 1913},
+    {0x93f3cd9f389be823ULL, 0x0021f05b35f52102ULL, 1931},
+    {0x5cb4a4c04c489345ULL, 0x0021e75de5c70d60ULL, 1933},
+    {0xbf6047743e85b6b5ULL, 0x0021a01d6c19be96ULL, 1949},
+    {0x61c147831563545fULL, 0x0021974a6615c81aULL, 1951},
+    {0xedb47c0ae62dee9dULL, 0x00213767697cf36aULL, 1973},
+    {0x0a3824386673a573ULL, 0x00211d9f7fad35f1ULL, 1979},
+    {0xa4a77d19e575a0ebULL, 0x0020fb7d9dd36c18ULL, 1987},
+    {0xa2bee045e066c279ULL, 0x0020e2123d661e0eULL, 1993},
+    {0xc23618de8ab43d05ULL, 0x0020d135b66ae990ULL, 1997},
+    {0x266b515216cb9f2fULL, 0x0020c8cded4d7a8eULL, 1999},
+    {0xe279edd9e9c2e85bULL, 0x0020b80b3f43ddbfULL, 2003},
+    {0xd0c591c221dc9c53ULL, 0x002096b9180f46a6ULL, 2011},
+    {0x06da8ee9c9ee7c21ULL, 0x00207de7e28de5daULL, 2017},
+    {0x9dfebcaf4c27e8c3ULL, 0x002054dec8cf1fb3ULL, 2027},
+    {0x49aeff9f19dd6de5ULL, 0x00204cb630b3aab5ULL, 2029},
+    {0x86976a57a296e9c7ULL, 0x00202428adc37bebULL, 2039},
+    {0xa3b9abf4872b84cdULL, 0x001fec0c7834def4ULL, 2053},
+    {0x34fca6483895e6efULL, 0x001fc46fae98a1d0ULL, 2063},
+    {0x34b5a333988f873dULL, 0x001facda430ff619ULL, 2069},
+    {0xd9dd4f19b5f17be1ULL, 0x001f7e17dd8e15e5ULL, 2081},
+    {0xb935b507fd0ce78bULL, 0x001f765a3556a4eeULL, 2083},
+    {0xb450f5540660e797ULL, 0x001f66ea49d802f1ULL, 2087},
+    {0x63ff82831ffc1419ULL, 0x001f5f3800faf9c0ULL, 2089},
+    {0x8992f718c22a32fbULL, 0x001f38f4e6c0f1f9ULL, 2099},
+    {0x5f3253ad0d37e7bfULL, 0x001f0b8546752578ULL, 2111},
+    {0x007c0ffe0fc007c1ULL, 0x001f03ff83f001f0ULL, 2113},
+    {0x4d8ebadc0c0640b1ULL, 0x001ec853b0a3883cULL, 2129},
+    {0xe2729af831037bdbULL, 0x001ec0ee573723ebULL, 2131},
+    {0xb8f64bf30feebfe9ULL, 0x001eaad38e6f6894ULL, 2137},
+    {0xda93124b544c0bf5ULL, 0x001e9c28a765fe53ULL, 2141},
+    {0x9cf7ff0b593c539fULL, 0x001e94d8758c2003ULL, 2143},
+    {0xd6bd8861fa0e07d9ULL, 0x001e707ba8f65e68ULL, 2153},
+    {0x5cfe75c0bd8ab891ULL, 0x001e53a2a68f574eULL, 2161},
+    {0x43e808757c2e862bULL, 0x001e1380a56b438dULL, 2179},
+    {0x90caa96d595c9d93ULL, 0x001dbf9f513a3802ULL, 2203},
+    {0x8fd550625d07135fULL, 0x001db1d1d58bc600ULL, 2207},
+    {0x76b010a86e209f2dULL, 0x001d9d358f53de38ULL, 2213},
+    {0xecc0426447769b25ULL, 0x001d81e6df6165c7ULL, 2221},
+    {0xe381339caabe3295ULL, 0x001d4bdf7fd40e30ULL, 2237},
+    {0xd1b190a2d0c7673fULL, 0x001d452c7a1c958dULL, 2239},
+    {0xc3bce3cf26b0e7ebULL, 0x001d37cf9b902659ULL, 2243},
+    {0x5f87e76f56c61ce3ULL, 0x001d1d3a5791e97bULL, 2251},
+    {0xc06c6857a124b353ULL, 0x001ce89fe6b47416ULL, 2267},
+    {0x38c040fcba630f75ULL, 0x001ce219f3235071ULL, 2269},
+    {0xd078bc4fbd533b21ULL, 0x001cd516dcf92139ULL, 2273},
+    {0xde8e15c5dd354f59ULL, 0x001cbb33bd1c2b8bULL, 2281},
+    {0xca61d53d7414260fULL, 0x001ca7e7d2546688ULL, 2287},
+    {0xb56bf5ba8eae635dULL, 0x001c94b5c1b3dbd3ULL, 2293},
+    {0x44a72cb0fb6e3949ULL, 0x001c87f7f9c241c1ULL, 2297},
+    {0x879839a714f45bcdULL, 0x001c6202706c35a9ULL, 2309},
+    {0x02a8994fde5314b7ULL, 0x001c5bb8a9437632ULL, 2311},
+    {0xb971920cf2b90135ULL, 0x001c174343b4111eULL, 2333},
+    {0x8a8fd0b7df9a6e8bULL, 0x001c04d0d3e46b42ULL, 2339},
+    {0xb31f9a84c1c6eaadULL, 0x001bfeb00fbf4308ULL, 2341},
+    {0x92293b02823c6d83ULL, 0x001bec5dce0b202dULL, 2347},
+    {0xeee77ff20fe5ddcfULL, 0x001be03444620037ULL, 2351},
+    {0x0e1ea0f6c496c11dULL, 0x001bce09c66f6fc3ULL, 2357},
+    {0xfdf2d3d6f88ccb6bULL, 0x001ba40228d02b30ULL, 2371},
+    {0xfa9d74a3457738f9ULL, 0x001b9225b1cf8919ULL, 2377},
+    {0xefc3ca3db71a5785ULL, 0x001b864a2ff3f53fULL, 2381},
+    {0x8e2071718d0d6dafULL, 0x001b80604150e49bULL, 2383},
+    {0xbc0fdbfeb6cfabfdULL, 0x001b6eb1aaeaacf3ULL, 2389},
+    {0x1eeab613e5e5aee9ULL, 0x001b62f48da3c8ccULL, 2393},
+    {0x2d2388e90e9e929fULL, 0x001b516babe96092ULL, 2399},
+    {0x81dbafba588ddb43ULL, 0x001b2e9cef1e0c87ULL, 2411},
+    {0x52eebc51c4799791ULL, 0x001b1d56bedc849bULL, 2417},
+    {0x1c6bc4693b45a047ULL, 0x001b0c267546aec0ULL, 2423},
+    {0x06eee0974498874dULL, 0x001ae45f62024fa0ULL, 2437},
+    {0xd85b7377a9953cb9ULL, 0x001ad917631b5f54ULL, 2441},
+    {0x4b6df412d4caf56fULL, 0x001ac83d18cb608fULL, 2447},
+    {0x6b8afbbb4a053493ULL, 0x001aa6c7ad8c063fULL, 2459},
+    {0xcc5299c96ac7720bULL, 0x001a90a7b1228e2aULL, 2467},
+    {0xadce84b5c710aa99ULL, 0x001a8027c03ba059ULL, 2473},
+    {0x9d673f5aa3804225ULL, 0x001a7533289deb89ULL, 2477},
+    {0xe6541268efbce7f7ULL, 0x001a2ed7ce16b49fULL, 2503},
+    {0xfcf41e76cf5be669ULL, 0x0019fefc0a279a73ULL, 2521},
+    {0x5c3eb5dc31c383cbULL, 0x0019e4b0cd873b5fULL, 2531},
+    {0x301832d11d8ad6c3ULL, 0x0019cfcdfd60e514ULL, 2539},
+    {0x2e9c0942f1ce450fULL, 0x0019c56932d66c85ULL, 2543},
+    {0x97f3f2be37a39a5dULL, 0x0019b5e1ab6fc7c2ULL, 2549},
+    {0xe8b7d8a9654187c7ULL, 0x0019b0b8a62f2a73ULL, 2551},
+    {0xb5d024d7da5b1b55ULL, 0x0019a149fc98942cULL, 2557},
+    {0xb8ba9d6e7ae3501bULL, 0x001969517ec25b85ULL, 2579},
+    {0xf50865f71b90f1dfULL, 0x00194b3083360ba8ULL, 2591},
+    {0x739c1682847df9e1ULL, 0x00194631f4bebdc1ULL, 2593},
+    {0xc470a4d842b90ed1ULL, 0x00191e84127268fdULL, 2609},
+    {0x1fb1be11698cc409ULL, 0x00190adbb543984fULL, 2617},
+    {0xd8d5512a7cd35d15ULL, 0x001901130bd18200ULL, 2621},
+    {0xa5496821723e07f9ULL, 0x0018e3e6b889ac94ULL, 2633},
+    {0xbcc8c6d7abaa8167ULL, 0x0018c233420e1ec1ULL, 2647},
+    {0x52c396c95eb619a1ULL, 0x0018aa5872d92bd6ULL, 2657},
+    {0x6eb7e380878ec74bULL, 0x0018a5989945ccf9ULL, 2659},
+    {0x3d5513b504537157ULL, 0x00189c1e60b57f60ULL, 2663},
+    {0x314391f8862e948fULL, 0x0018893fbc8690b9ULL, 2671},
+    {0xdc0b17cfcd81f5ddULL, 0x00187b2bb3e1041cULL, 2677},
+    {0x2f6bea3ec89044b3ULL, 0x00186d27c9cdcfb8ULL, 2683},
+    {0xce13a05869f1b57fULL, 0x001863d8bf4f2c1cULL, 2687},
+    {0x7593474e8ace3581ULL, 0x00185f33e2ad7593ULL, 2689},
+    {0x07fc329295a05e4dULL, 0x001855ef75973e13ULL, 2693},
+    {0xb05377cba4908d23ULL, 0x001848160153f134ULL, 2699},
+    {0xe7b2131a628aa39bULL, 0x001835b72e6f0656ULL, 2707},
+    {0x9031dbed7de01527ULL, 0x00182c922d83eb39ULL, 2711},
+    {0x76844b1c670aa9a9ULL, 0x0018280243c0365aULL, 2713},
+    {0x6a03f4533b08915fULL, 0x00181a5cd5898e73ULL, 2719},
+    {0x1dbca579db0a3999ULL, 0x001803c0961773aaULL, 2729},
+    {0x002ffe800bffa003ULL, 0x0017ff4005ffd001ULL, 2731},
+    {0x478ab1a3e936139dULL, 0x0017e8d670433edbULL, 2741},
+    {0x66e722bc4c5cc095ULL, 0x0017d7066cf4bb5dULL, 2749},
+    {0x7a8f63c717278541ULL, 0x0017ce285b806b1fULL, 2753},
+    {0xdf6eee24d292bc2fULL, 0x0017af52cdf27e02ULL, 2767},
+    {0x9fc20d17237dd569ULL, 0x0017997d47d01039ULL, 2777},
+    {0xcdf9932356bda2edULL, 0x00177f7ec2c6d0baULL, 2789},
+    {0x97b5e332e80f68d7ULL, 0x00177b2f3cd00756ULL, 2791},
+    {0x46eee26fd875e2e5ULL, 0x00176e4a22f692a0ULL, 2797},
+    {0x3548a8e65157a611ULL, 0x001765b94271e11bULL, 2801},
+    {0xc288d03be9b71e3bULL, 0x001761732b044ae4ULL, 2803},
+    {0x8151186db38937abULL, 0x00173f7a5300a2bcULL, 2819},
+    {0x7800b910895a45f1ULL, 0x001722112b48be1fULL, 2833},
+    {0xaee0b024182eec3dULL, 0x001719b7a16eb843ULL, 2837},
+    {0x96323eda173b5713ULL, 0x00170d3c99cc5052ULL, 2843},
+    {0x0ed0dbd03ae77c8bULL, 0x0016fcad7aed3bb6ULL, 2851},
+    {0xf73800b7828dc119ULL, 0x0016f051b8231ffdULL, 2857},
+    {0x1b61715ec22b7ca5ULL, 0x0016e81beae20643ULL, 2861},
+    {0xa8533a991ead64bfULL, 0x0016c3721584c1d8ULL, 2879},
+    {0x7f6c7290e46c2e77ULL, 0x0016b34c2ba09663ULL, 2887},
+    {0x6325e8d907b01db1ULL, 0x00169f3ce292ddcdULL, 2897},
+    {0x28909f70152a1067ULL, 0x00169344b2220a0dULL, 2903},
+    {0xea7077af0997a0f5ULL, 0x001687592593c1b1ULL, 2909},
+    {0x7e605cad10c32e6dULL, 0x00167787f1418ec9ULL, 2917},
+    {0x471b33570635b38fULL, 0x001663e190395ff2ULL, 2927},
+    {0xab559fa997a61bb3ULL, 0x00164c7a4b6eb5b3ULL, 2939},
+    {0xad4bdae562bddab9ULL, 0x0016316a061182fdULL, 2953},
+    {0x055e1b2f2ed62f45ULL, 0x001629ba914584e4ULL, 2957},
+    {0x03cd328b1a2dca9bULL, 0x00161e3d57de21b2ULL, 2963},
+    {0xd28f4e08733218a9ULL, 0x001612cc01b977f0ULL, 2969},
+    {0xb6800b077f186293ULL, 0x00160efe30c525ffULL, 2971},
+    {0x6fbd138c3fd9c207ULL, 0x0015da45249ec5deULL, 2999},
+    {0xb117ccd12ae88a89ULL, 0x0015d68ab4acff92ULL, 3001},
+    {0x2f1a1a044046bcebULL, 0x0015c3f989d1eb15ULL, 3011},
+    {0x548aba0b060541e3ULL, 0x0015b535ad11b8f0ULL, 3019},
+    {0xcf4e808cea111b2fULL, 0x0015addb3f424ec1ULL, 3023},
+    {0xdbec1b4fa855a475ULL, 0x00159445cb91be6bULL, 3037},
+    {0xe3f794eb600d7821ULL, 0x00158d0199771e63ULL, 3041},
+    {0x34fae0d9a11f7c59ULL, 0x00157e87d9b69e04ULL, 3049},
+    {0xf006b0ccbbac085dULL, 0x001568f58bc01ac3ULL, 3061},
+    {0x3f45076dc3114733ULL, 0x00155e3c993fda9bULL, 3067},
+    {0xeef49bfa58a1a1b7ULL, 0x001548eacc5e1e6eULL, 3079},
+    {0x12c4218bea691fa3ULL, 0x001541d8f91ba6a7ULL, 3083},
+    {0xbc7504e3bd5e64f1ULL, 0x00153747060cc340ULL, 3089},
+    {0x4ee21c292bb92fadULL, 0x001514569f93f7c4ULL, 3109},
+    {0x34338b7327a4bacfULL, 0x00150309705d3d79ULL, 3119},
+    {0x3fe5c0833d6fccd1ULL, 0x0014ff97020cf5bfULL, 3121},
+    {0xb1e70743535203c1ULL, 0x0014e42c114cf47eULL, 3137},
+    {0xefbb5dcdfb4e43d3ULL, 0x0014b835bdcb6447ULL, 3163},
+    {0xca68467ca5394f9fULL, 0x0014b182b53a9ab7ULL, 3167},
+    {0x8c51c081408b97a1ULL, 0x0014ae2ad094a3d3ULL, 3169},
+    {0x3275a899dfa5dd65ULL, 0x00149a320ea59f96ULL, 3181},
+    {0x9e674cb62e1b78bbULL, 0x001490441de1a2fbULL, 3187},
+    {0xa37ff5bb2a998d47ULL, 0x001489aacce57200ULL, 3191},
+    {0x792a999db131a22bULL, 0x001475f82ad6ff99ULL, 3203},
+    {0x1b48841bc30d29b9ULL, 0x00146c2cfe53204fULL, 3209},
+    {0xf06721d2011d3471ULL, 0x00145f2ca490d4a1ULL, 3217},
+    {0x93fd2386dff85ebdULL, 0x001458b2aae0ec87ULL, 3221},
+    {0x4ce72f54c07ed9b5ULL, 0x00144bcb0a3a3150ULL, 3229},
+    {0xd6d0fd3e71dd827bULL, 0x001428a1e65441d4ULL, 3251},
+    {0x856405fb1eed819dULL, 0x00142575a6c210d7ULL, 3253},
+    {0x8ea8aceb7c443989ULL, 0x00141f2025ba5c46ULL, 3257},
+    {0x34a13026f62e5873ULL, 0x00141bf6e35420fdULL, 3259},
+    {0x1eea0208ec0af4f7ULL, 0x001409141d1d313aULL, 3271},
+    {0x63679853cea598cbULL, 0x0013dd8bc19c3513ULL, 3299},
+    {0xc30b3ebd61f2d0edULL, 0x0013da76f714dc8fULL, 3301},
+    {0x7eb9037bc7f43bc3ULL, 0x0013d13e50f8f49eULL, 3307},
+    {0xa583e6f6ce016411ULL, 0x0013c80e37ca3819ULL, 3313},
+    {0xf1938d895f1a74c7ULL, 0x0013bee69fa99ccfULL, 3319},
+    {0x80cf1491c1e81e33ULL, 0x0013b8d0ede55835ULL, 3323},
+    {0x3c0f12886ba8f301ULL, 0x0013afb7680bb054ULL, 3329},
+    {0x0e4b786e0dfcc5abULL, 0x0013acb0c3841c96ULL, 3331},
+    {0x672684c93f2d41efULL, 0x00139a9c5f434fdeULL, 3343},
+    {0xe00757badb35c51bULL, 0x0013949cf33a0d9dULL, 3347},
+    {0xd6d84afe66472edfULL, 0x001382b4a00c31b0ULL, 3359},
+    {0xfbbc0eedcbbfb6e1ULL, 0x00137fbbc0eedcbbULL, 3361},
+    {0x250f43aa08a84983ULL, 0x001370ecf047b069ULL, 3371},
+    {0x04400e927b1acaa5ULL, 0x00136df9790e3155ULL, 3373},
+    {0x56572be34b9d3215ULL, 0x0013567dd8defd5bULL, 3389},
+    {0x87964ef7781c62bfULL, 0x0013539261fdbc34ULL, 3391},
+    {0x29ed84051c06e9afULL, 0x00133c564292d28aULL, 3407},
+    {0xb00acd11ed3f87fdULL, 0x001333ae178d6388ULL, 3413},
+    {0x06307881744152d9ULL, 0x0013170ad00d1fd7ULL, 3433},
+    {0x7a786459f5c1ccc9ULL, 0x0013005f01db0947ULL, 3449},
+    {0x1308125d74563281ULL, 0x0012f51d40342210ULL, 3457},
+    {0x395310a480b3e34dULL, 0x0012ef815e4ed950ULL, 3461},
+    {0x35985baa8b202837ULL, 0x0012ecb4abccd827ULL, 3463},
+    {0x96304a6e052b3223ULL, 0x0012e71dc1d3d820ULL, 3467},
+    {0xbd8265fc9af8fd45ULL, 0x0012e45389a16495ULL, 3469},
+    {0x1b6d0b383ec58e0bULL, 0x0012c5d9226476ccULL, 3491},
+    {0xc21a7c3b68b28503ULL, 0x0012badc391156fdULL, 3499},
+    {0x236fa180fbfd6007ULL, 0x0012aa78e412f522ULL, 3511},
+    {0xc42accd440ed9595ULL, 0x0012a251f5f47fd1ULL, 3517},
+    {0x7acf7128236ba3f7ULL, 0x001294cb85c53534ULL, 3527},
+    {0xf909367a987b9c79ULL, 0x0012921963beb65eULL, 3529},
+    {0xb64efb252bfba705ULL, 0x00128cb777c69ca8ULL, 3533},
+    {0x980d4f5a7e4cd25bULL, 0x001284aa6cf07294ULL, 3539},
+    {0xe1ecc4ef27b0c37dULL, 0x001281fcf6ac7f87ULL, 3541},
+    {0x9111aebb81d72653ULL, 0x001279f937367db9ULL, 3547},
+    {0x8951f985cb2c67edULL, 0x00126cad0488be94ULL, 3557},
+    {0xc439d4fc54e0b5d7ULL, 0x00126a06794646a2ULL, 3559},
+    {0xe857bf31896d533bULL, 0x00125a2f2bcd3e95ULL, 3571},
+    {0xb614bb4cb5023755ULL, 0x00124d108389e6b1ULL, 3581},
+    {0x938a89e5473bf1ffULL, 0x00124a73083771acULL, 3583},
+    {0xeac481aca34de039ULL, 0x00123d6acda0620aULL, 3593},
+    {0x14b961badf4809a7ULL, 0x00122b4b2917eafdULL, 3607},
+    {0x76784fecba352435ULL, 0x00122391bfce1e2fULL, 3613},
+    {0xefa689bb58aef5e1ULL, 0x00121e6f1ea579f2ULL, 3617},
+    {0xb2b2c4db9c3a8197ULL, 0x001216c09e471568ULL, 3623},
+    {0x2503bc992279f8cfULL, 0x00120c8cb9d93909ULL, 3631},
+    {0xd2ab9aec5ca1541dULL, 0x001204ed58e64ef9ULL, 3637},
+    {0x3e78ba1460f99af3ULL, 0x0011fd546578f00cULL, 3643},
+    {0x0a01426572cfcb63ULL, 0x0011e9310b8b4c9cULL, 3659},
+    {0xbea857968f3cbd67ULL, 0x0011da3405db9911ULL, 3671},
+    {0x78db213eefe659e9ULL, 0x0011d7b6f4eb055dULL, 3673},
+    {0x963e8541a74d35f5ULL, 0x0011d2bee748c145ULL, 3677},
+    {0x9e22d152776f2e43ULL, 0x0011c1706ddce7a7ULL, 3691},
+    {0x05d10d39d1e1f291ULL, 0x0011ba0fed2a4f14ULL, 3697},
+    {0x374468dccaced1ddULL, 0x0011b528538ed64aULL, 3701},
+    {0x8d145c7d110c5ad5ULL, 0x0011ab61404242acULL, 3709},
+    {0x3251a39f5acb5737ULL, 0x00119f378ce81d2fULL, 3719},
+    {0xa66e50171443506fULL, 0x001195889ece79daULL, 3727},
+    {0x124f69ad91dd4cbdULL, 0x00118e4c65387077ULL, 3733},
+    {0xec24f8f2a61a2793ULL, 0x001187161d70e725ULL, 3739},
+    {0xb472148e656b7a51ULL, 0x00116cd6d1c85239ULL, 3761},
+    {0x0adf9570e1142f07ULL, 0x001165bbe7ce86b1ULL, 3767},
+    {0x89bf33b065119789ULL, 0x0011635ee344ce36ULL, 3769},
+    {0x8f0149803cb291ebULL, 0x0011579767b6d679ULL, 3779},
+    {0x8334b63afd190a31ULL, 0x00114734711e2b54ULL, 3793},
+    {0x920908d50d6aba7dULL, 0x0011428b90147f05ULL, 3797},
+    {0x57d8b018c5a33d53ULL, 0x00113b92f3021636ULL, 3803},
+    {0xea1773092dc27ee5ULL, 0x001126cabc886884ULL, 3821},
+    {0xcae5f38b7bf2e00fULL, 0x0011247eb1b85976ULL, 3823},
+    {0x2bd02df34f695349ULL, 0x0011190bb01efd65ULL, 3833},
+    {0xddfecd5be62e2eb7ULL, 0x0011091de0fd679cULL, 3847},
+    {0xdbf849ebec96c4a3ULL, 0x001104963c7e4e0bULL, 3851},
+    {0xda31d4d0187357c5ULL, 0x00110253516420b0ULL, 3853},
+    {0xe34e21cc2d5418a7ULL, 0x0010f70db7c41797ULL, 3863},
+    {0x68ca5137a9e574adULL, 0x0010e75ee2bf9ecdULL, 3877},
+    {0x3eaa0d0f804bfd19ULL, 0x0010e2e91c6e0676ULL, 3881},
+    {0x554fb753cc20e9d1ULL, 0x0010da049b9d428dULL, 3889},
+    {0x797afcca1300756bULL, 0x0010c6248fe3b1a2ULL, 3907},
+    {0x8b8d950b52eeea77ULL, 0x0010c1c03ed690ebULL, 3911},
+    {0xfb6cd166acabc185ULL, 0x0010bb2e1379e3a2ULL, 3917},
+    {0x4eb6c5ed9437a7afULL, 0x0010b8fe7f61228eULL, 3919},
+    {0xd1eddbd91b790cdbULL, 0x0010b4a10d60a4f7ULL, 3923},
+    {0x93d714ea4d8948e9ULL, 0x0010ae192681ec0fULL, 3929},
+    {0x3ca13ed8145188d3ULL, 0x0010abecfbe5b0aeULL, 3931},
+    {0x829086016da89c57ULL, 0x00109eefd568b96dULL, 3943},
+    {0xd7da1f432124a543ULL, 0x00109a9ff178b40cULL, 3947},
+    {0x7ead5581632fb07fULL, 0x00108531e22f9ff9ULL, 3967},
+    {0x35443837f63ec3bdULL, 0x00106ddec1af4417ULL, 3989},
+    {0x89e2b200e5519461ULL, 0x0010614174a4911dULL, 4001},
+    {0xe9ae44f0b7289c0bULL, 0x00105f291f0448e7ULL, 4003},
+    {0x94387a277b9fa817ULL, 0x00105afa0ef32891ULL, 4007},
+    {0xc84f1a58abfc2c25ULL, 0x001054b777bd2530ULL, 4013},
+    {0x71101d8e3c83377bULL, 0x00104e79a97fb69eULL, 4019},
+    {0xc024abe5c50ba69dULL, 0x00104c661eafd845ULL, 4021},
+    {0x15de4eb365a65d73ULL, 0x0010462ea939c933ULL, 4027},
+    {0x09ed28a76bcca931ULL, 0x00102f8baa442836ULL, 4049},
+    {0x816bffbf4a00205bULL, 0x00102d7ff7e94004ULL, 4051},
+    {0x1f5c71543d558069ULL, 0x0010275ff9f13c02ULL, 4057},
+    {0xf25c64d0ec53b859ULL, 0x001017213fcbb4d3ULL, 4073},
+    {0x96c02c2ef1e0ff0fULL, 0x00101112234579d1ULL, 4079},
+    {0x19a804816870a333ULL, 0x00100501907d271cULL, 4091},
+    {0x6de49add0971c555ULL, 0x00100300901b0510ULL, 4093},
+};
+
+// small_primes[previous end, end) multiply to product < 2^64
+#define SMALL_PRIME_GROUPS 100
+
+typedef struct {
+    uint64_t product;
+    int end;
+} SmallPrimeGroup;
+
+static const SmallPrimeGroup small_prime_groups[SMALL_PRIME_GROUPS] = {
+    {0xe221f97c30e94e1dULL, 15},
+    {0x6329899ea9f2714bULL, 25},
+    {0x58edcb4c9ed39c8bULL, 34},
+    {0x09966ff94fd516fbULL, 42},
+    {0x3bd7632c1f36eb51ULL, 50},
+    {0x00fd14b3c90d88a9ULL, 57},
+    {0x02ad3dbe0cca85ffULL, 64},
+    {0x0787f9a02c3388a7ULL, 71},
+    {0x1113c5cc6d101657ULL, 78},
+    {0x2456c94f936bdb15ULL, 85},
+    {0x4236a30b85ffe139ULL, 92},
+    {0x805437b38eada69dULL, 99},
+    {0x00723e97bddcd2afULL, 105},
+    {0x00a5a792ee239667ULL, 111},
+    {0x00e451352ebca269ULL, 117},
+    {0x013a7955f14b7805ULL, 123},
+    {0x01d37cbd653b06ffULL, 129},
+    {0x0288fe4eca4d7cdfULL, 135},
+    {0x039fddb60d3af63dULL, 141},
+    {0x04cd73f19080fb03ULL, 147},
+    {0x0639c390b9313f05ULL, 153},
+    {0x08a1c420d25d388fULL, 159},
+    {0x0b4b5322977db499ULL, 165},
+    {0x0e94c170a802ee29ULL, 171},
+    {0x11f6a0e8356100dfULL, 177},
+    {0x166c8898f7b3d683ULL, 183},
+    {0x1babda0a0afd724bULL, 189},
+    {0x2471b07c44024abfULL, 195},
+    {0x2d866dbc2558ad71ULL, 201},
+    {0x3891410d45fb47dfULL, 207},
+    {0x425d5866b049e263ULL, 213},
+    {0x51f767298e2cf13bULL, 219},
+    {0x6d9f9ece5fc74f13ULL, 225},
+    {0x7f5ffdb0f56ee64dULL, 231},
+    {0x943740d46a1bc71fULL, 237},
+    {0xaf2d7ca25cec848fULL, 243},
+    {0xcec010484e4ad877ULL, 249},
+    {0xef972c3cfafbcd25ULL, 255},
+    {0x002a442c1ebb3be5ULL, 260},
+    {0x00303fa164bdc919ULL, 265},
+    {0x0036521ca14fd8e7ULL, 270},
+    {0x003ca3241ed069e3ULL, 275},
+    {0x0043885d3035c59bULL, 280},
+    {0x004e1aee1fa9d559ULL, 285},
+    {0x0054469dbe5d6c77ULL, 290},
+    {0x005e49791f7429a1ULL, 295},
+    {0x006b2ceda4198e53ULL, 300},
+    {0x007339d26e3d1ce3ULL, 305},
+    {0x007e2ee3b8aa6bf3ULL, 310},
+    {0x008ae9bb5cda9301ULL, 315},
+    {0x0096e917373cdca7ULL, 320},
+    {0x00a211e4fecdf953ULL, 325},
+    {0x00b8ff2efb3033cfULL, 330},
+    {0x00cbaca970bdfe31ULL, 335},
+    {0x00db2c9f75b49027ULL, 340},
+    {0x00ed9fb524fe759dULL, 345},
+    {0x01007595a2312fc7ULL, 350},
+    {0x0111eccd0898675fULL, 355},
+    {0x012546177b06c0bfULL, 360},
+    {0x013e5b450710a16fULL, 365},
+    {0x0164d74c38c8e863ULL, 370},
+    {0x01836887063c20bbULL, 375},
+    {0x01ab250719364c7bULL, 380},
+    {0x01d1d99745c88d5bULL, 385},
+    {0x01ec730b953d1a27ULL, 390},
+    {0x02021f7b6341a9abULL, 395},
+    {0x021e792f0d4ca61dULL, 400},
+    {0x0249015c16a93885ULL, 405},
+    {0x026f0f9a480c48e5ULL, 410},
+    {0x029bc3143b9a5a89ULL, 415},
+    {0x02d26abb44109333ULL, 420},
+    {0x030a7492f008069dULL, 425},
+    {0x0343b19b9edc33a7ULL, 430},
+    {0x0385a3fb2c68b433ULL, 435},
+    {0x03c555b3dbe9ef83ULL, 440},
+    {0x0411e43a3a8d394bULL, 445},
+    {0x04775710b7a55833ULL, 450},
+    {0x04b76972a22d55a1ULL, 455},
+    {0x0507bfe226ee0079ULL, 460},
+    {0x056a838dee32fff3ULL, 465},
+    {0x05ac8589165200e9ULL, 470},
+    {0x05f667749eb2f963ULL, 475},
+    {0x065dd3fc17e3c099ULL, 480},
+    {0x06e031d955a9fef9ULL, 485},
+    {0x0742ec64b53bfdffULL, 490},
+    {0x07a5cbcb6bae243dULL, 495},
+    {0x07f7fcb28a3d7137ULL, 500},
+    {0x086be427bf5de82dULL, 505},
+    {0x08d9ca434d0399a5ULL, 510},
+    {0x09638c123bcab351ULL, 515},
+    {0x09db5cdd2505eabdULL, 520},
+    {0x0a7882ea2d1e207fULL, 525},
+    {0x0b1a70a51fba0b75ULL, 530},
+    {0x0bbabeb6f4cc2177ULL, 535},
+    {0x0c68a56113938121ULL, 540},
+    {0x0ce86607deddbe4bULL, 545},
+    {0x0daca6d46347064fULL, 550},
+    {0x0e6f9cb2334ec11fULL, 555},
+    {0x0f25ac800485a171ULL, 560},
+    {0x0000000fe7096f01ULL, 563},
+};
+
+#endif // INT256_PRIME_TABLE_H
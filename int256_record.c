@@ -0,0 +1,71 @@
+// libcalc256: fixed-width binary records for pipeline stages.
+
+#include "calc256_internal.h"
+
+// ==================== BINARY RECORDS ====================
+//
+// Whole blocks convert with one 8-byte load or store (and at most one byte
+// swap) per limb, so handing values to the next stage costs a copy instead
+// of a decimal round trip.
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define RECORD_HOST_BE 1
+#else
+#define RECORD_HOST_BE 0
+#endif
+
+static inline void record_store(unsigned char* p, uint64_t x, int swap) {
+    if (swap) x = __builtin_bswap64(x);
+    memcpy(p, &x, 8);
+}
+
+static inline uint64_t record_load(const unsigned char* p, int swap) {
+    uint64_t x;
+    memcpy(&x, p, 8);
+    return swap ? __builtin_bswap64(x) : x;
+}
+
+// Little-endian records hold part[3] first, big-endian ones part[0]
+void int256_to_records(const Int256* values, size_t count, Int256RecordOrder order,
+                       unsigned char* out) {
+    int be = order == INT256_RECORD_BE;
+    int swap = be != RECORD_HOST_BE;
+    for (size_t i = 0; i < count; i++, out += INT256_RECORD_SIZE) {
+        for (int k = 0; k < 4; k++) record_store(out + 8 * k, values[i].part[be ? k : 3 - k], swap);
+        out[32] = (unsigned char)(values[i].sign && !is_zero_int256(values[i]));
+    }
+}
+
+size_t records_to_int256(const unsigned char* in, size_t count, Int256RecordOrder order,
+                         Int256* values) {
+    int be = order == INT256_RECORD_BE;
+    int swap = be != RECORD_HOST_BE;
+    size_t bad = 0;
+    for (size_t i = 0; i < count; i++, in += INT256_RECORD_SIZE) {
+        Int256* v = &values[i];
+        for (int k = 0; k < 4; k++) v->part[be ? k : 3 - k] = record_load(in + 8 * k, swap);
+        unsigned int sign = in[32];
+        if (sign > 1) {
+            *v = (Int256){{0, 0, 0, 0}, 0};
+            bad++;
+            continue;
+        }
+        v->sign = sign && !is_zero_int256(*v);
+    }
+    return bad;
+}
+
+Int256Status record_status_int256(const unsigned char* record) {
+    unsigned int sign = record[32];
+    if (sign <= 1) return INT256_OK;
+    unsigned int status = sign & ~(unsigned int)INT256_RECORD_ERROR;
+    if ((sign & INT256_RECORD_ERROR) && status >= INT256_ERR_EMPTY && status <= INT256_ERR_DOMAIN) {
+        return (Int256Status)status;
+    }
+    return INT256_ERR_INVALID;
+}
+
+void record_error_int256(Int256Status status, unsigned char* record) {
+    memset(record, 0, INT256_RECORD_SIZE - 1);
+    record[32] = (unsigned char)(INT256_RECORD_ERROR | status);
+}
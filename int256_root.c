@@ -0,0 +1,111 @@
+// libcalc256: integer roots by Newton's iteration.
+
+#include "calc256_internal.h"
+
+// ==================== INTEGER ROOTS ====================
+//
+// Newton's iteration x' = ((n-1) x + a / x^(n-1)) / n in integers falls
+// monotonically from any start at or above the root and stops on it, so
+// each root is seeded from above: the root of the top 64 bits (found the
+// same way in machine words), plus one, shifted back into place.
+
+// floor(t^(1/n)) for n >= 2
+static uint64_t iroot_u64(uint64_t t, unsigned int n) {
+    if (t < 2) return t;
+    int bits = 64 - __builtin_clzll(t);
+    if ((unsigned int)bits <= n) return 1;   // 2^n > t
+    
+    uint64_t x = 1ULL << ((bits + n - 1) / n);
+    for (;;) {
+        uint64_t p = 1;
+        int big = 0;
+        for (unsigned int i = 1; i < n && !big; i++) big = __builtin_mul_overflow(p, x, &p);
+        uint64_t q = big ? 0 : t / p;
+        uint64_t y = ((uint64_t)(n - 1) * x + q) / n;
+        if (y >= x) return x;
+        x = y;
+    }
+}
+
+// floor(a^(1/n)) for n >= 2 over little-endian limbs
+static void iroot_limbs(uint64_t r[4], const uint64_t a[4], unsigned int n) {
+    int bits = limbs_bits(a, 4);
+    memset(r, 0, 4 * sizeof(uint64_t));
+    if (bits <= 64) {
+        r[0] = iroot_u64(a[0], n);
+        return;
+    }
+    if ((unsigned int)bits <= n) {
+        r[0] = 1;
+        return;
+    }
+    
+    // a = top * 2^shift + rest with shift a multiple of n and top < 2^64
+    int shift = (bits - 64 + (int)n - 1) / (int)n * (int)n;
+    int word = shift / 64, off = shift % 64;
+    uint64_t top = a[word] >> off;
+    if (off && word < 3) top |= a[word + 1] << (64 - off);
+    
+    uint64_t seed = iroot_u64(top, n) + 1;
+    int k = shift / (int)n;
+    uint64_t x[4] = {0, 0, 0, 0};
+    x[k / 64] = seed << (k % 64);
+    if (k % 64 && k / 64 < 3) x[k / 64 + 1] = seed >> (64 - k % 64);
+    
+    for (;;) {
+        uint64_t p[4], q[4] = {0, 0, 0, 0}, y[4];
+        int overflow = 0;
+        if (n == 2) {
+            memcpy(p, x, sizeof(p));
+        } else {
+            overflow = pow_limbs(p, x, n - 1);
+        }
+        
+        // q = a / x^(n-1), zero when the power exceeds a
+        int alen = limbs_len(a, 4), plen = limbs_len(p, 4);
+        if (!overflow && plen <= alen) divmod_limbs(q, NULL, a, alen, p, plen);
+        
+        // y = ((n-1) x + q) / n; the sum is below n * 2^256
+        uint64_t carry = 0, rem;
+        for (int i = 0; i < 4; i++) {
+            __uint128_t t = (__uint128_t)x[i] * (n - 1) + q[i] + carry;
+            y[i] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        rem = carry;
+        for (int i = 3; i >= 0; i--) y[i] = udiv128_64(rem, y[i], n, &rem);
+        
+        if (cmp_limbs_4(y, x) >= 0) break;
+        memcpy(x, y, sizeof(x));
+    }
+    memcpy(r, x, 4 * sizeof(uint64_t));
+}
+
+// Odd roots keep the sign (truncating toward zero); even roots of negative
+// numbers and the 0th root are INT256_ERR_DOMAIN with *out zero
+Int256Status iroot_int256(Int256 a, unsigned int n, Int256* out) {
+    if (n == 0 || (n % 2 == 0 && a.sign && !is_zero_int256(a))) {
+        *out = (Int256){{0, 0, 0, 0}, 0};
+        return INT256_ERR_DOMAIN;
+    }
+    if (n == 1) {
+        *out = a;
+        return INT256_OK;
+    }
+    
+    uint64_t x[4], r[4];
+    int256_to_limbs(&a, x);
+    iroot_limbs(r, x, n);
+    *out = limbs_to_int256(r, a.sign);
+    return INT256_OK;
+}
+
+Int256Status isqrt_int256(Int256 a, Int256* out) {
+    return iroot_int256(a, 2, out);
+}
+
+Int256 icbrt_int256(Int256 a) {
+    Int256 r;
+    iroot_int256(a, 3, &r);
+    return r;
+}
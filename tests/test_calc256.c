@@ -0,0 +1,1245 @@
+// Unit tests for libcalc256: make test
+//
+// Fixed vectors pin the edge cases of each algorithm; random operands
+// (biased toward limbs of 0, 1, 2^63 and 2^64 - 1, which is where carries
+// and quotient estimates go wrong) are checked against identities that do
+// not depend on the code under test.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "calc256.h"
+#include "int256_pow10_table.h"
+
+// ==================== HARNESS ====================
+
+#define RANDOM_CASES 200000
+
+static int checks, failures;
+
+static void report(int ok, const char* what, const char* file, int line) {
+    checks++;
+    if (!ok) {
+        failures++;
+        if (failures <= 20) fprintf(stderr, "%s:%d: FAILED: %s\n", file, line, what);
+    }
+}
+
+#define CHECK(cond) report((cond) != 0, #cond, __FILE__, __LINE__)
+
+static void report_value(Int256 got, const char* expect, const char* what, const char* file, int line) {
+    Int256 want = str_to_int256(expect);
+    checks++;
+    if (cmp_int256(got, want) != 0 || got.sign != want.sign) {
+        char text[80];
+        int256_to_hex(got, text, sizeof(text));
+        failures++;
+        if (failures <= 20) fprintf(stderr, "%s:%d: %s = %s, expected %s\n", file, line, what, text, expect);
+    }
+}
+
+// value equals the number written in expect (decimal or 0x hex)
+#define CHECK_VALUE(value, expect) report_value((value), (expect), #value, __FILE__, __LINE__)
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static uint64_t random_limb(void) {
+    static const uint64_t edges[] = {
+        0, 1, 2, 0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL,
+        0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL};
+    uint64_t r = next_random();
+    return r % 3 ? edges[(r >> 8) % 7] : next_random();
+}
+
+// Up to 4 significant limbs and either sign
+static Int256 random_int256(void) {
+    Int256 r;
+    int zeros = (int)(next_random() % 4);
+    for (int i = 0; i < 4; i++) r.part[i] = i < zeros ? 0 : random_limb();
+    r.sign = is_zero_int256(r) ? 0 : (int)(next_random() & 1);
+    return r;
+}
+
+static Int256 random_nonzero(void) {
+    Int256 r;
+    do r = random_int256(); while (is_zero_int256(r));
+    return r;
+}
+
+// ==================== DIVISION ====================
+
+// q and r are the truncated quotient and remainder of a / b:
+// a = q b + r with |r| < |b| and r zero or of a's sign
+static int is_divmod(Int256 a, Int256 b, Int256 q, Int256 r) {
+    Int256 p, sum;
+    if (mul_int256_checked(q, b, &p) != INT256_OK) return 0;
+    if (add_int256_checked(p, r, &sum) != INT256_OK) return 0;
+    return cmp_int256(sum, a) == 0 && cmp_abs_int256(r, b) < 0
+        && (is_zero_int256(r) || r.sign == a.sign);
+}
+
+static void test_division(void) {
+    Int256 q, r;
+
+    // qhat from the top limbs is one too large and the second-limb test
+    // corrects it
+    q = divmod_int256(str_to_int256("0x8000000000000000fffffffffffffffe0000000000000000"),
+                      str_to_int256("0x8000000000000000ffffffffffffffff"), &r);
+    CHECK_VALUE(q, "0xffffffffffffffff");
+    CHECK_VALUE(r, "0x7fffffffffffffffffffffffffffffff");
+
+    // qhat survives that test but is still one too large: add back
+    q = divmod_int256(str_to_int256("0x800000000000000000000000000000000000000000000003"),
+                      str_to_int256("0x200000000000000000000000000000000000000000000001"), &r);
+    CHECK_VALUE(q, "3");
+    CHECK_VALUE(r, "0x200000000000000000000000000000000000000000000000");
+    q = divmod_int256(str_to_int256("0x80000000000000000000000000000000fffffffffffffffe0000000000000000"),
+                      str_to_int256("0x80000000000000000000000000000000ffffffffffffffff"), &r);
+    CHECK_VALUE(q, "0xffffffffffffffff");
+    CHECK_VALUE(r, "0x7fffffffffffffffffffffffffffffffffffffffffffffff");
+
+    // One-limb divisors take the 128/64 path
+    Int256 max = str_to_int256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    q = divmod_int256(max, str_to_int256("0xffffffffffffffff"), &r);
+    CHECK_VALUE(q, "0x0000000000000001000000000000000100000000000000010000000000000001");
+    CHECK_VALUE(r, "0");
+    q = divmod_int256(max, str_to_int256("10000000000000000000"), &r);
+    CHECK_VALUE(q, "11579208923731619542357098500868790785326998466564056403945");
+    CHECK_VALUE(r, "7584007913129639935");
+    q = divmod_int256(max, str_to_int256("1"), &r);
+    CHECK(cmp_int256(q, max) == 0 && is_zero_int256(r));
+    q = divmod_int256(str_to_int256("12345"), max, &r);
+    CHECK_VALUE(q, "0");
+    CHECK_VALUE(r, "12345");
+
+    // Truncation toward zero; the remainder takes the dividend's sign
+    q = divmod_int256(str_to_int256("-7"), str_to_int256("2"), &r);
+    CHECK_VALUE(q, "-3");
+    CHECK_VALUE(r, "-1");
+    q = divmod_int256(str_to_int256("7"), str_to_int256("-2"), &r);
+    CHECK_VALUE(q, "-3");
+    CHECK_VALUE(r, "1");
+    q = divmod_int256(str_to_int256("-6"), str_to_int256("-3"), &r);
+    CHECK_VALUE(q, "2");
+    CHECK(is_zero_int256(r) && r.sign == 0);
+
+    Int256 zero = {{0, 0, 0, 0}, 0};
+    CHECK(div_int256_checked(max, zero, &q) == INT256_ERR_DIV_BY_ZERO);
+    CHECK(mod_int256_checked(max, zero, &q) == INT256_ERR_DIV_BY_ZERO);
+
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES; i++) {
+        Int256 a = random_int256(), b = random_nonzero();
+        q = divmod_int256(a, b, &r);
+        if (!is_divmod(a, b, q, r)) bad++;
+        if (cmp_int256(div_int256(a, b), q) != 0 || cmp_int256(mod_int256(a, b), r) != 0) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== INVARIANT DIVISOR ====================
+
+static void test_divider(void) {
+    Int256Divider dv;
+    Int256 zero = {{0, 0, 0, 0}, 0}, r;
+    CHECK(divider_init_int256(&dv, zero) == -1);
+
+    // Each kind: power of two, one limb, and two to four limbs
+    static const char* divisors[] = {
+        "1", "-2", "0x8000000000000000", "0x10000000000000000",
+        "-0x8000000000000000000000000000000000000000000000000000000000000000", "3", "10000000000000000000", "-0xffffffffffffffff",
+        "0x1ffffffffffffffff", "100000000000000000000000000000000000000",
+        "0x8000000000000000ffffffffffffffff0000000000000001",
+        "-0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"};
+    Int256 max = str_to_int256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    for (size_t i = 0; i < sizeof(divisors) / sizeof(divisors[0]); i++) {
+        Int256 d = str_to_int256(divisors[i]), qr, rr;
+        CHECK(divider_init_int256(&dv, d) == 0);
+        Int256 q = divider_divmod_int256(&dv, max, &r);
+        qr = divmod_int256(max, d, &rr);
+        CHECK(cmp_int256(q, qr) == 0 && cmp_int256(r, rr) == 0);
+        CHECK(cmp_int256(divider_div_int256(&dv, neg_int256(max)), neg_int256(qr)) == 0);
+    }
+
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 4; i++) {
+        Int256 d = random_nonzero(), qr, rr;
+        divider_init_int256(&dv, d);
+        for (int k = 0; k < 4; k++) {
+            Int256 a = random_int256();
+            Int256 q = divider_divmod_int256(&dv, a, &r);
+            qr = divmod_int256(a, d, &rr);
+            if (cmp_int256(q, qr) != 0 || cmp_int256(r, rr) != 0) bad++;
+            if (cmp_int256(divider_mod_int256(&dv, a), rr) != 0) bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== MULTIPLY THEN DIVIDE ====================
+
+static const Int256Rounding modes[] = {
+    INT256_ROUND_TRUNC, INT256_ROUND_FLOOR, INT256_ROUND_CEIL,
+    INT256_ROUND_AWAY, INT256_ROUND_HALF_UP, INT256_ROUND_HALF_EVEN};
+
+// a * b / c rounded from divmod_int256 when a * b fits
+static Int256 ref_muldiv(Int256 a, Int256 b, Int256 c, Int256Rounding rounding) {
+    Int256 p = mul_int256(a, b), r;
+    Int256 q = divmod_int256(p, c, &r);
+    if (is_zero_int256(r)) return q;
+    int neg = (p.sign != c.sign), up = 0;
+    int half = cmp_abs_int256(r, sub_int256(abs_int256(c), abs_int256(r)));
+    switch (rounding) {
+        case INT256_ROUND_TRUNC: up = 0; break;
+        case INT256_ROUND_FLOOR: up = neg; break;
+        case INT256_ROUND_CEIL: up = !neg; break;
+        case INT256_ROUND_AWAY: up = 1; break;
+        case INT256_ROUND_HALF_UP: up = half >= 0; break;
+        case INT256_ROUND_HALF_EVEN: up = half > 0 || (half == 0 && (q.part[3] & 1)); break;
+    }
+    Int256 one = {{0, 0, 0, 1}, 0};
+    return up ? (neg ? sub_int256(q, one) : add_int256(q, one)) : q;
+}
+
+static void test_muldiv(void) {
+    Int256 r, zero = {{0, 0, 0, 0}, 0};
+    Int256 max = str_to_int256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    CHECK(muldiv_int256(max, max, max, INT256_ROUND_TRUNC, &r) == INT256_OK && cmp_int256(r, max) == 0);
+    CHECK(muldiv_int256(max, max, str_to_int256("-1"), INT256_ROUND_TRUNC, &r) == INT256_ERR_OVERFLOW);
+    CHECK(muldiv_int256(max, str_to_int256("1"), zero, INT256_ROUND_TRUNC, &r) == INT256_ERR_DIV_BY_ZERO
+          && is_zero_int256(r));
+    CHECK(muldiv_int256(str_to_int256("-5"), str_to_int256("1"), str_to_int256("2"),
+                        INT256_ROUND_HALF_EVEN, &r) == INT256_OK);
+    CHECK_VALUE(r, "-2");
+    CHECK(muldiv_int256(str_to_int256("-7"), str_to_int256("1"), str_to_int256("2"),
+                        INT256_ROUND_HALF_EVEN, &r) == INT256_OK);
+    CHECK_VALUE(r, "-4");
+    CHECK(muldiv_int256(str_to_int256("-1"), str_to_int256("1"), str_to_int256("3"),
+                        INT256_ROUND_FLOOR, &r) == INT256_OK);
+    CHECK_VALUE(r, "-1");
+
+    // Products that fit against divmod_int256; wider ones as
+    // |a| = k |c| + s, whose quotient is k |b| plus the rounded s b / c,
+    // signed as a b / c
+    int bad = 0;
+    Int256Divider dv;
+    for (int i = 0; i < RANDOM_CASES / 10; i++) {
+        Int256 c = random_nonzero(), b = random_int256(), a, expect, got;
+        Int256Status status;
+        if (i & 1) {
+            c = shift_right_int256(c, 128);
+            if (is_zero_int256(c)) continue;
+            b = shift_right_int256(b, 128);
+            // An even k keeps the parity that ties to even look at
+            Int256 k = abs_int256(shift_right_int256(random_int256(), (int)(next_random() % 256)));
+            k.part[3] &= ~1ULL;
+            Int256 s = mod_int256(abs_int256(random_int256()), c);
+            s.sign = 0;
+            int sign = (int)(next_random() & 1);
+            if (mul_int256_checked(k, abs_int256(c), &a) != INT256_OK
+                || add_int256_checked(a, s, &a) != INT256_OK) continue;
+            a.sign = sign && !is_zero_int256(a);
+            s.sign = sign && !is_zero_int256(s);
+            int neg = sign ^ b.sign ^ c.sign;
+            status = mul_int256_checked(k, abs_int256(b), &expect);
+            expect.sign = neg && !is_zero_int256(expect);
+            if (status == INT256_OK) {
+                divider_init_int256(&dv, c);
+                for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+                    Int256 e;
+                    Int256Status se = add_int256_checked(expect, ref_muldiv(s, b, c, modes[m]), &e);
+                    if (muldiv_int256(a, b, c, modes[m], &got) != se
+                        || (se == INT256_OK && cmp_int256(got, e) != 0)) bad++;
+                    if (divider_muldiv_int256(&dv, a, b, modes[m], &got) != se
+                        || (se == INT256_OK && cmp_int256(got, e) != 0)) bad++;
+                }
+            } else if (muldiv_int256(a, b, c, INT256_ROUND_TRUNC, &got) != INT256_ERR_OVERFLOW) {
+                bad++;
+            }
+        } else {
+            a = random_int256();
+            if (mul_int256_checked(a, b, &r) != INT256_OK) continue;
+            divider_init_int256(&dv, c);
+            for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+                expect = ref_muldiv(a, b, c, modes[m]);
+                if (muldiv_int256(a, b, c, modes[m], &got) != INT256_OK || cmp_int256(got, expect) != 0) bad++;
+                if (divider_muldiv_int256(&dv, a, b, modes[m], &got) != INT256_OK
+                    || cmp_int256(got, expect) != 0) bad++;
+            }
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== FIXED POINT ====================
+
+static Int256Status parse_fixed(const Int256Fixed* fx, const char* text, Int256* out) {
+    return parse_fixed_int256(fx, text, strlen(text), out, NULL);
+}
+
+static void test_fixed(void) {
+    Int256Fixed fx;
+    Int256 r;
+    char buf[96];
+    CHECK(fixed_init_int256(&fx, INT256_MAX_SCALE + 1, INT256_ROUND_TRUNC) == -1);
+
+    // Dropped places round once in the context's mode
+    static const struct {
+        Int256Rounding rounding;
+        const char* text;
+        const char* units;
+    } parses[] = {
+        {INT256_ROUND_HALF_EVEN, "0.125", "12"}, {INT256_ROUND_HALF_EVEN, "0.1250001", "13"},
+        {INT256_ROUND_HALF_EVEN, "0.135", "14"}, {INT256_ROUND_HALF_UP, "-0.125", "-13"},
+        {INT256_ROUND_FLOOR, "-0.121", "-13"}, {INT256_ROUND_CEIL, "-0.129", "-12"},
+        {INT256_ROUND_TRUNC, "9.999", "999"}, {INT256_ROUND_AWAY, "  .001", "1"},
+        {INT256_ROUND_TRUNC, "-0.001", "0"}, {INT256_ROUND_TRUNC, "+1.", "100"}};
+    for (size_t i = 0; i < sizeof(parses) / sizeof(parses[0]); i++) {
+        fixed_init_int256(&fx, 2, parses[i].rounding);
+        CHECK(parse_fixed(&fx, parses[i].text, &r) == INT256_OK);
+        CHECK_VALUE(r, parses[i].units);
+    }
+    fixed_init_int256(&fx, 2, INT256_ROUND_TRUNC);
+    CHECK(parse_fixed(&fx, ".", &r) == INT256_ERR_EMPTY);
+    CHECK(parse_fixed(&fx, "1.5x", &r) == INT256_ERR_INVALID);
+    CHECK(parse_fixed(&fx, "0x10", &r) == INT256_ERR_INVALID);
+    CHECK(parse_fixed(&fx, "1157920892373161954235709850086879078532699846656405640394575840079131296399.36",
+                      &r) == INT256_ERR_OVERFLOW);
+
+    CHECK(fixed_to_decimal_int256(&fx, str_to_int256("-5"), buf, sizeof(buf)) == 5 && strcmp(buf, "-0.05") == 0);
+    CHECK(fixed_to_decimal_int256(&fx, str_to_int256("150"), buf, 5) == 4 && strcmp(buf, "1.50") == 0);
+    CHECK(fixed_to_decimal_int256(&fx, str_to_int256("150"), buf, 4) == 0 && buf[0] == '\0');
+
+    // 1.50 * 2.25 = 3.375 and 2 / 3 at two places
+    Int256 a = str_to_int256("150"), b = str_to_int256("225");
+    CHECK(mul_fixed_int256(&fx, a, b, &r) == INT256_OK);
+    CHECK_VALUE(r, "337");
+    fixed_init_int256(&fx, 2, INT256_ROUND_HALF_EVEN);
+    CHECK(mul_fixed_int256(&fx, a, b, &r) == INT256_OK);
+    CHECK_VALUE(r, "338");
+    CHECK(div_fixed_int256(&fx, str_to_int256("200"), str_to_int256("-300"), &r) == INT256_OK);
+    CHECK_VALUE(r, "-67");
+    CHECK(div_fixed_int256(&fx, a, str_to_int256("0"), &r) == INT256_ERR_DIV_BY_ZERO);
+
+    // Formatting then parsing gives the value back at every scale
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 20; i++) {
+        fixed_init_int256(&fx, (unsigned int)(next_random() % (INT256_MAX_SCALE + 1)), INT256_ROUND_HALF_EVEN);
+        Int256 v = random_int256();
+        size_t len = fixed_to_decimal_int256(&fx, v, buf, sizeof(buf));
+        if (len == 0 || len != strlen(buf)) bad++;
+        if (parse_fixed(&fx, buf, &r) != INT256_OK || cmp_int256(r, v) != 0) bad++;
+        // x * 1 and x / 1 are x
+        if (mul_fixed_int256(&fx, v, fx.one, &r) != INT256_OK || cmp_int256(r, v) != 0) bad++;
+        if (div_fixed_int256(&fx, v, fx.one, &r) != INT256_OK || cmp_int256(r, v) != 0) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== MODULAR ARITHMETIC ====================
+
+// x + y mod m for 0 <= x, y < m, on magnitudes
+static Int256 ref_addmod(Int256 x, Int256 y, Int256 m) {
+    Int256 s;
+    unsigned __int128 carry = 0;
+    for (int i = 3; i >= 0; i--) {
+        carry += (unsigned __int128)x.part[i] + y.part[i];
+        s.part[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    s.sign = 0;
+    if (carry || cmp_abs_int256(s, m) >= 0) {
+        uint64_t borrow = 0;
+        for (int i = 3; i >= 0; i--) s.part[i] = sub_with_borrow(s.part[i], m.part[i], &borrow);
+    }
+    return s;
+}
+
+// a * b mod |m| in [0, |m|) by double-and-add, one bit of b at a time
+static Int256 ref_mulmod(Int256 a, Int256 b, Int256 m) {
+    m = abs_int256(m);
+    Int256 x = mod_int256(abs_int256(a), m), acc = {{0, 0, 0, 0}, 0};
+    Int256 y = mod_int256(abs_int256(b), m);
+    for (int bit = 255; bit >= 0; bit--) {
+        acc = ref_addmod(acc, acc, m);
+        if ((y.part[3 - bit / 64] >> (bit % 64)) & 1) acc = ref_addmod(acc, x, m);
+    }
+    // A negative factor negates the product
+    if (a.sign != b.sign && !is_zero_int256(acc)) acc = sub_int256(m, acc);
+    return acc;
+}
+
+static void test_modular(void) {
+    Int256Mont ctx;
+    Int256 zero = {{0, 0, 0, 0}, 0};
+    CHECK(mont_init_int256(&ctx, zero) == -1);
+
+    mont_init_int256(&ctx, str_to_int256("7"));
+    CHECK_VALUE(powmod_int256(&ctx, str_to_int256("2"), str_to_int256("5")), "4");
+    CHECK_VALUE(mulmod_int256(&ctx, str_to_int256("-3"), str_to_int256("1")), "4");
+    CHECK_VALUE(powmod_int256(&ctx, str_to_int256("-3"), str_to_int256("3")), "1");
+    CHECK_VALUE(powmod_int256(&ctx, str_to_int256("5"), zero), "1");
+    mont_init_int256(&ctx, str_to_int256("1"));
+    CHECK_VALUE(powmod_int256(&ctx, str_to_int256("5"), zero), "0");
+
+    // Fermat: a^(p-1) = 1 mod p for primes of one, two and four limbs
+    static const char* primes[] = {
+        "18446744073709551557", "0x7fffffffffffffffffffffffffffffff",
+        "0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed"};
+    for (size_t i = 0; i < sizeof(primes) / sizeof(primes[0]); i++) {
+        Int256 p = str_to_int256(primes[i]);
+        mont_init_int256(&ctx, p);
+        Int256 e = sub_int256(p, str_to_int256("1"));
+        CHECK_VALUE(powmod_int256(&ctx, str_to_int256("3"), e), "1");
+        CHECK_VALUE(powmod_int256(&ctx, str_to_int256("-123456789"), e), "1");
+    }
+
+    // Odd moduli run Montgomery form, even ones plain reduction
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 20; i++) {
+        Int256 m = random_nonzero();
+        if (i & 1) m.part[3] |= 1;
+        else if (!is_zero_int256(shift_right_int256(abs_int256(m), 1))) m.part[3] &= ~1ULL;
+        mont_init_int256(&ctx, m);
+        Int256 a = random_int256(), b = random_int256();
+        Int256 ab = ref_mulmod(a, b, m);
+        if (cmp_int256(mulmod_int256(&ctx, a, b), ab) != 0) bad++;
+        if (cmp_int256(sqrmod_int256(&ctx, a), ref_mulmod(a, a, m)) != 0) bad++;
+
+        Int256 am = mont_to_int256(&ctx, a), bm = mont_to_int256(&ctx, b);
+        if (cmp_int256(mont_from_int256(&ctx, am), ref_mulmod(a, str_to_int256("1"), m)) != 0) bad++;
+        if (cmp_int256(mont_from_int256(&ctx, mont_mul_int256(&ctx, am, bm)), ab) != 0) bad++;
+        if (cmp_int256(mont_from_int256(&ctx, mont_sqr_int256(&ctx, am)),
+                       mulmod_int256(&ctx, a, a)) != 0) bad++;
+
+        // a^(e + f) = a^e a^f and a^(2e) = (a^e)^2
+        Int256 e = abs_int256(random_int256()), f = abs_int256(random_int256());
+        e.part[0] >>= 1;
+        f.part[0] >>= 1;
+        Int256 ae = powmod_int256(&ctx, a, e), af = powmod_int256(&ctx, a, f);
+        if (cmp_int256(powmod_int256(&ctx, a, add_int256(e, f)), mulmod_int256(&ctx, ae, af)) != 0) bad++;
+        if (cmp_int256(powmod_int256(&ctx, a, shift_left_int256(e, 1)), sqrmod_int256(&ctx, ae)) != 0) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== ROOTS AND LOGARITHMS ====================
+
+// r^n <= |a| < (r+1)^n
+static int is_floor_root(Int256 a, unsigned int n, Int256 r) {
+    Int256 lo, hi;
+    a.sign = 0;
+    if (r.sign || pow_int256_checked(r, n, &lo) != INT256_OK || cmp_int256(lo, a) > 0) return 0;
+    return pow_int256_checked(add_int256(r, str_to_int256("1")), n, &hi) != INT256_OK
+        || cmp_int256(hi, a) > 0;
+}
+
+static void test_roots(void) {
+    Int256 r, zero = {{0, 0, 0, 0}, 0};
+    CHECK(iroot_int256(str_to_int256("-16"), 2, &r) == INT256_ERR_DOMAIN);
+    CHECK(isqrt_int256(str_to_int256("-1"), &r) == INT256_ERR_DOMAIN);
+    CHECK(iroot_int256(str_to_int256("16"), 0, &r) == INT256_ERR_DOMAIN);
+    CHECK(iroot_int256(zero, 0, &r) == INT256_ERR_DOMAIN);
+    CHECK(iroot_int256(str_to_int256("-27"), 3, &r) == INT256_OK);
+    CHECK_VALUE(r, "-3");
+    CHECK_VALUE(icbrt_int256(str_to_int256("-28")), "-3");
+    CHECK(isqrt_int256(str_to_int256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"),
+                       &r) == INT256_OK);
+    CHECK_VALUE(r, "0xffffffffffffffffffffffffffffffff");
+    CHECK(iroot_int256(str_to_int256("12345"), 1, &r) == INT256_OK);
+    CHECK_VALUE(r, "12345");
+    CHECK(iroot_int256(str_to_int256("-12345"), 1001, &r) == INT256_OK);
+    CHECK_VALUE(r, "-1");
+
+    // Random a, and exact powers r^n with their neighbours
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 40; i++) {
+        Int256 a = random_int256(), p;
+        unsigned int n = 2 + (unsigned int)(next_random() % 9);
+        Int256Status status = iroot_int256(a, n, &r);
+        if (a.sign && !(n & 1)) {
+            if (status != INT256_ERR_DOMAIN) bad++;
+        } else {
+            if (status != INT256_OK || r.sign != (a.sign && !is_zero_int256(r))) bad++;
+            if (!is_floor_root(a, n, abs_int256(r))) bad++;
+        }
+        Int256 base = shift_right_int256(abs_int256(random_int256()), 256 - 256 / (int)n);
+        if (pow_int256_checked(base, n, &p) != INT256_OK) continue;
+        if (iroot_int256(p, n, &r) != INT256_OK || cmp_int256(r, base) != 0) bad++;
+        if (!is_zero_int256(p) && (iroot_int256(sub_int256(p, str_to_int256("1")), n, &r) != INT256_OK
+                                   || !is_floor_root(sub_int256(p, str_to_int256("1")), n, r))) bad++;
+        if (isqrt_int256(abs_int256(a), &r) != INT256_OK || !is_floor_root(a, 2, r)) bad++;
+        r = icbrt_int256(a);
+        if (!is_floor_root(a, 3, abs_int256(r))) bad++;
+    }
+    CHECK(bad == 0);
+
+    // ilog10 at every 10^k and 10^k - 1; ilog2 at every 2^k and 2^k - 1
+    CHECK(ilog2_int256(zero) == -1 && ilog10_int256(zero) == -1);
+    bad = 0;
+    for (int k = 0; k < POW10_TABLE_SIZE; k++) {
+        Int256 p = pow10_table[k];
+        if (ilog10_int256(p) != k || ilog10_int256(neg_int256(p)) != k) bad++;
+        if (ilog10_int256(sub_int256(p, str_to_int256("1"))) != k - 1) bad++;
+    }
+    for (int k = 0; k < 256; k++) {
+        Int256 p = shift_left_int256(str_to_int256("1"), k);
+        if (ilog2_int256(p) != k || ilog2_int256(neg_int256(p)) != k) bad++;
+        if (ilog2_int256(sub_int256(p, str_to_int256("1"))) != k - 1) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== GCD AND MODULAR INVERSE ====================
+
+// Random pair that often shares a factor of up to 128 bits
+static void random_pair(Int256* a, Int256* b) {
+    *a = random_int256();
+    *b = random_int256();
+    if (next_random() & 1) {
+        Int256 c = shift_right_int256(abs_int256(random_int256()), 128 + (int)(next_random() % 128));
+        mul_int256_checked(*a, c, a);
+        mul_int256_checked(*b, c, b);
+    }
+}
+
+// x mod |m| in [0, |m|)
+static Int256 reduce(Int256 x, Int256 m) {
+    return ref_mulmod(x, str_to_int256("1"), m);
+}
+
+static void test_gcd(void) {
+    Int256 x, y, g, r;
+    g = xgcd_int256(str_to_int256("240"), str_to_int256("46"), &x, &y);
+    CHECK_VALUE(g, "2");
+    CHECK_VALUE(x, "14");
+    CHECK_VALUE(y, "-73");
+    CHECK_VALUE(gcd_int256(str_to_int256("0"), str_to_int256("0")), "0");
+    CHECK_VALUE(gcd_int256(str_to_int256("-12"), str_to_int256("0")), "12");
+    g = xgcd_int256(str_to_int256("-12"), str_to_int256("0"), &x, &y);
+    CHECK_VALUE(g, "12");
+    CHECK_VALUE(x, "-1");
+    CHECK_VALUE(y, "0");
+    g = xgcd_int256(str_to_int256("6"), str_to_int256("-3"), &x, &y);
+    CHECK_VALUE(x, "0");
+    CHECK_VALUE(y, "-1");
+
+    CHECK(modinv_int256(str_to_int256("3"), str_to_int256("0"), &r) == INT256_ERR_DIV_BY_ZERO);
+    CHECK(modinv_int256(str_to_int256("4"), str_to_int256("-10"), &r) == INT256_ERR_DOMAIN);
+    CHECK(modinv_int256(str_to_int256("-3"), str_to_int256("10"), &r) == INT256_OK);
+    CHECK_VALUE(r, "3");
+    CHECK(modinv_int256(str_to_int256("5"), str_to_int256("1"), &r) == INT256_OK);
+    CHECK_VALUE(r, "0");
+    CHECK(lcm_int256(str_to_int256("-4"), str_to_int256("6"), &r) == INT256_OK);
+    CHECK_VALUE(r, "12");
+    CHECK(lcm_int256(str_to_int256("0x100000000000000000000000000000000"),
+                     str_to_int256("0x300000000000000000000000000000001"), &r) == INT256_ERR_OVERFLOW);
+
+    // The products a x and b y may not fit, so the identity is checked
+    // modulo |a| and |b|, with the bounds |x| < |b| / g and |y| <= |a| / g
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 20; i++) {
+        Int256 a, b;
+        random_pair(&a, &b);
+        if (is_zero_int256(a) || is_zero_int256(b)) continue;
+        g = xgcd_int256(a, b, &x, &y);
+        if (cmp_int256(g, gcd_int256(b, a)) != 0) bad++;
+        if (!is_zero_int256(mod_int256(a, g)) || !is_zero_int256(mod_int256(b, g))) bad++;
+        Int256 ra = div_int256(abs_int256(a), g), rb = div_int256(abs_int256(b), g);
+        if (cmp_int256(gcd_int256(ra, rb), str_to_int256("1")) != 0) bad++;
+        if (cmp_abs_int256(x, rb) >= 0 && cmp_int256(rb, str_to_int256("1")) != 0) bad++;
+        if (cmp_abs_int256(y, ra) > 0) bad++;
+        if (cmp_int256(ref_mulmod(b, y, a), reduce(g, a)) != 0) bad++;
+        if (cmp_int256(ref_mulmod(a, x, b), reduce(g, b)) != 0) bad++;
+
+        // Halved operands keep the identity inside 256 bits
+        Int256 ha = shift_right_int256(a, 128), hb = shift_right_int256(b, 128), s;
+        g = xgcd_int256(ha, hb, &x, &y);
+        if (add_int256_checked(mul_int256(ha, x), mul_int256(hb, y), &s) != INT256_OK || cmp_int256(s, g) != 0) bad++;
+
+        Int256Status status = modinv_int256(a, b, &r);
+        if (cmp_int256(g = gcd_int256(a, b), str_to_int256("1")) == 0) {
+            if (status != INT256_OK || r.sign || cmp_abs_int256(r, b) >= 0) bad++;
+            if (cmp_int256(ref_mulmod(a, r, b), reduce(str_to_int256("1"), b)) != 0) bad++;
+        } else if (status != INT256_ERR_DOMAIN) {
+            bad++;
+        }
+
+        // lcm g = |a b| when it fits
+        Int256 l, p;
+        if (mul_int256_checked(abs_int256(a), abs_int256(b), &p) == INT256_OK) {
+            if (lcm_int256(a, b, &l) != INT256_OK || cmp_int256(mul_int256(l, g), p) != 0) bad++;
+        } else if (lcm_int256(a, b, &l) == INT256_OK
+                   && (!is_zero_int256(mod_int256(l, a)) || !is_zero_int256(mod_int256(l, b)))) {
+            bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== PRIMES AND FACTORING ====================
+
+// Product of factor^exponent over a factorization
+static Int256 factors_product(const Int256Factors* f) {
+    Int256 p = {{0, 0, 0, 1}, 0};
+    for (int i = 0; i < f->count; i++) p = mul_int256(p, pow_int256(f->factor[i], f->exponent[i]));
+    return p;
+}
+
+static void test_primes(void) {
+    // Against trial division below 2^16
+    int bad = 0;
+    for (uint64_t n = 0; n < 65536; n++) {
+        int prime = n >= 2;
+        for (uint64_t d = 2; d * d <= n && prime; d++) prime = n % d != 0;
+        Int256 v = {{0, 0, 0, n}, 0};
+        if (isprime_int256(v) != prime) bad++;
+        v.sign = 1;
+        if (isprime_int256(v)) bad++;
+    }
+    CHECK(bad == 0);
+
+    static const char* primes[] = {
+        "18446744073709551557", "0x1fffffffffffffff", "0x1ffffffffffffffffffffff",
+        "0x7fffffffffffffffffffffffffffffff",
+        "0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed"};
+    for (size_t i = 0; i < sizeof(primes) / sizeof(primes[0]); i++) {
+        CHECK(isprime_int256(str_to_int256(primes[i])));
+    }
+
+    // Carmichael numbers, strong pseudoprimes to the first 4, 9, 12 and 13
+    // prime bases (the last is the bound of the exact range) and
+    // (2^89 - 1)(2^127 - 1), which has no small factor
+    static const char* pseudoprimes[] = {
+        "561", "41041", "3215031751", "3825123056546413051", "318665857834031151167461",
+        "3317044064679887385961981", "0xffffffffffffffffffffff7ffffffffe0000000000000000000001"};
+    for (size_t i = 0; i < sizeof(pseudoprimes) / sizeof(pseudoprimes[0]); i++) {
+        CHECK(!isprime_int256(str_to_int256(pseudoprimes[i])));
+    }
+    CHECK(miller_rabin_int256(str_to_int256("3215031751"), 1));
+
+    Int256Factors f;
+    CHECK(factor_int256(str_to_int256("1"), &f) == 0);
+    CHECK(factor_int256(str_to_int256("0"), &f) == 0);
+    CHECK(factor_int256(str_to_int256("-360"), &f) == 3);
+    CHECK(f.composite == 0 && f.exponent[0] == 3 && f.exponent[1] == 2 && f.exponent[2] == 1);
+    CHECK_VALUE(f.factor[2], "5");
+
+    // (2^31 - 1)^2 (2^61 - 1) needs the perfect power test and rho
+    Int256 m31 = str_to_int256("2147483647"), m61 = str_to_int256(primes[1]);
+    CHECK(factor_int256(mul_int256(mul_int256(m31, m31), m61), &f) == 2);
+    CHECK(f.composite == 0 && cmp_int256(f.factor[0], m31) == 0 && f.exponent[0] == 2);
+    CHECK(cmp_int256(f.factor[1], m61) == 0 && f.exponent[1] == 1);
+
+    // Products of up to six factors below 2^32, which rho splits quickly:
+    // the product is |n|, primes ascend and leftover cofactors are composite
+    bad = 0;
+    for (int i = 0; i < 1000; i++) {
+        Int256 n = {{0, 0, 0, 1}, (int)(next_random() & 1)};
+        for (int k = (int)(next_random() % 7); k > 0; k--) {
+            Int256 d = {{0, 0, 0, (next_random() >> 32) + 1}, 0};
+            n = mul_int256(n, d);
+        }
+        if (factor_int256(n, &f) == 0 ? cmp_abs_int256(n, str_to_int256("1")) > 0
+                                      : cmp_int256(factors_product(&f), abs_int256(n)) != 0) bad++;
+        for (int k = 0; k < f.count; k++) {
+            int prime = k < f.count - f.composite;
+            if (isprime_int256(f.factor[k]) != prime) bad++;
+            if (prime && k > 0 && cmp_int256(f.factor[k - 1], f.factor[k]) >= 0) bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== FORMATTING ====================
+
+// Decimal digits of a by repeated division by ten
+static void ref_decimal(Int256 a, char* out) {
+    char digits[80];
+    int n = 0;
+    Int256 ten = {{0, 0, 0, 10}, 0}, r;
+    a = abs_int256(a);
+    do {
+        a = divmod_int256(a, ten, &r);
+        digits[n++] = (char)('0' + r.part[3]);
+    } while (!is_zero_int256(a));
+    while (n > 0) *out++ = digits[--n];
+    *out = '\0';
+}
+
+static void test_formatting(void) {
+    char text[100], want[100];
+
+    CHECK(int256_to_decimal(str_to_int256("0"), text, sizeof(text)) == 1 && strcmp(text, "0") == 0);
+    CHECK(int256_to_decimal(str_to_int256("-0"), text, sizeof(text)) == 1 && strcmp(text, "0") == 0);
+    int256_to_decimal(str_to_int256("-0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"),
+                      text, sizeof(text));
+    CHECK(strcmp(text, "-115792089237316195423570985008687907853269984665640564039457584007913129639935") == 0);
+    // Chunk boundaries at 10^19 and 10^38
+    int256_to_decimal(str_to_int256("10000000000000000000"), text, sizeof(text));
+    CHECK(strcmp(text, "10000000000000000000") == 0);
+    int256_to_decimal(str_to_int256("99999999999999999999999999999999999999"), text, sizeof(text));
+    CHECK(strcmp(text, "99999999999999999999999999999999999999") == 0);
+    int256_to_decimal(str_to_int256("100000000000000000000000000000000000000"), text, sizeof(text));
+    CHECK(strcmp(text, "100000000000000000000000000000000000000") == 0);
+
+    // Too small a buffer gives 0 and an empty string
+    CHECK(int256_to_decimal(str_to_int256("-12345"), text, 6) == 0 && text[0] == '\0');
+    CHECK(int256_to_decimal(str_to_int256("-12345"), text, 7) == 6 && strcmp(text, "-12345") == 0);
+
+    int256_to_hex(str_to_int256("-255"), text, sizeof(text));
+    CHECK(strcmp(text, "-0xff") == 0);
+
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 4; i++) {
+        Int256 a = random_int256();
+        size_t len = int256_to_decimal(a, text, sizeof(text));
+        ref_decimal(a, want + a.sign);
+        if (a.sign) want[0] = '-';
+        if (strcmp(text, want) != 0 || len != strlen(want)) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== PARSING ====================
+
+// parse_int256 over the whole of text
+static Int256Status parse(const char* text, Int256* out, size_t* consumed) {
+    return parse_int256(text, strlen(text), out, consumed);
+}
+
+static void test_parsing(void) {
+    Int256 v;
+    size_t used;
+
+    CHECK(parse("  +42 ", &v, &used) == INT256_OK && used == 5);
+    CHECK_VALUE(v, "42");
+    CHECK(parse("-0x1F", &v, NULL) == INT256_OK);
+    CHECK_VALUE(v, "-31");
+    CHECK(parse("0b101", &v, NULL) == INT256_OK);
+    CHECK_VALUE(v, "5");
+    CHECK(parse("-0", &v, NULL) == INT256_OK && v.sign == 0);
+
+    // Only len bytes are read
+    CHECK(parse_int256("123456", 3, &v, &used) == INT256_OK && used == 3);
+    CHECK_VALUE(v, "123");
+
+    CHECK(parse("", &v, NULL) == INT256_ERR_EMPTY);
+    CHECK(parse("-", &v, NULL) == INT256_ERR_EMPTY);
+    CHECK(parse("0x", &v, NULL) == INT256_ERR_EMPTY);
+    CHECK(parse("12a", &v, &used) == INT256_ERR_INVALID && used == 2);
+    CHECK(parse("0x12g", &v, NULL) == INT256_ERR_INVALID);
+    CHECK(parse("0b102", &v, NULL) == INT256_ERR_INVALID);
+
+    // Control bytes 0x10-0x19 differ from '0'-'9' only in bit 5; none may
+    // pass as a digit anywhere in an 8-digit hex group
+    int bad = 0;
+    for (int pos = 0; pos < 16; pos++) {
+        for (char c = 0x10; c <= 0x19; c++) {
+            char hex[] = "0x123456789abcdef0";
+            hex[2 + pos] = c;
+            if (parse(hex, &v, &used) != INT256_ERR_INVALID || used != (size_t)(2 + pos)) bad++;
+        }
+    }
+    CHECK(bad == 0);
+
+    // 2^256 - 1 fits; one more wraps to zero. Leading zeros never overflow.
+    CHECK(parse("115792089237316195423570985008687907853269984665640564039457584007913129639935",
+                &v, NULL) == INT256_OK);
+    CHECK(parse("115792089237316195423570985008687907853269984665640564039457584007913129639936",
+                &v, NULL) == INT256_ERR_OVERFLOW && is_zero_int256(v));
+    CHECK(parse("0x10000000000000000000000000000000000000000000000000000000000000000",
+                &v, NULL) == INT256_ERR_OVERFLOW);
+    CHECK(parse("0x000000000000000000000000000000000000000000000000000000000000000000001",
+                &v, NULL) == INT256_OK);
+    CHECK_VALUE(v, "1");
+    CHECK(parse("00000000000000000000000000000000000000000000000000000000000000000000000000000000007",
+                &v, NULL) == INT256_OK);
+    CHECK_VALUE(v, "7");
+
+    // Whatever the formatters print parses back to the same value
+    bad = 0;
+    char text[100];
+    for (int i = 0; i < RANDOM_CASES / 4; i++) {
+        Int256 a = random_int256();
+        size_t len = int256_to_decimal(a, text, sizeof(text));
+        if (parse_int256(text, len, &v, &used) != INT256_OK || used != len || cmp_int256(v, a) != 0) bad++;
+        int256_to_hex(a, text, sizeof(text));
+        if (parse(text, &v, NULL) != INT256_OK || cmp_int256(v, a) != 0) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== CHECKED AND SATURATING VARIANTS ====================
+
+static void test_saturating(void) {
+    const char* max = "0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+    const char* min = "-0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
+    Int256 m = str_to_int256(max), one = str_to_int256("1"), r;
+
+    // Saturation takes the sign of the exact result
+    CHECK(add_int256_checked(m, one, &r) == INT256_ERR_OVERFLOW && is_zero_int256(r));
+    CHECK_VALUE(add_int256_saturating(m, one), max);
+    CHECK_VALUE(add_int256_saturating(neg_int256(m), str_to_int256("-1")), min);
+    CHECK_VALUE(add_int256_saturating(m, str_to_int256("-1")),
+                "0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe");
+    CHECK_VALUE(sub_int256_saturating(neg_int256(m), one), min);
+    CHECK_VALUE(sub_int256_saturating(m, neg_int256(one)), max);
+    Int256 p128 = str_to_int256("0x100000000000000000000000000000000");
+    CHECK(mul_int256_checked(p128, p128, &r) == INT256_ERR_OVERFLOW);
+    CHECK_VALUE(mul_int256_saturating(p128, neg_int256(p128)), min);
+    CHECK_VALUE(mul_int256_saturating(neg_int256(p128), neg_int256(p128)), max);
+    CHECK_VALUE(mul_int256_saturating(str_to_int256("0"), m), "0");
+
+    // x / 0 saturates toward the sign of x, 0 / 0 and x % 0 are 0
+    Int256 zero = str_to_int256("0");
+    CHECK(div_int256_checked(str_to_int256("5"), zero, &r) == INT256_ERR_DIV_BY_ZERO);
+    CHECK(mod_int256_checked(str_to_int256("5"), zero, &r) == INT256_ERR_DIV_BY_ZERO);
+    CHECK_VALUE(div_int256_saturating(str_to_int256("5"), zero), max);
+    CHECK_VALUE(div_int256_saturating(str_to_int256("-5"), zero), min);
+    CHECK_VALUE(div_int256_saturating(zero, zero), "0");
+    CHECK_VALUE(mod_int256_saturating(str_to_int256("-5"), zero), "0");
+    CHECK_VALUE(div_int256_saturating(str_to_int256("-7"), str_to_int256("2")), "-3");
+
+    // An odd power of a negative base saturates negative, an even one positive
+    CHECK(pow_int256_checked(str_to_int256("-2"), 257, &r) == INT256_ERR_OVERFLOW);
+    CHECK_VALUE(pow_int256_saturating(str_to_int256("-2"), 257), min);
+    CHECK_VALUE(pow_int256_saturating(str_to_int256("-2"), 256), max);
+    CHECK_VALUE(pow_int256_saturating(str_to_int256("-3"), 3), "-27");
+
+    // 57! is the largest factorial that fits; 58! wraps in *out
+    CHECK(factorial_int256_checked(57, &r) == INT256_OK);
+    CHECK_VALUE(r, "40526919504877216755680601905432322134980384796226602145184481280000000000000");
+    CHECK(factorial_int256_checked(58, &r) == INT256_ERR_OVERFLOW);
+    CHECK_VALUE(r, "34719546536554663358055210341316526763462624868331643631548234081737407201280");
+    CHECK(cmp_int256(factorial_int256_wrapping(58), r) == 0);
+    CHECK_VALUE(factorial_int256_saturating(58), max);
+    CHECK_VALUE(factorial_int256_saturating(0), "1");
+
+    // An overlong string saturates with its sign; one that fits is exact
+    CHECK_VALUE(str_to_int256_saturating("  -1000000000000000000000000000000000000000000000000000000000000000000000000000000"), min);
+    CHECK_VALUE(str_to_int256_saturating("0x10000000000000000000000000000000000000000000000000000000000000000"), max);
+    CHECK_VALUE(str_to_int256_saturating("-123"), "-123");
+    CHECK_VALUE(str_to_int256_wrapping("115792089237316195423570985008687907853269984665640564039457584007913129639937"), "1");
+}
+
+// ==================== FACTORIALS AND BINOMIALS ====================
+
+static void test_binomial(void) {
+    Int256 r;
+    CHECK_VALUE(factorial_int256(0), "1");
+    CHECK_VALUE(factorial_int256(57), "40526919504877216755680601905432322134980384796226602145184481280000000000000");
+    CHECK(binomial_int256(5, 7, &r) == INT256_OK && is_zero_int256(r));
+    CHECK(falling_factorial_int256(5, 7, &r) == INT256_OK && is_zero_int256(r));
+    CHECK(binomial_int256(9, 0, &r) == INT256_OK);
+    CHECK_VALUE(r, "1");
+    CHECK(falling_factorial_int256(9, 0, &r) == INT256_OK);
+    CHECK_VALUE(r, "1");
+    CHECK(binomial_int256(0, 0, &r) == INT256_OK);
+    CHECK_VALUE(r, "1");
+
+    // C(260, 130) is the last central binomial below 2^256
+    CHECK(binomial_int256(260, 130, &r) == INT256_OK);
+    CHECK_VALUE(r, "91587176449671919256354900404147263472546621709856341175078202320054421373604");
+    CHECK(binomial_int256(261, 130, &r) == INT256_ERR_OVERFLOW && is_zero_int256(r));
+    CHECK(falling_factorial_int256(57, 57, &r) == INT256_OK && cmp_int256(r, factorial_int256(57)) == 0);
+    CHECK(falling_factorial_int256(58, 58, &r) == INT256_ERR_OVERFLOW && is_zero_int256(r));
+
+    // Small n against multiply-then-divide: C(n, k) = C(n, k-1) (n-k+1) / k
+    // and n!/(n-k)! one factor at a time
+    int bad = 0;
+    for (unsigned int n = 0; n <= 130; n++) {
+        Int256 c = str_to_int256("1"), f = c;
+        int f_overflow = 0;
+        for (unsigned int k = 0; k <= n; k++) {
+            if (k > 0) {
+                Int256 t = {{0, 0, 0, n - k + 1}, 0}, d = {{0, 0, 0, k}, 0};
+                c = div_int256(mul_int256(c, t), d);
+                if (mul_int256_checked(f, t, &f) != INT256_OK) f_overflow = 1;
+            }
+            if (binomial_int256(n, k, &r) != INT256_OK || cmp_int256(r, c) != 0) bad++;
+            Int256Status status = falling_factorial_int256(n, k, &r);
+            if (f_overflow ? status != INT256_ERR_OVERFLOW || !is_zero_int256(r)
+                           : status != INT256_OK || cmp_int256(r, f) != 0) bad++;
+        }
+    }
+    CHECK(bad == 0);
+
+    // Overflow status over Pascal's triangle up to n = 300; an entry
+    // overflows exactly when its sum does or either term already has
+    static Int256 row[302];
+    static int over[302];
+    bad = 0;
+    memset(over, 0, sizeof(over));
+    row[0] = str_to_int256("1");
+    for (unsigned int n = 1; n <= 300; n++) {
+        row[n] = str_to_int256("0");
+        for (unsigned int k = n; k > 0; k--) {
+            over[k] |= over[k - 1] || add_int256_checked(row[k], row[k - 1], &row[k]) != INT256_OK;
+        }
+        for (unsigned int k = 0; k <= n; k++) {
+            Int256Status status = binomial_int256(n, k, &r);
+            if (over[k] ? status != INT256_ERR_OVERFLOW : status != INT256_OK || cmp_int256(r, row[k]) != 0) bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== TWO'S COMPLEMENT ====================
+
+// a modulo 2^256 as two's complement bits
+static UInt256 wrap_bits(Int256 a) {
+    SInt256 s;
+    int256_to_sint256(a, &s);
+    return sint256_bits(s);
+}
+
+static int uint256_equal(UInt256 a, UInt256 b) {
+    return cmp_uint256(a, b) == 0;
+}
+
+// floor(a / 2^bits)
+static Int256 ref_floor_shift(Int256 a, unsigned int bits) {
+    Int256 q = shift_right_int256(a, (int)bits);
+    if (a.sign && cmp_abs_int256(shift_left_int256(q, (int)bits), a) != 0) {
+        q = sub_int256(q, str_to_int256("1"));
+    }
+    return q;
+}
+
+static void test_twos_complement(void) {
+    SInt256 s;
+    Int256 half = str_to_int256("0x8000000000000000000000000000000000000000000000000000000000000000");
+    CHECK(int256_to_sint256(half, &s) == 1);
+    CHECK(int256_to_sint256(neg_int256(half), &s) == 0 && is_negative_sint256(s));
+    CHECK(s.part[0] == 0x8000000000000000ULL && (s.part[1] | s.part[2] | s.part[3]) == 0);
+    CHECK(cmp_int256(sint256_to_int256(s), neg_int256(half)) == 0);
+    Int256 top = sub_int256(half, str_to_int256("1"));
+    CHECK(int256_to_sint256(top, &s) == 0 && !is_negative_sint256(s));
+    CHECK(cmp_int256(sint256_to_int256(s), top) == 0);
+    CHECK(int256_to_sint256(sub_int256(neg_int256(half), str_to_int256("1")), &s) == 1);
+    CHECK(int256_to_sint256(str_to_int256("-1"), &s) == 0 && s.part[0] == ~0ULL && s.part[3] == ~0ULL);
+
+    // Shifts at the word and range edges: 1 << k, and -1 and -2^255 shifted
+    // arithmetically
+    static const unsigned int shifts[] = {0, 1, 63, 64, 65, 127, 128, 255, 256, 300};
+    UInt256 one = {{0, 0, 0, 1}};
+    SInt256 minus_one = {{~0ULL, ~0ULL, ~0ULL, ~0ULL}};
+    int256_to_sint256(neg_int256(half), &s);
+    for (size_t i = 0; i < sizeof(shifts) / sizeof(shifts[0]); i++) {
+        unsigned int k = shifts[i];
+        Int256 p = shift_left_int256(str_to_int256("1"), (int)k);
+        CHECK(uint256_equal(shl_uint256(one, k), int256_to_uint256(p)));
+        CHECK(uint256_equal(shr_uint256(int256_to_uint256(half), k),
+                            int256_to_uint256(shift_right_int256(half, (int)k))));
+        CHECK(cmp_sint256(sar_sint256(minus_one, k), minus_one) == 0);
+        CHECK(uint256_equal(sint256_bits(sar_sint256(s, k)), wrap_bits(ref_floor_shift(neg_int256(half), k))));
+    }
+
+    // Wrapping arithmetic against the sign-magnitude operations reduced
+    // modulo 2^256; signed order against cmp_int256
+    int bad = 0;
+    for (int i = 0; i < RANDOM_CASES / 4; i++) {
+        Int256 a = abs_int256(random_int256()), b = abs_int256(random_int256());
+        UInt256 x = int256_to_uint256(a), y = int256_to_uint256(b);
+        if (!uint256_equal(add_uint256(x, y), int256_to_uint256(add_int256(a, b)))) bad++;
+        if (!uint256_equal(sub_uint256(x, y), wrap_bits(sub_int256(a, b)))) bad++;
+        if (!uint256_equal(mul_uint256(x, y), int256_to_uint256(mul_lo_int256(a, b)))) bad++;
+        int c = cmp_uint256(x, y), r = cmp_int256(a, b);
+        if ((c > 0) != (r > 0) || (c < 0) != (r < 0)) bad++;
+        if (cmp_int256(uint256_to_int256(x), a) != 0) bad++;
+        unsigned int k = (unsigned int)(next_random() % 260);
+        if (!uint256_equal(shl_uint256(x, k), int256_to_uint256(shift_left_int256(a, (int)k)))) bad++;
+        if (!uint256_equal(shr_uint256(x, k), int256_to_uint256(shift_right_int256(a, (int)k)))) bad++;
+
+        // Signed values: every bit pattern round trips through Int256
+        SInt256 sa = bits_sint256(x), sb = bits_sint256(y);
+        Int256 va = sint256_to_int256(sa), vb = sint256_to_int256(sb);
+        if (int256_to_sint256(va, &s) != 0 || cmp_sint256(s, sa) != 0) bad++;
+        int cs = cmp_sint256(sa, sb), cr = cmp_int256(va, vb);
+        if ((cs > 0) != (cr > 0) || (cs < 0) != (cr < 0)) bad++;
+        if (!uint256_equal(sint256_bits(add_sint256(sa, sb)), wrap_bits(add_int256(va, vb)))) bad++;
+        if (!uint256_equal(sint256_bits(sub_sint256(sa, sb)), wrap_bits(sub_int256(va, vb)))) bad++;
+        if (!uint256_equal(sint256_bits(mul_sint256(sa, sb)), wrap_bits(mul_int256(va, vb)))) bad++;
+        if (!uint256_equal(sint256_bits(neg_sint256(sa)), wrap_bits(neg_int256(va)))) bad++;
+        if (!uint256_equal(sint256_bits(sar_sint256(sa, k)), wrap_bits(ref_floor_shift(va, k)))) bad++;
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== POWERS ====================
+
+static void test_power(void) {
+    Int256 r;
+    CHECK(pow_int256_checked(str_to_int256("10"), 77, &r) == INT256_OK);
+    CHECK_VALUE(r, "100000000000000000000000000000000000000000000000000000000000000000000000000000");
+    CHECK(pow_int256_checked(str_to_int256("10"), 78, &r) == INT256_ERR_OVERFLOW);
+    CHECK(pow_int256_checked(str_to_int256("-2"), 255, &r) == INT256_OK);
+    CHECK_VALUE(r, "-0x8000000000000000000000000000000000000000000000000000000000000000");
+    CHECK(pow_int256_checked(str_to_int256("2"), 256, &r) == INT256_ERR_OVERFLOW && is_zero_int256(r));
+    CHECK(pow_int256_checked(str_to_int256("3"), 161, &r) == INT256_OK);
+    CHECK(pow_int256_checked(str_to_int256("3"), 162, &r) == INT256_ERR_OVERFLOW);
+    CHECK(pow_int256_checked(str_to_int256("0"), 0, &r) == INT256_OK);
+    CHECK_VALUE(r, "1");
+    CHECK_VALUE(pow_int256(str_to_int256("-1"), 4000000001u), "-1");
+
+    // Against repeated multiplication: the true power only grows with the
+    // exponent, so it overflows exactly when some partial product does
+    int bad = 0;
+    for (int i = 0; i < 2000; i++) {
+        Int256 base = random_int256();
+        if (i & 1) base = shift_right_int256(base, 200 + (int)(next_random() % 56));
+        Int256 acc = {{0, 0, 0, 1}, 0};
+        int overflow = 0;
+        for (unsigned int e = 1; e <= 300; e++) {
+            if (mul_int256_checked(acc, base, &acc) != INT256_OK) overflow = 1;
+            Int256Status status = pow_int256_checked(base, e, &r);
+            if (cmp_int256(r, acc) != 0 || status != (overflow ? INT256_ERR_OVERFLOW : INT256_OK)) bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== ARRAY OPERATIONS ====================
+
+// Elements of x and y that differ
+static int mismatches(const Int256* x, const Int256* y, size_t n) {
+    int count = 0;
+    for (size_t i = 0; i < n; i++) count += cmp_int256(x[i], y[i]) != 0;
+    return count;
+}
+
+static void test_arrays(void) {
+    // Lengths around the 4- and 8-lane kernels and the 64-element blocks
+    static const size_t lengths[] = {0, 1, 3, 7, 9, 63, 64, 65, 130, 257};
+    static Int256 a[257], b[257], dst[257], alias[257];
+    static int order[257];
+    int bad = 0;
+    for (size_t t = 0; t < sizeof(lengths) / sizeof(lengths[0]); t++) {
+        size_t n = lengths[t];
+        for (size_t i = 0; i < n; i++) {
+            a[i] = random_int256();
+            // Equal magnitudes and near-maximal values reach the equal,
+            // carry and overflow paths
+            switch (next_random() % 4) {
+                case 0: b[i] = a[i]; b[i].sign = (int)(next_random() & 1); break;
+                case 1: b[i] = random_int256(); b[i].part[0] |= 0x8000000000000000ULL; break;
+                default: b[i] = random_int256(); break;
+            }
+        }
+
+        size_t expect = 0;
+        int overflow;
+        for (size_t i = 0; i < n; i++) {
+            Int256 r = add_int256_core(a[i], b[i], &overflow);
+            expect += (size_t)overflow;
+            alias[i] = r;
+        }
+        if (add_int256_n(dst, a, b, n) != expect) bad++;
+        bad += mismatches(dst, alias, n);
+
+        expect = 0;
+        for (size_t i = 0; i < n; i++) {
+            alias[i] = add_int256_core(a[i], neg_int256(b[i]), &overflow);
+            expect += (size_t)overflow;
+        }
+        if (sub_int256_n(dst, a, b, n) != expect) bad++;
+        bad += mismatches(dst, alias, n);
+
+        expect = 0;
+        for (size_t i = 0; i < n; i++) {
+            Int256 r;
+            expect += mul_int256_checked(a[i], b[i], &r) != INT256_OK;
+            alias[i] = r;
+        }
+        if (mul_int256_n(dst, a, b, n) != expect) bad++;
+        bad += mismatches(dst, alias, n);
+
+        cmp_int256_n(order, a, b, n);
+        for (size_t i = 0; i < n; i++) bad += order[i] != cmp_int256(a[i], b[i]);
+
+        // dst may alias a: each operation again, in place on a copy of a
+        memcpy(alias, a, n * sizeof(Int256));
+        mul_int256_n(alias, alias, b, n);
+        bad += mismatches(alias, dst, n);
+        for (size_t i = 0; i < n; i++) dst[i] = add_int256(a[i], b[i]);
+        memcpy(alias, a, n * sizeof(Int256));
+        add_int256_n(alias, alias, b, n);
+        bad += mismatches(alias, dst, n);
+        for (size_t i = 0; i < n; i++) dst[i] = sub_int256(a[i], b[i]);
+        memcpy(alias, a, n * sizeof(Int256));
+        sub_int256_n(alias, alias, b, n);
+        bad += mismatches(alias, dst, n);
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== BINARY RECORDS ====================
+
+static void test_records(void) {
+    // 33 bytes: the magnitude in the chosen order, then the sign byte
+    Int256 v = str_to_int256("-0x0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20"), back;
+    unsigned char rec[INT256_RECORD_SIZE], expect[INT256_RECORD_SIZE];
+    for (int i = 0; i < 32; i++) expect[i] = (unsigned char)(i + 1);
+    expect[32] = 1;
+    int256_to_records(&v, 1, INT256_RECORD_BE, rec);
+    CHECK(memcmp(rec, expect, sizeof(rec)) == 0);
+    for (int i = 0; i < 32; i++) expect[i] = (unsigned char)(32 - i);
+    int256_to_records(&v, 1, INT256_RECORD_LE, rec);
+    CHECK(memcmp(rec, expect, sizeof(rec)) == 0);
+    CHECK(records_to_int256(rec, 1, INT256_RECORD_LE, &back) == 0 && cmp_int256(back, v) == 0);
+    CHECK(record_status_int256(rec) == INT256_OK);
+
+    // Negative zero is written and read back as zero
+    Int256 negzero = {{0, 0, 0, 0}, 1};
+    int256_to_records(&negzero, 1, INT256_RECORD_BE, rec);
+    CHECK(rec[32] == 0);
+    rec[32] = 1;
+    CHECK(records_to_int256(rec, 1, INT256_RECORD_BE, &back) == 0 && is_zero_int256(back) && back.sign == 0);
+
+    // Any other sign byte holds no value: it decodes as 0 and is counted
+    unsigned char recs[4 * INT256_RECORD_SIZE];
+    Int256 values[4] = {v, str_to_int256("7"), str_to_int256("-7"), str_to_int256("9")};
+    Int256 decoded[4];
+    int256_to_records(values, 4, INT256_RECORD_LE, recs);
+    recs[INT256_RECORD_SIZE + 32] = 2;
+    record_error_int256(INT256_ERR_DIV_BY_ZERO, recs + 2 * INT256_RECORD_SIZE);
+    CHECK(records_to_int256(recs, 4, INT256_RECORD_LE, decoded) == 2);
+    CHECK(cmp_int256(decoded[0], v) == 0 && is_zero_int256(decoded[1]) && is_zero_int256(decoded[2]));
+    CHECK(cmp_int256(decoded[3], values[3]) == 0);
+    CHECK(record_status_int256(recs + INT256_RECORD_SIZE) == INT256_ERR_INVALID);
+    CHECK(record_status_int256(recs + 2 * INT256_RECORD_SIZE) == INT256_ERR_DIV_BY_ZERO);
+    recs[32] = INT256_RECORD_ERROR;
+    CHECK(record_status_int256(recs) == INT256_ERR_INVALID);
+    recs[32] = INT256_RECORD_ERROR | (INT256_ERR_DOMAIN + 1);
+    CHECK(record_status_int256(recs) == INT256_ERR_INVALID);
+
+    // Every error status round trips with a zero magnitude
+    int bad = 0;
+    for (int status = INT256_ERR_EMPTY; status <= INT256_ERR_DOMAIN; status++) {
+        memset(rec, 0xff, sizeof(rec));
+        record_error_int256((Int256Status)status, rec);
+        if (record_status_int256(rec) != (Int256Status)status) bad++;
+        if (records_to_int256(rec, 1, INT256_RECORD_BE, &back) != 1 || !is_zero_int256(back)) bad++;
+    }
+    CHECK(bad == 0);
+
+    // Random blocks round trip in both orders
+    static Int256 block[257], out[257];
+    static unsigned char bytes[257 * INT256_RECORD_SIZE];
+    for (int i = 0; i < 257; i++) block[i] = random_int256();
+    for (int order = INT256_RECORD_LE; order <= INT256_RECORD_BE; order++) {
+        int256_to_records(block, 257, (Int256RecordOrder)order, bytes);
+        if (records_to_int256(bytes, 257, (Int256RecordOrder)order, out) != 0) bad++;
+        for (int i = 0; i < 257; i++) {
+            if (cmp_abs_int256(out[i], block[i]) != 0 || out[i].sign != (block[i].sign && !is_zero_int256(block[i]))) bad++;
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ==================== EXPRESSIONS ====================
+
+// Compiles text and evaluates it with vars; INT256_ERR_INVALID if it does
+// not compile
+static Int256Status eval(const char* text, const Int256* vars, Int256* out) {
+    Int256Expr* e = expr_compile_int256(text, strlen(text), NULL, 0);
+    if (e == NULL) return INT256_ERR_INVALID;
+    Int256Status status = expr_eval_int256(e, vars, out);
+    expr_free_int256(e);
+    return status;
+}
+
+static void test_expressions(void) {
+    Int256 r, vars[2] = {{{0, 0, 0, 6}, 0}, {{0, 0, 0, 4}, 1}};
+    CHECK(eval("x * (y + 1) - -2 ** 3", vars, &r) == INT256_OK);
+    CHECK_VALUE(r, "-10");
+    CHECK(eval("2 ** 3 ** 2 | 1 << 4 & 0x30 ^ 3", vars, &r) == INT256_OK);
+    CHECK_VALUE(r, "531");
+    CHECK(eval("x / (y + 4)", vars, &r) == INT256_ERR_DIV_BY_ZERO);
+    CHECK(eval("(1", vars, &r) == INT256_ERR_INVALID);
+
+    // EXPR_MAX_DEPTH (200) levels of nesting, counted the same for
+    // parentheses, signs and ** exponents
+    char text[1024];
+    static const char* steps[][2] = {{"(", ")"}, {"-", ""}, {"1**", ""}};
+    for (size_t k = 0; k < sizeof(steps) / sizeof(steps[0]); k++) {
+        for (int levels = 199; levels <= 200; levels++) {
+            size_t open = strlen(steps[k][0]), close = strlen(steps[k][1]), len = 0;
+            for (int i = 0; i < levels; i++, len += open) memcpy(text + len, steps[k][0], open);
+            text[len++] = '1';
+            for (int i = 0; i < levels; i++, len += close) memcpy(text + len, steps[k][1], close);
+            text[len] = '\0';
+            CHECK(eval(text, vars, &r) == (levels < 200 ? INT256_OK : INT256_ERR_INVALID));
+        }
+    }
+}
+
+// ==================== RESULT CACHE ====================
+
+static void test_cache(void) {
+    Int256CacheStats stats;
+    Int256Cache* cache = cache_create_int256(100);
+    CHECK(cache != NULL);
+    if (cache == NULL) return;
+
+    // Eviction starts at exactly the requested capacity
+    Int256 seven = str_to_int256("7"), r;
+    int bad = 0;
+    for (uint64_t i = 0; i < 150; i++) {
+        Int256 a = {{0, 0, 0, 1000 + i}, 0};
+        if (cache_div_int256(cache, a, seven, &r) != INT256_OK
+            || cmp_int256(r, div_int256(a, seven)) != 0) bad++;
+    }
+    CHECK(bad == 0);
+    cache_stats_int256(cache, &stats);
+    CHECK(stats.capacity == 100 && stats.entries == 100 && stats.evictions == 50);
+    CHECK(stats.misses == 150 && stats.hits == 0);
+
+    // Hits return the stored status and value
+    Int256 a = {{0, 0, 0, 1149}, 0};
+    CHECK(cache_div_int256(cache, a, seven, &r) == INT256_OK && cmp_int256(r, div_int256(a, seven)) == 0);
+    CHECK(cache_div_int256(cache, a, str_to_int256("0"), &r) == INT256_ERR_DIV_BY_ZERO);
+    CHECK(cache_div_int256(cache, a, str_to_int256("0"), &r) == INT256_ERR_DIV_BY_ZERO);
+    cache_stats_int256(cache, &stats);
+    CHECK(stats.hits == 2);
+    cache_free_int256(cache);
+
+    cache = cache_create_int256(0);
+    CHECK(cache != NULL);
+    if (cache == NULL) return;
+    cache_stats_int256(cache, &stats);
+    CHECK(stats.capacity == 1);
+    cache_free_int256(cache);
+}
+
+int main(void) {
+    test_division();
+    test_divider();
+    test_muldiv();
+    test_fixed();
+    test_modular();
+    test_gcd();
+    test_roots();
+    test_primes();
+    test_formatting();
+    test_parsing();
+    test_saturating();
+    test_binomial();
+    test_twos_complement();
+    test_power();
+    test_arrays();
+    test_records();
+    test_expressions();
+    test_cache();
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures != 0;
+}
@@ -0,0 +1,49 @@
+// Generates int256_factorial_table.h: n! for every n whose factorial fits
+// in 256 bits. Run by the Makefile; the output is committed.
+//
+//   cc -O2 -o gen_factorial_table tools/gen_factorial_table.c
+//   ./gen_factorial_table > int256_factorial_table.h
+
+#include <stdio.h>
+#include <stdint.h>
+
+int main(void) {
+    uint64_t f[4] = {1, 0, 0, 0};   // little-endian limbs
+    uint64_t table[64][4];
+    int count = 0;
+    
+    for (uint64_t n = 0;; n++) {
+        if (n > 1) {
+            uint64_t carry = 0;
+            for (int i = 0; i < 4; i++) {
+                __uint128_t p = (__uint128_t)f[i] * n + carry;
+                f[i] = (uint64_t)p;
+                carry = (uint64_t)(p >> 64);
+            }
+            if (carry != 0) break;
+        }
+        for (int i = 0; i < 4; i++) table[count][i] = f[i];
+        count++;
+    }
+    
+    printf("// Generated by tools/gen_factorial_table.c; do not edit.\n");
+    printf("\n");
+    printf("#ifndef INT256_FACTORIAL_TABLE_H\n");
+    printf("#define INT256_FACTORIAL_TABLE_H\n");
+    printf("\n");
+    printf("#include \"calc256.h\"\n");
+    printf("\n");
+    printf("// n! for 0 <= n < FACTORIAL_TABLE_SIZE; %d! and up exceed 256 bits\n", count);
+    printf("#define FACTORIAL_TABLE_SIZE %d\n", count);
+    printf("\n");
+    printf("static const Int256 factorial_table[FACTORIAL_TABLE_SIZE] = {\n");
+    for (int n = 0; n < count; n++) {
+        printf("    {{0x%016llxULL, 0x%016llxULL, 0x%016llxULL, 0x%016llxULL}, 0},   // %d!\n",
+               (unsigned long long)table[n][3], (unsigned long long)table[n][2],
+               (unsigned long long)table[n][1], (unsigned long long)table[n][0], n);
+    }
+    printf("};\n");
+    printf("\n");
+    printf("#endif // INT256_FACTORIAL_TABLE_H\n");
+    return 0;
+}
@@ -0,0 +1,48 @@
+// Generates int256_pow10_table.h: 10^k for every k whose power fits in 256
+// bits. Run by the Makefile; the output is committed.
+//
+//   cc -O2 -o gen_pow10_table tools/gen_pow10_table.c
+//   ./gen_pow10_table > int256_pow10_table.h
+
+#include <stdio.h>
+#include <stdint.h>
+
+int main(void) {
+    uint64_t p[4] = {1, 0, 0, 0};   // little-endian limbs
+    uint64_t table[80][4];
+    int count = 0;
+    
+    for (;;) {
+        for (int i = 0; i < 4; i++) table[count][i] = p[i];
+        count++;
+        
+        uint64_t carry = 0;
+        for (int i = 0; i < 4; i++) {
+            __uint128_t t = (__uint128_t)p[i] * 10 + carry;
+            p[i] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        if (carry != 0) break;
+    }
+    
+    printf("// Generated by tools/gen_pow10_table.c; do not edit.\n");
+    printf("\n");
+    printf("#ifndef INT256_POW10_TABLE_H\n");
+    printf("#define INT256_POW10_TABLE_H\n");
+    printf("\n");
+    printf("#include \"calc256.h\"\n");
+    printf("\n");
+    printf("// 10^k for 0 <= k < POW10_TABLE_SIZE; 10^%d and up exceed 256 bits\n", count);
+    printf("#define POW10_TABLE_SIZE %d\n", count);
+    printf("\n");
+    printf("static const Int256 pow10_table[POW10_TABLE_SIZE] = {\n");
+    for (int k = 0; k < count; k++) {
+        printf("    {{0x%016llxULL, 0x%016llxULL, 0x%016llxULL, 0x%016llxULL}, 0},   // 10^%d\n",
+               (unsigned long long)table[k][3], (unsigned long long)table[k][2],
+               (unsigned long long)table[k][1], (unsigned long long)table[k][0], k);
+    }
+    printf("};\n");
+    printf("\n");
+    printf("#endif // INT256_POW10_TABLE_H\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Generates int256_prime_table.h: the odd primes below 4096 with the
+// constants for a division-free divisibility test, grouped into products
+// that fit in 64 bits. Run by the Makefile; the output is committed.
+//
+//   cc -O2 -o gen_prime_table tools/gen_prime_table.c
+//   ./gen_prime_table > int256_prime_table.h
+
+#include <stdio.h>
+#include <stdint.h>
+
+#define LIMIT 4096
+
+int main(void) {
+    static char composite[LIMIT];
+    unsigned int primes[LIMIT];
+    int count = 0;
+
+    for (unsigned int i = 3; i < LIMIT; i += 2) {
+        if (composite[i]) continue;
+        primes[count++] = i;
+        for (unsigned int j = i * i; j < LIMIT; j += 2 * i) composite[j] = 1;
+    }
+
+    // Runs of consecutive primes whose product fits in 64 bits
+    uint64_t products[LIMIT];
+    int ends[LIMIT], groups = 0;
+    for (int i = 0; i < count;) {
+        uint64_t product = 1;
+        while (i < count && product <= UINT64_MAX / primes[i]) product *= primes[i++];
+        products[groups] = product;
+        ends[groups++] = i;
+    }
+
+    printf("// Generated by tools/gen_prime_table.c; do not edit.\n");
+    printf("\n");
+    printf("#ifndef INT256_PRIME_TABLE_H\n");
+    printf("#define INT256_PRIME_TABLE_H\n");
+    printf("\n");
+    printf("#include <stdint.h>\n");
+    printf("\n");
+    printf("// Odd primes below SMALL_PRIME_LIMIT. x is divisible by p exactly when\n");
+    printf("// x * inv <= lim modulo 2^64 (inv = p^-1 mod 2^64, lim = (2^64 - 1) / p).\n");
+    printf("#define SMALL_PRIME_LIMIT %d\n", LIMIT);
+    printf("#define SMALL_PRIME_COUNT %d\n", count);
+    printf("\n");
+    printf("typedef struct {\n");
+    printf("    uint64_t inv;\n");
+    printf("    uint64_t lim;\n");
+    printf("    uint64_t p;\n");
+    printf("} SmallPrime;\n");
+    printf("\n");
+    printf("static const SmallPrime small_primes[SMALL_PRIME_COUNT] = {\n");
+    for (int i = 0; i < count; i++) {
+        uint64_t p = primes[i], inv = p;
+        for (int k = 0; k < 5; k++) inv *= 2 - p * inv;
+        printf("    {0x%016llxULL, 0x%016llxULL, %llu},\n", (unsigned long long)inv,
+               (unsigned long long)(UINT64_MAX / p), (unsigned long long)p);
+    }
+    printf("};\n");
+    printf("\n");
+    printf("// small_primes[previous end, end) multiply to product < 2^64\n");
+    printf("#define SMALL_PRIME_GROUPS %d\n", groups);
+    printf("\n");
+    printf("typedef struct {\n");
+    printf("    uint64_t product;\n");
+    printf("    int end;\n");
+    printf("} SmallPrimeGroup;\n");
+    printf("\n");
+    printf("static const SmallPrimeGroup small_prime_groups[SMALL_PRIME_GROUPS] = {\n");
+    for (int g = 0; g < groups; g++) {
+        printf("    {0x%016llxULL, %d},\n", (unsigned long long)products[g], ends[g]);
+    }
+    printf("};\n");
+    printf("\n");
+    printf("#endif // INT256_PRIME_TABLE_H\n");
+    return 0;
+}